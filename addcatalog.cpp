@@ -10,7 +10,6 @@
 #include <QJsonObject>
 #include <QKeyEvent>
 #include <QListView>
-#include <QStandardItemModel>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QDebug>
@@ -18,8 +17,16 @@
 #include <QPainter>
 #include <QFontMetrics>
 #include <QApplication>
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QProgressDialog>
+#include <QTimer>
 
+#include "catalogimport.h"
+#include "catalogmodel.h"
 #include "databaseutils.h"
+#include "imageingest.h"
+#include "thumbnailcache.h"
 #include "utils.h"
 
 
@@ -350,57 +357,61 @@ void AddCatalog::on_save_insert_clicked()
         goldArray.append(rowObject);
     }
 
-    // Save image
-    QString newImagePath = DatabaseUtils::saveImage(imagePath);
-    if (newImagePath.isEmpty()) {
-        QMessageBox::warning(this, "File Error", "Failed to save the image!");
-        return;
-    }
+    // Save image; decoding and storing run off the GUI thread, the insert continues when it is done
+    const QString imageType = selectedImageType;
+    ui->save_insert->setEnabled(false);
+    ImageIngest::ingestAsync(this, imagePath, [=, this](const QString &newImagePath) {
+        ui->save_insert->setEnabled(true);
+        if (newImagePath.isEmpty()) {
+            QMessageBox::warning(this, "File Error", "Failed to save the image!");
+            return;
+        }
 
-    // Insert DB record
-    QString successReturn = DatabaseUtils::insertCatalogData(newImagePath, selectedImageType, designNo,
-                                                             companyName, goldArray, diamondArray, stoneArray, note) ;
-    if (successReturn == "error") {
-        QMessageBox::critical(this, "Insert Error", "Failed to insert data into database!");
-        return;
-    }else if (successReturn == "insert") {
-        QMessageBox::information(this, "Success", "Data inserted successfully!");
-    } else if (successReturn == "modify") {
-        QMessageBox::information(this, "Success", "Data updated successfully!");
-        ui->designNO_lineEdit->setEnabled(true) ;
-        ui->catalog_stacked->setCurrentIndex(2) ;
-        isModifyMode = false;
-    } else {
-        QMessageBox::warning(this, "Error", "Error");
-    }
+        // Insert DB record
+        QString successReturn = DatabaseUtils::insertCatalogData(newImagePath, imageType, designNo,
+                                                                 companyName, goldArray, diamondArray, stoneArray, note) ;
+        if (successReturn == "error") {
+            QMessageBox::critical(this, "Insert Error", "Failed to insert data into database!");
+            return;
+        }else if (successReturn == "insert") {
+            QMessageBox::information(this, "Success", "Data inserted successfully!");
+        } else if (successReturn == "modify") {
+            QMessageBox::information(this, "Success", "Data updated successfully!");
+            ui->designNO_lineEdit->setEnabled(true) ;
+            ui->catalog_stacked->setCurrentIndex(2) ;
+            isModifyMode = false;
+        } else {
+            QMessageBox::warning(this, "Error", "Error");
+        }
 
 
-    // Clear fields safely
-    ui->imagPath_lineEdit->clear();
-    ui->designNO_lineEdit->clear();
-    selectedImageType.clear();
-    ui->jewelryButton->setText("select jewelry type");
-    ui->imageView_label_at_addImage->clear();
+        // Clear fields safely
+        ui->imagPath_lineEdit->clear();
+        ui->designNO_lineEdit->clear();
+        selectedImageType.clear();
+        ui->jewelryButton->setText("select jewelry type");
+        ui->imageView_label_at_addImage->clear();
 
-    // Safely clear diamond + stone tables (delete widgets first)
-    auto clearTable = [](QTableWidget *table) {
-        for (int row = 0; row < table->rowCount(); ++row) {
-            for (int col = 0; col < table->columnCount(); ++col) {
-                QWidget *w = table->cellWidget(row, col);
-                if (w) delete w;
+        // Safely clear diamond + stone tables (delete widgets first)
+        auto clearTable = [](QTableWidget *table) {
+            for (int row = 0; row < table->rowCount(); ++row) {
+                for (int col = 0; col < table->columnCount(); ++col) {
+                    QWidget *w = table->cellWidget(row, col);
+                    if (w) delete w;
+                }
             }
+            table->setRowCount(0);
+        };
+        clearTable(ui->diaTable);
+        clearTable(ui->stoneTable);
+
+        // Reset gold weights
+        for (int row = 0; row < ui->goldTable->rowCount(); ++row) {
+            if (auto *item = ui->goldTable->item(row, 1)) item->setText("");
         }
-        table->setRowCount(0);
-    };
-    clearTable(ui->diaTable);
-    clearTable(ui->stoneTable);
-
-    // Reset gold weights
-    for (int row = 0; row < ui->goldTable->rowCount(); ++row) {
-        if (auto *item = ui->goldTable->item(row, 1)) item->setText("");
-    }
 
-    ui->note->clear();
+        ui->note->clear();
+    });
 }
 
 void AddCatalog::on_brows_clicked()
@@ -463,11 +474,137 @@ void AddCatalog::on_bulk_import_button_released()
     if(excelPath.isEmpty())
         return ;
 
-    if (DatabaseUtils::excelBulkInsertCatalog(excelPath)){
-        QMessageBox::information(this, "Success", "Bulk import completed successfully") ;
+    if (!catalogImporter) {
+        catalogImporter = new CatalogImporter(this);
+
+        connect(catalogImporter, &CatalogImporter::progressChanged, this, [this](int stage, int done, int total) {
+            if (!importProgress) return;
+            importProgress->setLabelText(CatalogImporter::stageText(stage));
+            importProgress->setMaximum(qMax(1, total));
+            importProgress->setValue(done);
+        });
+
+        // Dry run done: nothing written yet, the user decides
+        connect(catalogImporter, &CatalogImporter::planned, this, [this](const CatalogImportPlan &plan) {
+            closeImportProgress();
+
+            if (!plan.error.isEmpty()) {
+                QMessageBox::critical(this, "Error", "Bulk import failed!\n" + plan.error) ;
+                return;
+            }
+            if (plan.inserts + plan.updates == 0) {
+                reviewImportPlan(plan, false);
+                return;
+            }
+            if (reviewImportPlan(plan, true)) {
+                showImportProgress();
+                catalogImporter->startCommit(plan);
+            }
+        });
+
+        connect(catalogImporter, &CatalogImporter::finished, this, [this](const CatalogImportSummary &summary) {
+            closeImportProgress();
+
+            if (summary.cancelled) {
+                QMessageBox::information(this, "Cancelled", "Bulk import cancelled. No designs were changed.") ;
+            } else if (!summary.ok) {
+                QMessageBox::critical(this, "Error", "Bulk import failed! No designs were changed.\n" + summary.error) ;
+            } else {
+                QMessageBox::information(this, "Success",
+                    QString("Bulk import completed successfully\n\n"
+                            "Designs: %1 new, %2 updated\n"
+                            "Images stored: %3, not imported: %4")
+                        .arg(summary.inserted).arg(summary.updated)
+                        .arg(summary.imagesStored).arg(summary.imagesMissing)) ;
+            }
+        });
+    }
+
+    if (catalogImporter->isRunning())
+        return;
+
+    showImportProgress();
+    catalogImporter->startPlan(excelPath);
+}
+
+void AddCatalog::showImportProgress()
+{
+    importProgress = new QProgressDialog(CatalogImporter::stageText(CatalogImporter::Reading), "Cancel", 0, 0, this);
+    importProgress->setWindowTitle("Bulk Import");
+    importProgress->setWindowModality(Qt::WindowModal);
+    importProgress->setMinimumDuration(0);
+    importProgress->setAutoClose(false);
+    importProgress->setAutoReset(false);
+    connect(importProgress, &QProgressDialog::canceled, catalogImporter, &CatalogImporter::cancel);
+
+    ui->bulk_import_button->setEnabled(false);
+}
+
+void AddCatalog::closeImportProgress()
+{
+    if (importProgress) {
+        importProgress->disconnect(catalogImporter);
+        importProgress->deleteLater();
+        importProgress = nullptr;
+    }
+    ui->bulk_import_button->setEnabled(true);
+}
+
+bool AddCatalog::reviewImportPlan(const CatalogImportPlan &plan, bool canImport)
+{
+    QDialog dialog(this);
+    dialog.setWindowTitle("Review Bulk Import");
+    dialog.resize(900, 560);
+
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+    layout->addWidget(new QLabel(QString("%1\n\n%2 new designs, %3 updates, %4 rows skipped.")
+                                     .arg(QFileInfo(plan.filePath).fileName())
+                                     .arg(plan.inserts).arg(plan.updates).arg(plan.skips), &dialog));
+
+    // Problems and updates first, then inserts
+    QList<const CatalogImportPlanRow *> ordered;
+    ordered.reserve(plan.rows.size());
+    for (const CatalogImportPlanRow &row : plan.rows)
+        if (row.action != CatalogImportPlanRow::Insert) ordered.append(&row);
+    for (const CatalogImportPlanRow &row : plan.rows)
+        if (row.action == CatalogImportPlanRow::Insert) ordered.append(&row);
+
+    QTableWidget *table = new QTableWidget(ordered.size(), 4, &dialog);
+    table->setHorizontalHeaderLabels({"Row", "Design No.", "Action", "Details"});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setStretchLastSection(true);
+    table->setUpdatesEnabled(false);
+    for (int i = 0; i < ordered.size(); ++i) {
+        const CatalogImportPlanRow &row = *ordered[i];
+        const QString details = row.action == CatalogImportPlanRow::Update ? "Changes: " + row.changes.join(", ")
+                                                                           : row.problems.join("; ");
+        table->setItem(i, 0, new QTableWidgetItem(QString::number(row.row.sheetRow)));
+        table->setItem(i, 1, new QTableWidgetItem(row.row.designNo));
+        table->setItem(i, 2, new QTableWidgetItem(CatalogImporter::actionText(row.action)));
+        table->setItem(i, 3, new QTableWidgetItem(details));
+        if (row.action == CatalogImportPlanRow::Skip && !row.problems.contains("No changes"))
+            table->item(i, 2)->setForeground(QColor("#B00020"));
+    }
+    table->setUpdatesEnabled(true);
+    table->resizeColumnsToContents();
+    table->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(table);
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(&dialog);
+    if (canImport) {
+        buttons->addButton(QString("Import %1 designs").arg(plan.inserts + plan.updates), QDialogButtonBox::AcceptRole);
+        buttons->addButton(QDialogButtonBox::Cancel);
     } else {
-        QMessageBox::critical(this, "Error", "Bulk import failed!") ;
+        layout->addWidget(new QLabel("Nothing to import.", &dialog));
+        buttons->addButton(QDialogButtonBox::Close);
     }
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    layout->addWidget(buttons);
+
+    return dialog.exec() == QDialog::Accepted;
 }
 
 void AddCatalog::resetAddCatalogUI()
@@ -529,62 +666,6 @@ void AddCatalog::on_add_catalog_button_released()
 }
 
 
-void AddCatalog::loadCatalogForModify()
-{
-    modifyCatalogModel->clear();
-
-    QSqlDatabase db = QSqlDatabase::database("modify_catalog_conn");
-
-    if (!db.isOpen() && !db.open()) {
-        qWarning() << "DB open failed in loadCatalogForModify:" << db.lastError().text();
-        return;
-    }
-
-    QSqlQuery query(db);
-    if (!query.exec("SELECT image_id, image_path, image_type, design_no, company_name FROM image_data")) {
-        qWarning() << "Query failed:" << query.lastError().text();
-        return;
-    }
-
-    while (query.next()) {
-        QString designNo   = query.value("design_no").toString();
-        QString company    = query.value("company_name").toString();
-        QString imagePath  = query.value("image_path").toString();
-
-        QString fullPath = imagePath;
-        if (!QFile::exists(fullPath)) {
-            QString alt = QDir(QCoreApplication::applicationDirPath()).filePath(imagePath);
-            if (QFile::exists(alt))
-                fullPath = alt;
-        }
-
-        QPixmap pix;
-        if (QFile::exists(fullPath))
-            pix.load(fullPath);
-        else
-            pix.load(":/icon/no_image_1.png");
-
-        if (pix.isNull()) {
-            qWarning() << "Failed to load image:" << fullPath;
-            continue;
-        }
-
-        QPixmap scaledPix = pix.scaled(160, 160, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        QIcon icon(scaledPix);
-
-        QStandardItem *item = new QStandardItem(icon, designNo + "\n" + company);
-        item->setEditable(false);
-        item->setData(fullPath, Qt::UserRole + 1);
-        item->setData(designNo, Qt::UserRole + 2);
-        item->setData(company, Qt::UserRole + 3);
-
-        modifyCatalogModel->appendRow(item);
-    }
-
-    if (modifyCatalogModel->rowCount() == 0)
-        qInfo() << "No catalog data found.";
-}
-
 void AddCatalog::modifyClickedAction(const QString &designNo) {
 
 
@@ -644,16 +725,10 @@ void AddCatalog::modifyClickedAction(const QString &designNo) {
     if (!QFile::exists(absPath))
         absPath = QDir(QCoreApplication::applicationDirPath()).filePath(imagePath);
 
-    QPixmap pixmap;
     if (QFile::exists(absPath)) {
-        pixmap.load(absPath);
-        int labelWidth = ui->imageView_label_at_addImage->width();
-        int labelHeight = ui->imageView_label_at_addImage->height();
-
-        if (labelWidth > 0 && labelHeight > 0) {
-            ui->imageView_label_at_addImage->setPixmap(
-                pixmap.scaled(labelWidth, labelHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        }
+        const QSize labelSize = ui->imageView_label_at_addImage->size();
+        if (!labelSize.isEmpty())
+            ui->imageView_label_at_addImage->setPixmap(ThumbnailCache::instance().pixmap(absPath, labelSize));
         qDebug() << "[UI] Image loaded successfully from:" << absPath;
     } else {
         qDebug() << "[UI WARNING] Image file missing, loading placeholder.";
@@ -779,7 +854,7 @@ void AddCatalog::onModifyCatalogContextMenuRightClicked(const QPoint &pos) {
 
     qDebug() << "Index : " << index ;
 
-    QString designNo = index.data(Qt::DisplayRole).toString().section('\n', 0, 0).trimmed();
+    QString designNo = index.data(CatalogListModel::DesignNoRole).toString();
 
     QMenu modifyRightClickMenu ;
     QAction *modifyDesignAct = modifyRightClickMenu.addAction("Modify") ;
@@ -824,11 +899,7 @@ void AddCatalog::setupModifyCatalogView()
             if (!index.isValid())
                 return;
 
-            QStandardItem *item = modifyCatalogModel->itemFromIndex(index);
-            if (!item)
-                return;
-
-            QString designNo = item->data(Qt::UserRole).toString();
+            QString designNo = index.data(CatalogListModel::DesignNoRole).toString();
             if (designNo.isEmpty())
                 return;
 
@@ -941,11 +1012,10 @@ void AddCatalog::setupModifyCatalogView()
     modifyCatalogView->show();
 
     if (!modifyCatalogModel) {
-        modifyCatalogModel = new QStandardItemModel(this);
+        modifyCatalogModel = new CatalogListModel(this);
         modifyCatalogView->setModel(modifyCatalogModel);
+        modifyCatalogView->setItemDelegate(new CatalogItemDelegate(modifyCatalogView));
     }
-
-    modifyCatalogModel->clear();
 }
 
 void AddCatalog::closeEvent(QCloseEvent *event)
@@ -966,48 +1036,8 @@ void AddCatalog::closeEvent(QCloseEvent *event)
 
 void AddCatalog::loadModifyCatalogData()
 {
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-    QSqlDatabase db;
-
-    // Checking... If database is already present then no need to add that database again. It solves database duplication issue.
-    if (QSqlDatabase::contains("modify_catalog_conn")) {
-        db = QSqlDatabase::database("modify_catalog_conn");
-    } else {
-        db = QSqlDatabase::addDatabase("QSQLITE", "modify_catalog_conn");
-        db.setDatabaseName(QDir(QCoreApplication::applicationDirPath())
-                               .filePath("database/mega_mine_image.db"));
-    }
-    if (!db.isOpen() && !db.open()) return;
-
-
-    QSqlQuery query(db);
-    if (!query.exec(R"(SELECT design_no, company_name, image_path FROM image_data WHERE "delete" = 0)")) {
-        db.close();
-        return;
-    }
-
-    while (query.next()) {
-        QString designNo = query.value("design_no").toString();
-        QString company = query.value("company_name").toString();
-        QString imagePath = QDir(QCoreApplication::applicationDirPath()).filePath(query.value("image_path").toString());
-
-        QPixmap pix = QFile::exists(imagePath)
-                          ? QPixmap(imagePath)
-                          : QPixmap(":/icon/no_image_1.png");
-
-        QString companyText = company.left(25) + (company.size() > 25 ? "…" : "");
-        QStandardItem *item = new QStandardItem();
-        item->setIcon(QIcon(pix.scaled(80, 80, Qt::KeepAspectRatio, Qt::SmoothTransformation)));
-        item->setText(designNo + "\n" + companyText);
-        item->setTextAlignment(Qt::AlignCenter);
-        item->setEditable(false);
-        item->setSizeHint(QSize(160, 160));
-        item->setData(designNo, Qt::UserRole) ;
-
-        modifyCatalogModel->appendRow(item);
-    }
-
-    db.close();
+    // First page only; the view pulls further pages and icons as it scrolls
+    modifyCatalogModel->reload();
 }
 
 
@@ -1044,22 +1074,16 @@ void AddCatalog::on_modify_catalog_button_released()
 
     layout->insertWidget(0, modifySearchBar) ;
 
-    connect(modifySearchBar, &QLineEdit::textChanged, this, [this](const QString &text) {
-        if (!modifyCatalogModel) return;
-        if (text.trimmed().isEmpty()) {
-            for (int i = 0; i < modifyCatalogModel->rowCount(); ++i){
-                modifyCatalogView->setRowHidden(i, false);
-            }
-            return;
-        }
-        for (int i = 0; i < modifyCatalogModel->rowCount(); ++i) {
-            QStandardItem *item = modifyCatalogModel->item(i);
-            const QString designNo = item->data(Qt::UserRole).toString();
-            const bool match = designNo.contains(text, Qt::CaseInsensitive);
-            modifyCatalogView->setRowHidden(i, !match);
-        }
-
-    });
+    if (!modifySearchDebounce) {
+        modifySearchDebounce = new QTimer(this);
+        modifySearchDebounce->setSingleShot(true);
+        modifySearchDebounce->setInterval(SearchDebounceMs);
+        connect(modifySearchDebounce, &QTimer::timeout, this, [this]() {
+            if (!modifyCatalogModel) return;
+            modifyCatalogModel->setFilterText(modifySearchBar->text());
+        });
+        connect(modifySearchBar, &QLineEdit::textChanged, modifySearchDebounce, qOverload<>(&QTimer::start));
+    }
 
 
     setupModifyCatalogView();
@@ -3,11 +3,15 @@
 
 #include <QDialog>
 #include <QTableWidget>
-#include <QStandardItem>
 #include <QListView>
 
+#include "commontypes.h"
 #include "jewelrymenu.h"
 
+class CatalogImporter;
+class CatalogListModel;
+class QProgressDialog;
+class QTimer;
 class QKeyEvent;
 
 namespace Ui {
@@ -37,8 +41,6 @@ private slots:
 
     void on_delete_catalog_button_released();
 
-    void loadCatalogForModify();
-
     void onModifyCatalogContextMenuRightClicked(const QPoint &pos) ;
 
     void closeEvent(QCloseEvent *event) override;
@@ -56,6 +58,9 @@ private:
     void deleteClickedAction(const QString &designNo) ;
     void cancelModifyMode() ;
     void resetAddCatalogUI() ;
+    void showImportProgress();
+    void closeImportProgress();
+    bool reviewImportPlan(const CatalogImportPlan &plan, bool canImport);
 
 
 
@@ -64,10 +69,14 @@ private:
     JewelryMenu *jewelryMenu {nullptr}; // Owned by Qt parent (AddCatalog)
     QString selectedImageType;
     QListView *modifyCatalogView {nullptr} ;
-    QStandardItemModel *modifyCatalogModel {nullptr} ;
+    CatalogListModel *modifyCatalogModel {nullptr} ;
     QSqlDatabase modifyCatalogConn;
+    // One search per pause in typing rather than per keystroke
+    static constexpr int SearchDebounceMs = 150;
+    QTimer *modifySearchDebounce {nullptr} ;
 
-    QHash <QString, QStandardItem*> modifyItemMap ;
+    CatalogImporter *catalogImporter {nullptr} ;
+    QProgressDialog *importProgress {nullptr} ;
     bool isModifyMode = false ;
     bool deleteIsSet = false ;
 };
@@ -18,6 +18,7 @@
 
 #include "readonlydelegate.h"
 #include "databaseutils.h"
+#include "thumbnailcache.h"
 #include "utils.h"
 #include "PdfListDialog.h"
 
@@ -74,10 +75,8 @@ void Admin::on_show_images_clicked()
 
     auto updateImage = [this]() {
         if (!imagePaths.isEmpty()) {
-            QPixmap pixmap(imagePaths[currentIndex]);
-            ui->image_viewer->setPixmap(pixmap.scaled(ui->image_viewer->size(),
-                                                      Qt::KeepAspectRatio,
-                                                      Qt::SmoothTransformation));
+            ui->image_viewer->setPixmap(ThumbnailCache::instance().pixmap(imagePaths[currentIndex],
+                                                                          ui->image_viewer->size()));
         } else {
             ui->image_viewer->clear();
         }
@@ -176,7 +175,15 @@ void Admin::on_orderBookRequestPushButton_clicked()
         "Request ID", "Request Role", "Request Role ID", "From", "To", "Request Time", "Action"
     });
 
-    QList<JobSheetRequest> rows = DatabaseUtils::fetchJobSheetRequests();
+    jobSheetRequestsRequest.cancel();
+    jobSheetRequestsRequest = DbExecutor::instance().submit(this, &DatabaseUtils::fetchJobSheetRequests,
+                                                            [this](const QList<JobSheetRequest> &rows) {
+        populateJobSheetRequests(rows);
+    });
+}
+
+void Admin::populateJobSheetRequests(const QList<JobSheetRequest> &rows)
+{
     int row = 0;
 
     for (const auto &r : rows) {
@@ -409,19 +416,28 @@ void Admin::on_show_users_clicked()
 
 
     // Fetch data
-    QList<QVariantList> userDetails = DatabaseUtils::fetchUserDetailsForAdmin();
+    userDetailsRequest.cancel();
+    userDetailsRequest = DbExecutor::instance().submit(this, &DatabaseUtils::fetchUserDetailsForAdmin,
+                                                       [this, columnWidths](const QList<UserSummary> &userDetails) {
+        populateUserTable(userDetails, columnWidths);
+    });
+}
+
+void Admin::populateUserTable(const QList<UserSummary> &userDetails, const QVector<int> &columnWidths)
+{
     if (userDetails.isEmpty()) {
         QMessageBox::warning(this, "No Users", "No user data found in the database.");
         return;
     }
 
     // Populate rows
-    for (const QVariantList &row : userDetails) {
+    for (const UserSummary &user : userDetails) {
         int rowIndex = ui->tableWidget_2->rowCount();
         ui->tableWidget_2->insertRow(rowIndex);
 
-        for (int col = 0; col < row.size(); ++col) {
-            QString displayText = row[col].toString();
+        const QString columns[] = { user.userId, user.companyName, user.lastPdfPath };
+        for (int col = 0; col < 3; ++col) {
+            QString displayText = columns[col];
             if (col == 2 && displayText.startsWith("pdfs/")) {
                 displayText = displayText.mid(5); // strip "pdfs/"
             }
@@ -429,7 +445,7 @@ void Admin::on_show_users_clicked()
             item->setTextAlignment(Qt::AlignCenter);
 
             if (col == 2)
-                item->setData(Qt::UserRole, row[col].toString()); // store full path
+                item->setData(Qt::UserRole, user.lastPdfPath); // store full path
 
             ui->tableWidget_2->setItem(rowIndex, col, item);
         }
@@ -913,22 +929,22 @@ void Admin::populateJewelryMenuTable()
 
     jewelryMenuTable->setRowCount(0);
 
-    const QList<QVariantList> menuItems = DatabaseUtils::fetchJewelryMenuItems();
-    for (const QVariantList &item : menuItems)
+    const QList<JewelryMenuItem> menuItems = DatabaseUtils::fetchJewelryMenuItems();
+    for (const JewelryMenuItem &item : menuItems)
     {
         const int row = jewelryMenuTable->rowCount();
         jewelryMenuTable->insertRow(row);
 
-        auto *idItem = new QTableWidgetItem(QString::number(item[0].toInt()));
-        idItem->setData(Qt::UserRole, item[0].toInt());
+        auto *idItem = new QTableWidgetItem(QString::number(item.id));
+        idItem->setData(Qt::UserRole, item.id);
         jewelryMenuTable->setItem(row, 0, idItem);
 
-        auto *parentItem = new QTableWidgetItem(item[1].toInt() == -1 ? "None" : QString::number(item[1].toInt()));
-        parentItem->setData(Qt::UserRole, item[1].toInt());
+        auto *parentItem = new QTableWidgetItem(item.parentId == -1 ? "None" : QString::number(item.parentId));
+        parentItem->setData(Qt::UserRole, item.parentId);
         jewelryMenuTable->setItem(row, 1, parentItem);
 
-        jewelryMenuTable->setItem(row, 2, new QTableWidgetItem(item[2].toString()));
-        jewelryMenuTable->setItem(row, 3, new QTableWidgetItem(item[3].toString()));
+        jewelryMenuTable->setItem(row, 2, new QTableWidgetItem(item.name));
+        jewelryMenuTable->setItem(row, 3, new QTableWidgetItem(item.displayText));
     }
 }
 
@@ -940,19 +956,11 @@ void Admin::populateParentCategoryComboBox()
     parentCategoryComboBox->clear();
     parentCategoryComboBox->addItem("Select Category", -1);
 
-    const QList<QVariantList> menuItems = DatabaseUtils::fetchJewelryMenuItems();
+    const QList<JewelryMenuItem> menuItems = DatabaseUtils::fetchJewelryMenuItems();
     for (const auto &item : menuItems)
     {
-        if (item.size() < 3)
-            continue; // safety
-
-        const int parentId = item[1].toInt();
-        if (parentId == -1)  // top-level only
-        {
-            const QString categoryName = item[2].toString();
-            const int categoryId = item[0].toInt();
-            parentCategoryComboBox->addItem(categoryName, categoryId);
-        }
+        if (item.parentId == -1)  // top-level only
+            parentCategoryComboBox->addItem(item.name, item.id);
     }
 }
 
@@ -11,6 +11,8 @@
 #include <QTableWidget>
 
 #include "adminmenubuttons.h"
+#include "commontypes.h"
+#include "dbexecutor.h"
 
 namespace Ui {
 class Admin;
@@ -92,6 +94,12 @@ private:
     void populateJewelryMenuTable(); // Populate table with menu items
     void setupJewelryMenuPage(); // New method to create UI elements
     void populateParentCategoryComboBox();
+    void populateJobSheetRequests(const QList<JobSheetRequest> &rows);
+    void populateUserTable(const QList<UserSummary> &userDetails, const QVector<int> &columnWidths);
+
+    // Reads running on a database worker
+    DbRequest jobSheetRequestsRequest;
+    DbRequest userDetailsRequest;
 
     // Widgets for jewelry menu page
     QLineEdit *categoryNameLineEdit = nullptr;
@@ -0,0 +1,266 @@
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QImage>
+#include <QLinearGradient>
+#include <QPainter>
+
+#include "pdfrenderer.h"
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+// Set by pdfbenchmark.pro to the golden/ folder next to it
+#ifndef PDF_GOLDEN_DIR
+#define PDF_GOLDEN_DIR "golden"
+#endif
+
+// Headless PDF render benchmark, no windows or databases:
+//   QT_QPA_PLATFORM=offscreen pdfbenchmark [dir] [--update-golden]
+// Renders synthetic carts (10/100/1000 items) and job-sheet batches into dir and logs wall
+// time, output size and peak memory of each, then compares a fixed job sheet with
+// golden/jobsheet.png. Exits with 1 when the page no longer matches or the golden page is missing.
+
+namespace {
+// Highest resident memory of the process so far, in bytes; 0 where unknown
+qint64 peakMemoryBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return qint64(counters.PeakWorkingSetSize);
+    return 0;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(Q_OS_MACOS)
+    return qint64(usage.ru_maxrss);            // bytes
+#else
+    return qint64(usage.ru_maxrss) * 1024;     // kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+// Camera-sized JPEGs, so decode and downsampling cost what they do for real photos
+QStringList benchmarkImages(const QString &dir, int count)
+{
+    QDir().mkpath(dir);
+    QStringList paths;
+    for (int i = 0; i < count; ++i) {
+        const QString path = QString("%1/design_%2.jpg").arg(dir).arg(i, 2, 10, QChar('0'));
+        if (!QFile::exists(path)) {
+            QImage image(2400, 1800, QImage::Format_RGB32);
+            QPainter painter(&image);
+            QLinearGradient gradient(0, 0, image.width(), image.height());
+            gradient.setColorAt(0, QColor::fromHsv((i * 37) % 360, 180, 230));
+            gradient.setColorAt(1, QColor::fromHsv((i * 37 + 120) % 360, 200, 90));
+            painter.fillRect(image.rect(), gradient);
+            painter.setPen(QPen(Qt::white, 12));
+            for (int ring = 0; ring < 12; ++ring)
+                painter.drawEllipse(image.rect().center(), 80 + ring * 60, 60 + ring * 45);
+            painter.end();
+            image.save(path, "JPEG", 90);
+        }
+        paths.append(path);
+    }
+    return paths;
+}
+
+// items lines over a fixed set of designs, each design in two karats
+CartPdfData benchmarkCart(const QStringList &imagePaths, int items, const QString &pdfPath)
+{
+    const QStringList karats = {"14KT", "18KT"};
+    CartPdfData data;
+    data.pdfPath = pdfPath;
+    data.userId = "+910000000000";
+    data.userName = "Benchmark Customer";
+    data.companyName = "Benchmark Jewellers";
+    data.mobileNo = "+910000000000";
+
+    for (int i = 0; i < items; ++i) {
+        CartPdfItem item;
+        item.imageId = i / karats.size() % imagePaths.size() + 1;
+        item.imagePath = imagePaths[item.imageId - 1];
+        item.goldType = karats[i % karats.size()];
+        item.itemCount = 1 + i % 3;
+        item.goldWeight = 4.25 * item.itemCount;
+        data.items.append(item);
+        data.goldByKarat[item.goldType] += item.goldWeight;
+    }
+
+    for (int i = 0; i < qMax(1, items / 5); ++i) {
+        CartPdfPieceRow row;
+        row.type = i % 2 ? "Oval" : "Round";
+        row.sizeMM = QString::number(1.0 + i * 0.05, 'f', 2);
+        row.quantity = 4 + i % 7;
+        row.weight = 0.005 + i * 0.001;
+        row.totalWeight = row.weight * row.quantity;
+        (i % 3 ? data.diamonds : data.stones).append(row);
+    }
+    return data;
+}
+
+void logRun(const QString &name, const PdfRenderResult &result, qint64 elapsedMs)
+{
+    const QFileInfo file(result.pdfPath);
+    qint64 bytes = 0;
+    if (file.isDir()) {
+        for (const QFileInfo &entry : QDir(result.pdfPath).entryInfoList({"*.pdf"}, QDir::Files))
+            bytes += entry.size();
+    } else {
+        bytes = file.size();
+    }
+
+    qDebug().noquote() << QString("[PDF] %1: %2 pages, %3 KiB in %4 ms, peak RSS %5 MiB%6")
+                              .arg(name, -18).arg(result.pages).arg(bytes / 1024).arg(elapsedMs)
+                              .arg(peakMemoryBytes() / (1024 * 1024))
+                              .arg(result.ok ? QString() : " FAILED: " + result.error);
+}
+
+// The job sheet page painted at 100 dpi, in the 400 dpi coordinates the PDF uses
+QImage rasterJobSheet(const JobSheetPdfData &job)
+{
+    constexpr int PdfDpi = 400;
+    constexpr int RasterDpi = 100;
+    QImage page(612 * RasterDpi / 72, 842 * RasterDpi / 72, QImage::Format_RGB32);
+    // Fonts are sized against the image's resolution; match the PDF's so text lays out the same
+    page.setDotsPerMeterX(qRound(PdfDpi / 0.0254));
+    page.setDotsPerMeterY(qRound(PdfDpi / 0.0254));
+    page.fill(Qt::white);
+
+    QPainter painter(&page);
+    painter.scale(qreal(RasterDpi) / PdfDpi, qreal(RasterDpi) / PdfDpi);
+    PdfRenderer::paintJobSheetPage(painter, job);
+    painter.end();
+    return page;
+}
+
+// Pixels whose channels differ by more than a little; anti-aliasing noise stays under it
+int differingPixels(const QImage &a, const QImage &b, QImage *diff)
+{
+    *diff = QImage(a.size(), QImage::Format_RGB32);
+    diff->fill(Qt::white);
+
+    int count = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const QRgb *rowA = reinterpret_cast<const QRgb *>(a.constScanLine(y));
+        const QRgb *rowB = reinterpret_cast<const QRgb *>(b.constScanLine(y));
+        QRgb *rowDiff = reinterpret_cast<QRgb *>(diff->scanLine(y));
+        for (int x = 0; x < a.width(); ++x) {
+            const int delta = qMax(qAbs(qRed(rowA[x]) - qRed(rowB[x])),
+                                   qMax(qAbs(qGreen(rowA[x]) - qGreen(rowB[x])), qAbs(qBlue(rowA[x]) - qBlue(rowB[x]))));
+            if (delta > 48) {
+                rowDiff[x] = qRgb(255, 0, 0);
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+bool runBenchmark(const QString &outputDir, bool updateGolden)
+{
+    const QString dir = QDir(outputDir).absolutePath();
+    QDir().mkpath(dir);
+    qDebug().noquote() << "[PDF] Benchmark output in" << dir;
+
+    const QStringList images = benchmarkImages(dir + "/fixtures", 20);
+    QElapsedTimer timer;
+
+    for (int items : {10, 100, 1000}) {
+        const CartPdfData cart = benchmarkCart(images, items, QString("%1/cart_%2.pdf").arg(dir).arg(items));
+        timer.start();
+        const PdfRenderResult result = PdfRenderer::cartPdf(cart);
+        logRun(QString("cart %1 items").arg(items), result, timer.elapsed());
+    }
+
+    for (int count : {1, 10, 100}) {
+        QList<JobSheetPdfData> jobs;
+        for (int i = 0; i < count; ++i) {
+            JobSheetPdfData job;
+            job.jobNo = QString("BM%1").arg(i + 1, 5, 10, QChar('0'));
+            job.partyId = "P0001";
+            job.orderDate = "2026-01-01";
+            job.deliveryDate = "2026-01-15";
+            job.pdfPath = QString("%1/jobsheets_%2/jobSheet_%3.pdf").arg(dir).arg(count).arg(job.jobNo);
+            jobs.append(job);
+        }
+
+        timer.start();
+        logRun(QString("job sheets x%1").arg(count), PdfRenderer::jobSheetPdfs(jobs, QString()), timer.elapsed());
+        timer.start();
+        logRun(QString("merged x%1").arg(count), PdfRenderer::jobSheetPdfs(jobs, QString("%1/jobsheets_%2.pdf").arg(dir).arg(count)),
+               timer.elapsed());
+    }
+
+    // Layout check: a fixed job sheet against the reference page committed with the sources.
+    // It compares what the job sheet painter draws, not the PDF file: without the QtPdf module
+    // there is nothing to rasterise a PDF with, so QPdfWriter's own output is not covered.
+    JobSheetPdfData goldenJob;
+    goldenJob.jobNo = "GOLDEN01";
+    goldenJob.partyId = "P0001";
+    goldenJob.orderDate = "2026-01-01";
+    goldenJob.deliveryDate = "2026-01-15";
+    const QImage page = rasterJobSheet(goldenJob);
+
+    const QString goldenPath = QDir(PDF_GOLDEN_DIR).absoluteFilePath("jobsheet.png");
+    if (updateGolden) {
+        QDir().mkpath(QFileInfo(goldenPath).absolutePath());
+        if (!page.save(goldenPath)) {
+            qWarning().noquote() << "[ERROR] Failed to write golden page" << goldenPath;
+            return false;
+        }
+        qDebug().noquote() << "[PDF] Golden page written to" << goldenPath << "- commit it with the layout change";
+        return true;
+    }
+
+    const QImage golden(goldenPath);
+    if (golden.isNull()) {
+        page.save(dir + "/jobsheet_actual.png");
+        qWarning().noquote() << "[ERROR] Golden page missing or unreadable:" << goldenPath
+                             << "- run with --update-golden to create it";
+        return false;
+    }
+
+    if (golden.size() != page.size()) {
+        qWarning().noquote() << "[WARNING] Job sheet page size changed:" << golden.size() << "->" << page.size();
+        return false;
+    }
+
+    QImage diff;
+    const int changed = differingPixels(golden.convertToFormat(QImage::Format_RGB32), page, &diff);
+    if (changed > 0) {
+        diff.save(dir + "/jobsheet_diff.png");
+        page.save(dir + "/jobsheet_actual.png");
+        qWarning().noquote() << "[WARNING] Job sheet layout differs from golden page in" << changed << "pixels";
+        return false;
+    }
+
+    qDebug() << "[PDF] Job sheet layout matches the golden page";
+    return true;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QGuiApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    QString outputDir = args.value(1);
+    if (outputDir.isEmpty() || outputDir.startsWith("--"))
+        outputDir = QDir::current().filePath("pdf-benchmark");
+    return runBenchmark(outputDir, args.contains("--update-golden")) ? 0 : 1;
+}
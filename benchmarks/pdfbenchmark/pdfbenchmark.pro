@@ -0,0 +1,28 @@
+# Headless PDF render benchmark and job-sheet layout check; built apart from the app:
+#   qmake benchmarks/pdfbenchmark/pdfbenchmark.pro && make
+#   QT_QPA_PLATFORM=offscreen ./pdfbenchmark [dir] [--update-golden]
+
+QT       += core gui printsupport concurrent
+
+CONFIG += c++20 console
+CONFIG -= app_bundle
+
+TARGET = pdfbenchmark
+
+APP_DIR = $$PWD/../..
+INCLUDEPATH += $$APP_DIR
+
+# Peak working set
+win32: LIBS += -lpsapi
+
+# Reference page for the layout check, kept with the benchmark
+DEFINES += PDF_GOLDEN_DIR=\\\"$$PWD/golden\\\"
+
+SOURCES += \
+    main.cpp \
+    $$APP_DIR/commontypes.cpp \
+    $$APP_DIR/pdfrenderer.cpp
+
+HEADERS += \
+    $$APP_DIR/commontypes.h \
+    $$APP_DIR/pdfrenderer.h
@@ -0,0 +1,276 @@
+#include <QHeaderView>
+#include <QTableWidget>
+
+#include <algorithm>
+
+#include "cartsummary.h"
+#include "databaseutils.h"
+
+namespace {
+const char *const TotalLabel = "Total";
+constexpr int ColumnCount = 5;
+}
+
+QHash<CartSummary::LineKey, CartSummary::LineDetails> CartSummary::fetchDetails(const QList<SelectionData> &lines)
+{
+    QHash<LineKey, LineDetails> details;
+
+    QList<int> imageIds;
+    imageIds.reserve(lines.size());
+    for (const SelectionData &line : lines)
+        imageIds.append(line.imageId);
+
+    // First entry per (design, karat), as the JSON lookup used to take
+    QHash<LineKey, double> goldByKarat;
+    for (const CatalogGold &entry : DatabaseUtils::fetchCatalogGold(imageIds)) {
+        const LineKey key{entry.imageId, entry.karat};
+        if (!goldByKarat.contains(key))
+            goldByKarat.insert(key, entry.weight);
+    }
+
+    // Pieces of every design, weighed against one reference snapshot
+    QHash<int, QList<QPair<PieceKey, PieceTotal>>> piecesById[2];
+    const QString types[2] = {"diamond", "stone"};
+    for (int t = 0; t < 2; ++t) {
+        const QList<CatalogPiece> pieces = DatabaseUtils::fetchCatalogPieces(imageIds, types[t]);
+
+        QList<WeightKey> weightKeys;
+        weightKeys.reserve(pieces.size());
+        for (const CatalogPiece &piece : pieces)
+            weightKeys.append({t == 0, piece.type, piece.sizeMM});
+        const QList<double> singleWeights = DatabaseUtils::resolveWeights(weightKeys);
+
+        for (int i = 0; i < pieces.size(); ++i) {
+            const CatalogPiece &piece = pieces[i];
+            piecesById[t][piece.imageId].append({{piece.type, piece.sizeMM},
+                                                 {piece.quantity, singleWeights[i] * piece.quantity}});
+        }
+    }
+
+    for (const SelectionData &line : lines) {
+        LineDetails &entry = details[{line.imageId, line.goldType}];
+        entry.goldWeight = goldByKarat.value({line.imageId, line.goldType});
+        entry.diamonds = piecesById[0].value(line.imageId);
+        entry.stones = piecesById[1].value(line.imageId);
+    }
+
+    return details;
+}
+
+void CartSummary::clear()
+{
+    lines.clear();
+    gold.clear();
+    goldTotal = 0.0;
+    diamondTotals.clear();
+    stoneTotals.clear();
+}
+
+bool CartSummary::contains(int imageId, const QString &goldType) const
+{
+    return lines.contains({imageId, goldType});
+}
+
+double CartSummary::goldWeight(int imageId, const QString &goldType) const
+{
+    const auto it = lines.constFind({imageId, goldType});
+    return it == lines.cend() ? 0.0 : it->details.goldWeight * it->quantity;
+}
+
+CartSummary::Changes CartSummary::setLine(int imageId, const QString &goldType, int quantity, const LineDetails &details)
+{
+    Changes changes;
+    auto it = lines.find({imageId, goldType});
+    if (it != lines.end()) {
+        apply(goldType, it->details, -it->quantity, changes);
+        it->details = details;
+    } else {
+        it = lines.insert({imageId, goldType}, Line());
+        it->details = details;
+    }
+    it->quantity = quantity;
+    apply(goldType, details, quantity, changes);
+    return changes;
+}
+
+CartSummary::Changes CartSummary::setQuantity(int imageId, const QString &goldType, int quantity)
+{
+    Changes changes;
+    const auto it = lines.find({imageId, goldType});
+    if (it == lines.end())
+        return changes;
+
+    apply(goldType, it->details, quantity - it->quantity, changes);
+    it->quantity = quantity;
+    return changes;
+}
+
+CartSummary::Changes CartSummary::remove(int imageId, const QString &goldType)
+{
+    Changes changes;
+    const auto it = lines.find({imageId, goldType});
+    if (it == lines.end())
+        return changes;
+
+    apply(goldType, it->details, -it->quantity, changes);
+    lines.erase(it);
+    return changes;
+}
+
+void CartSummary::apply(const QString &goldType, const LineDetails &details, int delta, Changes &changes)
+{
+    if (delta == 0)
+        return;
+
+    if (details.goldWeight != 0.0) {
+        double &karatTotal = gold[goldType];
+        karatTotal += details.goldWeight * delta;
+        goldTotal += details.goldWeight * delta;
+        // Repeated += / -= leaves rounding residue; an emptied karat is dropped
+        if (qAbs(karatTotal) < 1e-9)
+            gold.remove(goldType);
+        if (gold.isEmpty())
+            goldTotal = 0.0;
+        changes.gold = true;
+    }
+
+    applyPieces(diamondTotals, details.diamonds, delta, changes.diamonds);
+    applyPieces(stoneTotals, details.stones, delta, changes.stones);
+}
+
+void CartSummary::applyPieces(QMap<PieceKey, PieceTotal> &totals, const QList<QPair<PieceKey, PieceTotal>> &pieces,
+                              int delta, QSet<PieceKey> &changed)
+{
+    for (const auto &piece : pieces) {
+        PieceTotal &total = totals[piece.first];
+        total.quantity += piece.second.quantity * delta;
+        total.weight += piece.second.weight * delta;
+        if (total.quantity <= 0)
+            totals.remove(piece.first);
+        changed.insert(piece.first);
+    }
+}
+
+void CartSummaryTable::render(QTableWidget *widget, const QMap<PieceKey, PieceTotal> &totals)
+{
+    table = widget;
+    keys.clear();
+    shown.clear();
+    totalQuantity = 0;
+    totalWeight = 0.0;
+
+    const QStringList headers = {"Shape/Type", "SizeMM", "Quantity", "Weight", "Total Weight"};
+    table->setColumnCount(headers.size());
+    table->setHorizontalHeaderLabels(headers);
+    table->horizontalHeader()->setVisible(true);
+    table->horizontalHeader()->setStyleSheet("QHeaderView::section { background-color: black; color: white; font-weight: bold; font-size: 14px; }");
+    table->setRowCount(0);
+
+    keys.reserve(totals.size());
+    for (auto it = totals.cbegin(); it != totals.cend(); ++it) {
+        const int row = table->rowCount();
+        table->insertRow(row);
+        keys.append(it.key());
+        setRow(row, it.key(), it.value());
+    }
+    setTotalRow();
+
+    table->resizeColumnsToContents();
+    table->resizeRowsToContents();
+}
+
+void CartSummaryTable::update(QTableWidget *widget, const QMap<PieceKey, PieceTotal> &totals, const QSet<PieceKey> &changed)
+{
+    if (widget != table || table->columnCount() != ColumnCount) {
+        render(widget, totals);
+        return;
+    }
+    if (changed.isEmpty())
+        return;
+
+    for (const PieceKey &key : changed) {
+        const auto total = totals.constFind(key);
+        int row = rowOf(key);
+
+        if (total == totals.cend()) {
+            if (row >= 0) {
+                const PieceTotal old = shown.take(key);
+                totalQuantity -= old.quantity;
+                totalWeight -= old.weight;
+                keys.removeAt(row);
+                table->removeRow(row);
+            }
+            continue;
+        }
+
+        if (row < 0) {
+            // Keys stay sorted like the totals map, so the row lands where a full render puts it
+            row = int(std::lower_bound(keys.cbegin(), keys.cend(), key) - keys.cbegin());
+            keys.insert(row, key);
+            table->insertRow(row);
+        }
+        setRow(row, key, total.value());
+    }
+
+    // Rounding residue of repeated += / -= must not show as a total for an empty table
+    if (keys.isEmpty()) {
+        totalQuantity = 0;
+        totalWeight = 0.0;
+    }
+    setTotalRow();
+}
+
+int CartSummaryTable::rowOf(const PieceKey &key) const
+{
+    const auto it = std::lower_bound(keys.cbegin(), keys.cend(), key);
+    return it != keys.cend() && *it == key ? int(it - keys.cbegin()) : -1;
+}
+
+void CartSummaryTable::setRow(int row, const PieceKey &key, const PieceTotal &total)
+{
+    const PieceTotal old = shown.value(key);
+    totalQuantity += total.quantity - old.quantity;
+    totalWeight += total.weight - old.weight;
+    shown.insert(key, total);
+
+    const double singleWeight = total.quantity > 0 ? total.weight / total.quantity : 0.0;
+    setCell(row, 0, key.first);
+    setCell(row, 1, key.second);
+    setCell(row, 2, QString::number(total.quantity));
+    setCell(row, 3, QString::number(singleWeight, 'f', 3) + "ct");
+    setCell(row, 4, QString::number(total.weight, 'f', 3) + "ct");
+}
+
+void CartSummaryTable::setCell(int row, int column, const QString &text)
+{
+    QTableWidgetItem *item = table->item(row, column);
+    if (!item) {
+        item = new QTableWidgetItem(text);
+        table->setItem(row, column, item);
+    } else if (item->text() != text) {
+        item->setText(text);
+    } else {
+        return;
+    }
+
+    // Widen the column for this cell alone instead of measuring every row again
+    const int width = table->fontMetrics().horizontalAdvance(text) + 16;
+    if (width > table->columnWidth(column))
+        table->setColumnWidth(column, width);
+}
+
+void CartSummaryTable::setTotalRow()
+{
+    const int row = int(keys.size());
+    if (keys.isEmpty()) {
+        if (table->rowCount() > row)
+            table->setRowCount(row);
+        return;
+    }
+
+    if (table->rowCount() <= row)
+        table->insertRow(row);
+    setCell(row, 0, TotalLabel);
+    setCell(row, 2, QString::number(totalQuantity));
+    setCell(row, 4, QString::number(totalWeight, 'f', 3) + "ct");
+}
@@ -0,0 +1,107 @@
+#ifndef CARTSUMMARY_H
+#define CARTSUMMARY_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QSet>
+#include <QString>
+
+#include "commontypes.h"
+
+class QTableWidget;
+
+// Running totals of a cart: gold weight per karat and quantity/weight per diamond and stone
+// (shape, size). What one item of each line contributes is looked up once when the line is
+// added; after that a quantity change, add or remove applies only that line's difference,
+// so its cost does not grow with the cart. The Changes returned by each update name the
+// summary rows that moved, for CartSummaryTable::update().
+class CartSummary
+{
+public:
+    using PieceKey = QPair<QString, QString>;   // (shape/type, sizeMM)
+    using LineKey = QPair<int, QString>;        // (image id, gold karat)
+
+    struct PieceTotal {
+        int quantity = 0;
+        double weight = 0.0;   // carats
+    };
+
+    // Contribution of a single item of a line
+    struct LineDetails {
+        double goldWeight = 0.0;
+        QList<QPair<PieceKey, PieceTotal>> diamonds;
+        QList<QPair<PieceKey, PieceTotal>> stones;
+    };
+
+    struct Changes {
+        QSet<PieceKey> diamonds;
+        QSet<PieceKey> stones;
+        bool gold = false;
+    };
+
+    // Details for every line in a handful of queries, whatever the number of lines
+    static QHash<LineKey, LineDetails> fetchDetails(const QList<SelectionData> &lines);
+
+    void clear();
+    bool contains(int imageId, const QString &goldType) const;
+
+    // Adds the line, or replaces its quantity and details when it is already there
+    Changes setLine(int imageId, const QString &goldType, int quantity, const LineDetails &details);
+    Changes setQuantity(int imageId, const QString &goldType, int quantity);
+    Changes remove(int imageId, const QString &goldType);
+
+    double totalGold() const { return goldTotal; }
+    double goldWeight(int imageId, const QString &goldType) const;   // whole line, all items
+    const QMap<QString, double> &goldByKarat() const { return gold; }
+    const QMap<PieceKey, PieceTotal> &diamonds() const { return diamondTotals; }
+    const QMap<PieceKey, PieceTotal> &stones() const { return stoneTotals; }
+
+private:
+    struct Line {
+        int quantity = 0;
+        LineDetails details;
+    };
+
+    void apply(const QString &goldType, const LineDetails &details, int delta, Changes &changes);
+    static void applyPieces(QMap<PieceKey, PieceTotal> &totals, const QList<QPair<PieceKey, PieceTotal>> &pieces,
+                            int delta, QSet<PieceKey> &changed);
+
+    QHash<LineKey, Line> lines;
+    QMap<QString, double> gold;
+    double goldTotal = 0.0;
+    QMap<PieceKey, PieceTotal> diamondTotals;
+    QMap<PieceKey, PieceTotal> stoneTotals;
+};
+
+// A summary table (shape, size, quantity, weight per piece, total weight, then a Total row)
+// kept in step with one of CartSummary's piece totals. The sorted keys on screen stand for
+// the table rows and the grand total is kept running, so an edit rewrites the cells of its
+// own rows and of the Total row only; rows are inserted or removed just when a piece
+// appears in or leaves the cart.
+class CartSummaryTable
+{
+public:
+    using PieceKey = CartSummary::PieceKey;
+    using PieceTotal = CartSummary::PieceTotal;
+
+    // Rebuilds table from totals; update() applies changed keys to the table render() built,
+    // and renders instead when table has not been built by this object
+    void render(QTableWidget *table, const QMap<PieceKey, PieceTotal> &totals);
+    void update(QTableWidget *table, const QMap<PieceKey, PieceTotal> &totals, const QSet<PieceKey> &changed);
+
+private:
+    int rowOf(const PieceKey &key) const;   // -1 when key has no row
+    void setRow(int row, const PieceKey &key, const PieceTotal &total);
+    void setCell(int row, int column, const QString &text);
+    void setTotalRow();
+
+    QTableWidget *table = nullptr;
+    QList<PieceKey> keys;                   // row i shows keys[i]; the Total row follows
+    QHash<PieceKey, PieceTotal> shown;      // what each row shows, for the running total
+    int totalQuantity = 0;
+    double totalWeight = 0.0;
+};
+
+#endif // CARTSUMMARY_H
@@ -0,0 +1,691 @@
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPair>
+#include <QSet>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include <xlsxdocument.h>
+
+#include "catalogimport.h"
+#include "connectionpool.h"
+#include "databaseutils.h"
+#include "imageingest.h"
+#include "imagestore.h"
+#include "referencedatacache.h"
+
+namespace {
+QString cellText(QXlsx::Document &xlsx, int row, int column)
+{
+    return xlsx.read(row, column).toString().trimmed();
+}
+
+// Add_Diamond / Add_Stone: design no, type, size, quantity per row. Pieces go to the last
+// Add_Catalog row of their design, the one an import would use.
+void readPieces(QXlsx::Document &xlsx, const QString &sheet, const QHash<QString, int> &rowByDesign,
+                QList<CatalogImportRow> &rows, QList<StoneData> CatalogImportRow::*pieces)
+{
+    if (!xlsx.selectSheet(sheet))
+        return;
+
+    const int lastRow = xlsx.dimension().lastRow();
+    for (int row = 2; row <= lastRow; ++row) {
+        const QString designNo = cellText(xlsx, row, 1);
+        const auto it = rowByDesign.constFind(designNo);
+        if (designNo.isEmpty() || it == rowByDesign.constEnd())
+            continue;
+
+        (rows[*it].*pieces).append({cellText(xlsx, row, 2), cellText(xlsx, row, 4), cellText(xlsx, row, 3)});
+    }
+}
+
+QJsonArray piecesArray(const QList<StoneData> &pieces)
+{
+    QJsonArray array;
+    for (const StoneData &piece : pieces)
+        array.append(QJsonObject{{"type", piece.type}, {"sizeMM", piece.sizeMM}, {"quantity", piece.quantity}});
+    return array;
+}
+
+QByteArray compactJson(const QJsonArray &array)
+{
+    return QJsonDocument(array).toJson(QJsonDocument::Compact);
+}
+
+// Stored JSON and sheet values compared as documents, so whitespace and key order do not count
+bool sameJson(const QString &stored, const QJsonArray &imported)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(stored.toUtf8());
+    if (doc.isNull())
+        return imported.isEmpty() && stored.trimmed().isEmpty();
+    return doc.isArray() && doc.array() == imported;
+}
+
+QJsonArray goldArray(const CatalogImportRow &row)
+{
+    return DatabaseUtils::generateGoldWeights(row.goldKarat, row.goldWeight);
+}
+}
+
+CatalogImporter::CatalogImporter(QObject *parent)
+    : QObject(parent)
+    , progress(std::make_shared<Progress>())
+    , progressTimer(new QTimer(this))
+{
+    // Polled rather than signalled from the worker, so the worker never touches this object
+    progressTimer->setInterval(100);
+    connect(progressTimer, &QTimer::timeout, this, [this]() {
+        emit progressChanged(progress->stage.load(), progress->done.load(), progress->total.load());
+    });
+}
+
+void CatalogImporter::startTask()
+{
+    running = true;
+    progress = std::make_shared<Progress>();
+    progressTimer->start();
+}
+
+void CatalogImporter::finishTask()
+{
+    running = false;
+    progressTimer->stop();
+}
+
+void CatalogImporter::startPlan(const QString &filePath)
+{
+    if (running)
+        return;
+
+    startTask();
+    const auto shared = progress;
+    request = DbExecutor::instance().submit(this, [filePath, shared]() {
+        return plan(filePath, shared.get());
+    }, [this](const CatalogImportPlan &result) {
+        finishTask();
+        if (result.cancelled) {
+            CatalogImportSummary summary;
+            summary.cancelled = true;
+            emit finished(summary);
+            return;
+        }
+        emit planned(result);
+    });
+}
+
+void CatalogImporter::startCommit(const CatalogImportPlan &importPlan)
+{
+    if (running)
+        return;
+
+    startTask();
+    const auto shared = progress;
+    request = DbExecutor::instance().submit(this, [importPlan, shared]() {
+        return commit(importPlan, shared.get());
+    }, [this](const CatalogImportSummary &summary) {
+        finishTask();
+        emit finished(summary);
+    });
+}
+
+void CatalogImporter::cancel()
+{
+    if (!running)
+        return;
+
+    // The worker stops at its next check and reports back, a commit after rolling back.
+    // The request itself stays live so that report is delivered, and the importer counts
+    // as running until then.
+    progress->cancelRequested.store(true);
+}
+
+bool CatalogImporter::isCancelled(const Progress *progress)
+{
+    return DbExecutor::isCancelled() || (progress && progress->cancelRequested.load());
+}
+
+QString CatalogImporter::stageText(int stage)
+{
+    switch (stage) {
+    case Reading:  return "Reading workbook…";
+    case Checking: return "Checking rows…";
+    case Images:   return "Storing images…";
+    case Writing:  return "Saving designs…";
+    default:       return QString();
+    }
+}
+
+QString CatalogImporter::actionText(CatalogImportPlanRow::Action action)
+{
+    switch (action) {
+    case CatalogImportPlanRow::Insert: return "Insert";
+    case CatalogImportPlanRow::Update: return "Update";
+    case CatalogImportPlanRow::Skip:   return "Skip";
+    }
+    return QString();
+}
+
+QList<CatalogImportRow> CatalogImporter::readWorkbook(const QString &filePath, QString *error)
+{
+    QList<CatalogImportRow> rows;
+
+    QXlsx::Document xlsx(filePath);
+    if (!xlsx.load()) {
+        if (error) *error = "Failed to load Excel: " + filePath;
+        return rows;
+    }
+    if (!xlsx.selectSheet("Add_Catalog")) {
+        if (error) *error = "Add_Catalog sheet not found";
+        return rows;
+    }
+
+    // One pass per sheet over the used range
+    QHash<QString, int> rowByDesign;
+    const int lastRow = xlsx.dimension().lastRow();
+    rows.reserve(qMax(0, lastRow - 1));
+    for (int row = 2; row <= lastRow; ++row) {   // row 1 is headers
+        CatalogImportRow design;
+        design.sheetRow = row;
+        design.designNo = cellText(xlsx, row, 1);
+        if (design.designNo.isEmpty())
+            continue;
+        design.imageType = cellText(xlsx, row, 2);
+        design.companyName = cellText(xlsx, row, 3);
+        design.goldKarat = xlsx.read(row, 4).toInt();
+        design.goldWeight = xlsx.read(row, 5).toDouble();
+        design.imagePath = cellText(xlsx, row, 6);
+        design.note = xlsx.read(row, 7).toString();
+
+        rowByDesign.insert(design.designNo, rows.size());
+        rows.append(design);
+    }
+
+    readPieces(xlsx, "Add_Diamond", rowByDesign, rows, &CatalogImportRow::diamonds);
+    readPieces(xlsx, "Add_Stone", rowByDesign, rows, &CatalogImportRow::stones);
+
+    return rows;
+}
+
+QHash<QString, CatalogImporter::ExistingDesign> CatalogImporter::existingDesigns(const QStringList &designNos, bool *ok)
+{
+    QHash<QString, ExistingDesign> existing;
+    if (ok) *ok = false;
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open image DB:" << db.lastError().text();
+        return existing;
+    }
+
+    constexpr int ChunkSize = ConnectionPool::MaxInListSize;
+    for (int start = 0; start < designNos.size(); start += ChunkSize) {
+        const int count = qMin(ChunkSize, int(designNos.size()) - start);
+
+        // Fixed list lengths share cached statements; padding repeats the last design no.
+        const int size = ConnectionPool::inListSize(count);
+        PooledQuery query = ConnectionPool::instance().prepare(db, QString(R"(
+            SELECT design_no, image_path, image_type, company_name, gold_weight, diamond, stone, note
+            FROM image_data WHERE design_no IN (%1)
+        )").arg(ConnectionPool::inListPlaceholders(size)));
+        for (int i = 0; i < size; ++i)
+            query->bindValue(i, designNos[start + qMin(i, count - 1)]);
+
+        if (!query->exec()) {
+            qWarning() << "[ERROR] Existing design lookup failed:" << query->lastError().text();
+            return existing;
+        }
+        while (query->next()) {
+            existing.insert(query->value(0).toString(),
+                            {query->value(1).toString(), query->value(2).toString(), query->value(3).toString(),
+                             query->value(4).toString(), query->value(5).toString(), query->value(6).toString(),
+                             query->value(7).toString()});
+        }
+    }
+
+    if (ok) *ok = true;
+    return existing;
+}
+
+void CatalogImporter::checkRows(QList<CatalogImportPlanRow> &rows)
+{
+    // Every diamond/stone piece of the sheet is resolved against one reference snapshot in a
+    // single call; pieceOwners maps each key back to its row and description
+    QList<WeightKey> pieceKeys;
+    QList<QPair<int, QString>> pieceOwners;
+    QHash<QString, bool> fileExists;   // each distinct path is checked once
+
+    for (int i = 0; i < rows.size(); ++i) {
+        CatalogImportPlanRow &plan = rows[i];
+        const CatalogImportRow &row = plan.row;
+
+        if (row.goldKarat < 1 || row.goldKarat > 24)
+            plan.problems << QString("Gold karat %1 is outside 1-24").arg(row.goldKarat);
+        if (row.goldWeight <= 0.0)
+            plan.problems << "Gold weight must be greater than 0";
+
+        if (row.imagePath.isEmpty()) {
+            plan.problems << "No image path";
+        } else {
+            const QString file = ImageStore::isStorePath(row.imagePath) ? ImageStore::absolutePath(row.imagePath)
+                                                                        : row.imagePath;
+            auto found = fileExists.constFind(file);
+            if (found == fileExists.constEnd())
+                found = fileExists.insert(file, QFileInfo::exists(file));
+            if (!*found)
+                plan.problems << "Image not found: " + row.imagePath;
+        }
+
+        const auto collect = [&](const QList<StoneData> &pieces, bool isDiamond) {
+            const QString kind = isDiamond ? "Diamond" : "Stone";
+            for (const StoneData &piece : pieces) {
+                bool quantityOk = false;
+                const int quantity = piece.quantity.toInt(&quantityOk);
+
+                // Only round sizes must be numbers; fancy and stone sizes may be text ("4x6")
+                // and are checked against the reference table as written
+                const bool isRound = isDiamond && piece.type.compare("Round", Qt::CaseInsensitive) == 0;
+                bool sizeOk = false;
+                const double size = piece.sizeMM.toDouble(&sizeOk);
+
+                if (piece.type.isEmpty())
+                    plan.problems << kind + " without a shape";
+                else if (piece.sizeMM.isEmpty())
+                    plan.problems << QString("%1 %2 without a size").arg(kind, piece.type);
+                else if (isRound && (!sizeOk || size <= 0.0))
+                    plan.problems << QString("%1 %2 size '%3' is not a number").arg(kind, piece.type, piece.sizeMM);
+                else {
+                    pieceKeys.append({isDiamond, piece.type, piece.sizeMM});
+                    pieceOwners.append({i, QString("%1 %2 %3 mm").arg(kind, piece.type, piece.sizeMM)});
+                }
+                if (!quantityOk || quantity <= 0)
+                    plan.problems << QString("%1 %2 quantity '%3' must be a positive whole number").arg(kind, piece.type, piece.quantity);
+            }
+        };
+        collect(row.diamonds, true);
+        collect(row.stones, false);
+    }
+
+    const QList<bool> listed = ReferenceDataCache::instance().contains(pieceKeys);
+    for (int k = 0; k < listed.size(); ++k) {
+        if (!listed[k])
+            rows[pieceOwners[k].first].problems << pieceOwners[k].second + " is not in the reference table";
+    }
+}
+
+QSet<QString> CatalogImporter::unchangedImages(const QList<CatalogImportPlanRow> &rows,
+                                               const QHash<QString, ExistingDesign> &existing, Progress *progress)
+{
+    QSet<QString> unchanged;
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open image DB:" << db.lastError().text();
+        return unchanged;
+    }
+
+    // Each distinct file is hashed once and each blob looked up once
+    QHash<QString, QString> fileHashes;
+    const auto fileHash = [&fileHashes](const QString &path) {
+        auto it = fileHashes.constFind(path);
+        if (it == fileHashes.constEnd())
+            it = fileHashes.insert(path, ImageStore::hashFile(path));
+        return *it;
+    };
+    QHash<QString, QString> originalHashes;
+    PooledQuery original = ConnectionPool::instance().prepare(db,
+        "SELECT original_hash FROM image_blobs WHERE hash = :hash");
+    const auto originalHash = [&originalHashes, &original](const QString &blobHash) {
+        auto it = originalHashes.constFind(blobHash);
+        if (it == originalHashes.constEnd()) {
+            original->bindValue(":hash", blobHash);
+            const bool found = original->exec() && original->next();
+            it = originalHashes.insert(blobHash, found ? original->value(0).toString() : QString());
+        }
+        return *it;
+    };
+
+    // Rows left for the last test: the sheet file normalized again must give the blob's bytes
+    struct Pending {
+        QString designNo;
+        QString source;
+        QString blobHash;
+    };
+    QList<Pending> pending;
+    QStringList pendingSources;
+
+    for (const CatalogImportPlanRow &plan : rows) {
+        const CatalogImportRow &row = plan.row;
+        const auto it = existing.constFind(row.designNo);
+        if (!plan.problems.isEmpty() || it == existing.constEnd() || row.imagePath == it->imagePath)
+            continue;
+
+        const QString source = ImageStore::isStorePath(row.imagePath) ? ImageStore::absolutePath(row.imagePath)
+                                                                      : row.imagePath;
+        const QString sourceHash = fileHash(source);
+        if (sourceHash.isEmpty())
+            continue;
+
+        // Designs saved before the store hold a plain file path
+        if (!ImageStore::isStorePath(it->imagePath)) {
+            if (sourceHash == fileHash(it->imagePath))
+                unchanged.insert(row.designNo);
+            continue;
+        }
+
+        const QString blobHash = QFileInfo(it->imagePath).completeBaseName();
+        if (sourceHash == blobHash || sourceHash == originalHash(blobHash)) {
+            unchanged.insert(row.designNo);
+            continue;
+        }
+
+        if (!pendingSources.contains(source))
+            pendingSources.append(source);
+        pending.append({row.designNo, source, blobHash});
+    }
+
+    QHash<QString, QString> normalizedHashes;
+    for (int start = 0; start < pendingSources.size(); start += ImageChunk) {
+        if (isCancelled(progress))
+            return unchanged;
+
+        const QList<ImageIngest::Prepared> prepared = ImageIngest::prepareAll(pendingSources.mid(start, ImageChunk));
+        for (const ImageIngest::Prepared &image : prepared) {
+            if (!image.data.isEmpty()) {
+                normalizedHashes.insert(image.sourcePath, QString::fromLatin1(
+                    QCryptographicHash::hash(image.data, QCryptographicHash::Sha256).toHex()));
+            }
+        }
+    }
+
+    for (const Pending &row : std::as_const(pending)) {
+        if (normalizedHashes.value(row.source) == row.blobHash)
+            unchanged.insert(row.designNo);
+    }
+    return unchanged;
+}
+
+void CatalogImporter::diffRows(QList<CatalogImportPlanRow> &rows, const QHash<QString, ExistingDesign> &existing,
+                               const QSet<QString> &sameImage)
+{
+    for (CatalogImportPlanRow &plan : rows) {
+        if (!plan.problems.isEmpty()) {
+            plan.action = CatalogImportPlanRow::Skip;
+            continue;
+        }
+
+        const CatalogImportRow &row = plan.row;
+        const auto it = existing.constFind(row.designNo);
+        if (it == existing.constEnd()) {
+            plan.action = CatalogImportPlanRow::Insert;
+            continue;
+        }
+
+        // The sheet names the source file while image_data holds the stored copy; the same
+        // picture keeps the stored copy and is not brought into the store again
+        if (sameImage.contains(row.designNo))
+            plan.row.imagePath = it->imagePath;
+        else if (row.imagePath != it->imagePath)
+            plan.changes << "image";
+        if (row.imageType != it->imageType) plan.changes << "type";
+        if (row.companyName != it->companyName) plan.changes << "company";
+        if (row.note != it->note) plan.changes << "note";
+        if (!sameJson(it->goldJson, goldArray(row))) plan.changes << "gold";
+        if (!sameJson(it->diamondJson, piecesArray(row.diamonds))) plan.changes << "diamond";
+        if (!sameJson(it->stoneJson, piecesArray(row.stones))) plan.changes << "stone";
+
+        if (plan.changes.isEmpty()) {
+            plan.action = CatalogImportPlanRow::Skip;
+            plan.problems << "No changes";
+        } else {
+            plan.action = CatalogImportPlanRow::Update;
+        }
+    }
+}
+
+CatalogImportPlan CatalogImporter::plan(const QString &filePath, Progress *progress)
+{
+    CatalogImportPlan result;
+    result.filePath = filePath;
+
+    const QList<CatalogImportRow> sheetRows = readWorkbook(filePath, &result.error);
+    if (!result.error.isEmpty()) {
+        qWarning() << "[WARNING]" << result.error;
+        return result;
+    }
+
+    if (progress) {
+        progress->stage.store(Checking);
+        progress->total.store(sheetRows.size());
+    }
+
+    // A design listed more than once is taken from its last row
+    QHash<QString, int> lastRow;
+    for (const CatalogImportRow &row : sheetRows)
+        lastRow.insert(row.designNo, row.sheetRow);
+
+    result.rows.reserve(sheetRows.size());
+    QStringList designNos;
+    designNos.reserve(lastRow.size());
+    for (const CatalogImportRow &row : sheetRows) {
+        CatalogImportPlanRow plan;
+        plan.row = row;
+        const int used = lastRow.value(row.designNo);
+        if (used != row.sheetRow)
+            plan.problems << QString("Duplicate design no.; row %1 is used").arg(used);
+        else
+            designNos.append(row.designNo);
+        result.rows.append(plan);
+    }
+
+    checkRows(result.rows);
+    if (isCancelled(progress)) {
+        result.cancelled = true;
+        return result;
+    }
+
+    bool lookedUp = false;
+    const QHash<QString, ExistingDesign> existing = existingDesigns(designNos, &lookedUp);
+    if (!lookedUp) {
+        result.error = "Could not check which designs already exist";
+        return result;
+    }
+    diffRows(result.rows, existing, unchangedImages(result.rows, existing, progress));
+    if (isCancelled(progress)) {
+        result.cancelled = true;
+        return result;
+    }
+
+    for (const CatalogImportPlanRow &plan : std::as_const(result.rows)) {
+        switch (plan.action) {
+        case CatalogImportPlanRow::Insert: ++result.inserts; break;
+        case CatalogImportPlanRow::Update: ++result.updates; break;
+        case CatalogImportPlanRow::Skip:   ++result.skips; break;
+        }
+    }
+    if (progress)
+        progress->done.store(sheetRows.size());
+
+    return result;
+}
+
+QHash<QString, QString> CatalogImporter::storeImages(const QList<CatalogImportPlanRow> &rows,
+                                                     CatalogImportSummary &summary, Progress *progress)
+{
+    // Distinct source files; designs sharing a photo share its blob
+    QStringList sources;
+    QSet<QString> seen;
+    for (const CatalogImportPlanRow &plan : rows) {
+        const QString &source = plan.row.imagePath;
+        if (ImageStore::isStorePath(source) || seen.contains(source))
+            continue;
+        seen.insert(source);
+        sources.append(source);
+    }
+
+    if (progress) {
+        progress->stage.store(Images);
+        progress->done.store(0);
+        progress->total.store(sources.size());
+    }
+
+    QHash<QString, QString> stored;
+    for (int start = 0; start < sources.size(); start += ImageChunk) {
+        if (isCancelled(progress))
+            return stored;
+
+        // Decode/encode in parallel; store writes stay on this thread and its connection
+        const QList<ImageIngest::Prepared> prepared = ImageIngest::prepareAll(sources.mid(start, ImageChunk));
+        for (const ImageIngest::Prepared &image : prepared) {
+            const QString storePath = ImageIngest::store(image);
+            if (storePath.isEmpty()) {
+                qWarning() << "[WARNING] Image not imported, keeping path:" << image.sourcePath;
+                ++summary.imagesMissing;
+                continue;
+            }
+            stored.insert(image.sourcePath, storePath);
+            ++summary.imagesStored;
+        }
+
+        if (progress)
+            progress->done.store(qMin(start + ImageChunk, int(sources.size())));
+    }
+
+    return stored;
+}
+
+void CatalogImporter::writeRows(const QList<CatalogImportPlanRow> &rows, const QHash<QString, QString> &storedImages,
+                                CatalogImportSummary &summary, Progress *progress)
+{
+    if (progress) {
+        progress->stage.store(Writing);
+        progress->done.store(0);
+        progress->total.store(rows.size());
+    }
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        summary.error = "Could not open the image database: " + db.lastError().text();
+        return;
+    }
+
+    // The reviewed plan is applied as a whole or not at all
+    if (!db.transaction()) {
+        summary.error = "Could not start a transaction: " + db.lastError().text();
+        return;
+    }
+
+    const QString time = QDateTime::currentDateTime().toString(Qt::ISODate);
+    int inserted = 0;
+    int updated = 0;
+    QString failure;
+    {
+        PooledQuery insert = ConnectionPool::instance().prepare(db, R"(
+            INSERT INTO image_data
+            (image_path, image_type, design_no, company_name, gold_weight, diamond, stone, time, note)
+            VALUES (:image_path, :image_type, :design_no, :company_name, :gold_weight, :diamond, :stone, :time, :note)
+        )");
+        PooledQuery update = ConnectionPool::instance().prepare(db, R"(
+            UPDATE image_data
+            SET image_path = :image_path,
+                image_type = :image_type,
+                company_name = :company_name,
+                gold_weight = :gold_weight,
+                diamond = :diamond,
+                stone = :stone,
+                note = :note,
+                time = :time
+            WHERE design_no = :design_no
+        )");
+
+        for (int i = 0; i < rows.size() && failure.isEmpty(); ++i) {
+            if (i % 500 == 0) {
+                if (isCancelled(progress)) {
+                    summary.cancelled = true;
+                    break;
+                }
+                if (progress)
+                    progress->done.store(i);
+            }
+
+            const CatalogImportPlanRow &plan = rows[i];
+            const CatalogImportRow &row = plan.row;
+            const bool isUpdate = plan.action == CatalogImportPlanRow::Update;
+            QSqlQuery &query = isUpdate ? update.query() : insert.query();
+
+            query.bindValue(":image_path", storedImages.value(row.imagePath, row.imagePath));
+            query.bindValue(":image_type", row.imageType);
+            query.bindValue(":design_no", row.designNo);
+            query.bindValue(":company_name", row.companyName);
+            query.bindValue(":gold_weight", compactJson(goldArray(row)));
+            query.bindValue(":diamond", compactJson(piecesArray(row.diamonds)));
+            query.bindValue(":stone", compactJson(piecesArray(row.stones)));
+            query.bindValue(":time", time);
+            query.bindValue(":note", row.note);
+
+            if (!query.exec()) {
+                failure = QString("Row %1 (design %2): %3").arg(row.sheetRow).arg(row.designNo, query.lastError().text());
+                break;
+            }
+            ++(isUpdate ? updated : inserted);
+        }
+    } // statements reset before commit
+
+    // Last chance to honour a cancel; once COMMIT starts the import is reported as done
+    if (failure.isEmpty() && !summary.cancelled && isCancelled(progress))
+        summary.cancelled = true;
+
+    if (summary.cancelled) {
+        db.rollback();
+        qDebug() << "Bulk import cancelled and rolled back";
+        return;
+    }
+
+    if (failure.isEmpty() && db.commit()) {
+        summary.inserted = inserted;
+        summary.updated = updated;
+        if (progress)
+            progress->done.store(rows.size());
+        return;
+    }
+
+    if (failure.isEmpty())
+        failure = "Commit failed: " + db.lastError().text();
+    db.rollback();
+    qWarning() << "[ERROR] Bulk import rolled back:" << failure;
+    summary.error = failure;
+    summary.failed = rows.size();
+}
+
+CatalogImportSummary CatalogImporter::commit(const CatalogImportPlan &importPlan, Progress *progress)
+{
+    CatalogImportSummary summary;
+    if (!importPlan.error.isEmpty()) {
+        summary.error = importPlan.error;
+        return summary;
+    }
+
+    QList<CatalogImportPlanRow> accepted;
+    accepted.reserve(importPlan.inserts + importPlan.updates);
+    for (const CatalogImportPlanRow &plan : importPlan.rows) {
+        if (plan.action != CatalogImportPlanRow::Skip)
+            accepted.append(plan);
+    }
+    summary.rows = accepted.size();
+
+    const QHash<QString, QString> storedImages = storeImages(accepted, summary, progress);
+    if (isCancelled(progress)) {
+        summary.cancelled = true;
+        return summary;
+    }
+
+    // cancelled is set by writeRows only when it rolled back
+    writeRows(accepted, storedImages, summary, progress);
+    summary.ok = summary.error.isEmpty() && !summary.cancelled;
+    return summary;
+}
@@ -0,0 +1,113 @@
+#ifndef CATALOGIMPORT_H
+#define CATALOGIMPORT_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <atomic>
+#include <memory>
+
+#include "commontypes.h"
+#include "dbexecutor.h"
+
+// Excel bulk import of catalog designs (Add_Catalog, Add_Diamond, Add_Stone sheets).
+// An import is a dry run followed by a commit. plan() reads each sheet in one pass and
+// checks every row without writing: duplicate design numbers, karat and weight ranges,
+// diamond/stone shape and size against the reference tables, and image files. It compares
+// against image_data with set-based lookups and returns an insert/update/skip plan for
+// review. commit() brings the images of the accepted rows into the store in parallel
+// chunks and applies the plan in a single transaction. startPlan()/startCommit() run the
+// two steps on a database worker and report progress on the owner's thread; a cancelled
+// step is reported by the worker once it has stopped, so nothing is still being written.
+class CatalogImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Stage {
+        Reading,
+        Checking,
+        Images,
+        Writing,
+    };
+
+    // Shared between the worker and the owner; the worker writes the counters, a timer reads
+    // them, and cancel() raises cancelRequested for the worker to act on
+    struct Progress {
+        std::atomic_int stage{Reading};
+        std::atomic_int done{0};
+        std::atomic_int total{0};
+        std::atomic_bool cancelRequested{false};
+    };
+
+    explicit CatalogImporter(QObject *parent = nullptr);
+
+    void startPlan(const QString &filePath);
+    void startCommit(const CatalogImportPlan &plan);
+    void cancel();
+    bool isRunning() const { return running; }
+
+    static QString stageText(int stage);
+    static QString actionText(CatalogImportPlanRow::Action action);
+
+    // The two steps themselves; any thread with its own pooled connections. progress may
+    // be null. Both stop early when the calling DbExecutor request or progress is cancelled.
+    static CatalogImportPlan plan(const QString &filePath, Progress *progress = nullptr);
+    static CatalogImportSummary commit(const CatalogImportPlan &plan, Progress *progress = nullptr);
+
+    // Sheet parsing only; every Add_Catalog row is returned, duplicates included.
+    // error is set when the workbook cannot be used at all.
+    static QList<CatalogImportRow> readWorkbook(const QString &filePath, QString *error);
+
+signals:
+    void progressChanged(int stage, int done, int total);
+    void planned(const CatalogImportPlan &plan);
+    void finished(const CatalogImportSummary &summary);
+
+private:
+    static constexpr int ImageChunk = 32;     // decoded images held in memory at once
+
+    static bool isCancelled(const Progress *progress);
+
+    // Current image_data values of a design, for the update diff
+    struct ExistingDesign {
+        QString imagePath;
+        QString imageType;
+        QString companyName;
+        QString goldJson;
+        QString diamondJson;
+        QString stoneJson;
+        QString note;
+    };
+
+    // Rows of image_data for designNos; ok is false when a lookup failed
+    static QHash<QString, ExistingDesign> existingDesigns(const QStringList &designNos, bool *ok);
+
+    static void checkRows(QList<CatalogImportPlanRow> &rows);
+    // Design numbers whose sheet image has the same content as the blob image_data holds:
+    // the file itself, the original a blob was normalized from, or the same normalized bytes
+    static QSet<QString> unchangedImages(const QList<CatalogImportPlanRow> &rows,
+                                         const QHash<QString, ExistingDesign> &existing, Progress *progress);
+    static void diffRows(QList<CatalogImportPlanRow> &rows, const QHash<QString, ExistingDesign> &existing,
+                         const QSet<QString> &sameImage);
+
+    static QHash<QString, QString> storeImages(const QList<CatalogImportPlanRow> &rows,
+                                               CatalogImportSummary &summary, Progress *progress);
+    static void writeRows(const QList<CatalogImportPlanRow> &rows, const QHash<QString, QString> &storedImages,
+                          CatalogImportSummary &summary, Progress *progress);
+
+    void startTask();
+    void finishTask();
+
+    std::shared_ptr<Progress> progress;
+    QTimer *progressTimer;
+    DbRequest request;
+    bool running = false;
+};
+
+#endif // CATALOGIMPORT_H
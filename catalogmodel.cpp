@@ -0,0 +1,224 @@
+#include <QCoreApplication>
+#include <QDir>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "catalogmodel.h"
+#include "catalogsearch.h"
+#include "databaseutils.h"
+#include "thumbnailcache.h"
+
+CatalogListModel::CatalogListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    decoders.setMaxThreadCount(2);
+    icons.setMaxCost(IconCacheSize);
+
+    placeholder = QPixmap(":/icon/no_image_1.png").scaled(IconEdge, IconEdge, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+CatalogListModel::~CatalogListModel()
+{
+    generation->fetch_add(1);
+    decoders.clear();
+    decoders.waitForDone();
+}
+
+int CatalogListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+QVariant CatalogListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size())
+        return QVariant();
+
+    const CatalogHeader &header = rows[index.row()];
+    switch (role) {
+    case Qt::DisplayRole: {
+        const QString company = header.companyName.left(25) + (header.companyName.size() > 25 ? "…" : "");
+        return header.designNo + "\n" + company;
+    }
+    case Qt::DecorationRole: {
+        // Only asked for items being painted; everything else never gets decoded
+        const QString path = resolvePath(header.imagePath);
+        if (const QPixmap *icon = icons.object(path))
+            return *icon;
+        const_cast<CatalogListModel *>(this)->requestIcon(index.row(), path);
+        return placeholder;
+    }
+    case Qt::ToolTipRole:
+        return header.designNo + "\n" + header.companyName;
+    case DesignNoRole:
+        return header.designNo;
+    case CompanyRole:
+        return header.companyName;
+    case ImagePathRole:
+        return resolvePath(header.imagePath);
+    case ImageIdRole:
+        return header.imageId;
+    default:
+        return QVariant();
+    }
+}
+
+bool CatalogListModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+    if (parent.isValid() || row < 0 || count <= 0 || row + count > rows.size())
+        return false;
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    rows.erase(rows.begin() + row, rows.begin() + row + count);
+    endRemoveRows();
+    return true;
+}
+
+bool CatalogListModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !pageLoading && nextAfterId >= 0;
+}
+
+void CatalogListModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent))
+        return;
+
+    pageLoading = true;
+    const int afterId = nextAfterId;
+    rowsRequest = DbExecutor::instance().submit(this, [afterId]() {
+        return DatabaseUtils::fetchCatalogPage(afterId, PageSize);
+    }, [this](const CatalogPage &page) {
+        onPageLoaded(page);
+    });
+}
+
+void CatalogListModel::reload()
+{
+    resetRows({}, 0);
+    fetchMore(QModelIndex());
+}
+
+void CatalogListModel::setFilterText(const QString &text)
+{
+    const QString trimmed = text.trimmed();
+    if (trimmed.isEmpty()) {
+        reload();
+        return;
+    }
+
+    // A search result is one ranked list; nothing to page through
+    resetRows({}, -1);
+    CatalogSearchQuery query;
+    query.text = trimmed;
+    query.limit = SearchLimit;
+    rowsRequest = DbExecutor::instance().submit(this, [query]() {
+        // Ranked matches first, then design numbers that only contain the text ("02" in "MM-102")
+        QList<CatalogHeader> found = CatalogSearch::run(query).rows;
+        found += CatalogSearch::designNoContaining(query.text, query.limit - found.size(), found);
+        return found;
+    }, [this](const QList<CatalogHeader> &found) {
+        resetRows(found, -1);
+    });
+}
+
+void CatalogListModel::resetRows(const QList<CatalogHeader> &newRows, int newNextAfterId)
+{
+    rowsRequest.cancel();
+    generation->fetch_add(1);
+    pendingIcons.clear();
+
+    beginResetModel();
+    rows = newRows;
+    nextAfterId = newNextAfterId;
+    pageLoading = false;
+    endResetModel();
+}
+
+void CatalogListModel::onPageLoaded(const CatalogPage &page)
+{
+    pageLoading = false;
+    nextAfterId = page.nextAfterId;
+    if (page.rows.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), rows.size(), rows.size() + page.rows.size() - 1);
+    rows += page.rows;
+    endInsertRows();
+}
+
+void CatalogListModel::requestIcon(int row, const QString &path)
+{
+    // Designs sharing a stored image decode it once; every row asking is told when it is ready
+    const auto pending = pendingIcons.find(path);
+    if (pending != pendingIcons.end()) {
+        pending->insert(rows[row].imageId, row);
+        return;
+    }
+    pendingIcons[path].insert(rows[row].imageId, row);
+
+    const int requestGeneration = generation->load();
+    const auto generationFlag = generation;
+
+    auto *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, path, requestGeneration]() {
+        watcher->deleteLater();
+        if (requestGeneration != generation->load())
+            return; // rows were replaced meanwhile
+        onIconDecoded(path, watcher->result());
+    });
+
+    watcher->setFuture(QtConcurrent::run(&decoders, [=]() -> QImage {
+        if (requestGeneration != generationFlag->load())
+            return QImage();
+        return ThumbnailCache::instance().image(path, IconEdge);
+    }));
+}
+
+void CatalogListModel::onIconDecoded(const QString &path, const QImage &image)
+{
+    const QHash<int, int> waiting = pendingIcons.take(path);
+
+    // Missing or unreadable files keep the placeholder instead of being retried on every paint
+    icons.insert(path, new QPixmap(image.isNull() ? placeholder : QPixmap::fromImage(image)));
+
+    for (auto it = waiting.cbegin(); it != waiting.cend(); ++it) {
+        const int imageId = it.key();
+        int row = it.value();
+
+        // Rows may have shifted since the request (deletes); find the item by id
+        if (row >= rows.size() || rows[row].imageId != imageId) {
+            row = -1;
+            for (int i = 0; i < rows.size(); ++i) {
+                if (rows[i].imageId == imageId) {
+                    row = i;
+                    break;
+                }
+            }
+            if (row < 0)
+                continue;
+        }
+
+        const QModelIndex changed = index(row);
+        emit dataChanged(changed, changed, {Qt::DecorationRole});
+    }
+}
+
+QString CatalogListModel::resolvePath(const QString &imagePath)
+{
+    return QDir(QCoreApplication::applicationDirPath()).filePath(imagePath);
+}
+
+QSize CatalogItemDelegate::sizeHint(const QStyleOptionViewItem &, const QModelIndex &) const
+{
+    return QSize(160, 160);
+}
+
+void CatalogItemDelegate::initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const
+{
+    QStyledItemDelegate::initStyleOption(option, index);
+    option->decorationPosition = QStyleOptionViewItem::Top;
+    option->decorationAlignment = Qt::AlignHCenter;
+    option->displayAlignment = Qt::AlignHCenter | Qt::AlignTop;
+    option->decorationSize = QSize(80, 80);
+}
@@ -0,0 +1,92 @@
+#ifndef CATALOGMODEL_H
+#define CATALOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <QHash>
+#include <QPixmap>
+#include <QStyledItemDelegate>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+
+#include "commontypes.h"
+#include "dbexecutor.h"
+
+// Live catalog designs for the AddCatalog modify/delete grid.
+// Rows arrive in keyset pages through fetchMore() as the view scrolls, and thumbnails are
+// decoded on worker threads only when the view asks for an index's icon, i.e. for the
+// items on screen. Decoded icons live in a bounded cache and are reused when an item
+// scrolls back into view, so opening the grid costs one page and one screen of icons
+// however large the catalog is.
+class CatalogListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        DesignNoRole = Qt::UserRole,
+        CompanyRole,
+        ImagePathRole,
+        ImageIdRole,
+    };
+
+    explicit CatalogListModel(QObject *parent = nullptr);
+    ~CatalogListModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // Drops the loaded rows and starts again from the first page
+    void reload();
+
+    // Shows the designs matching text (catalog search, best match first, then any design
+    // number containing text); empty text returns to paged browsing
+    void setFilterText(const QString &text);
+
+private:
+    static constexpr int PageSize = 200;
+    static constexpr int SearchLimit = 500;
+    static constexpr int IconEdge = 80;
+    static constexpr int IconCacheSize = 512;   // icons kept for items scrolled out of view
+
+    void resetRows(const QList<CatalogHeader> &newRows, int newNextAfterId);
+    void onPageLoaded(const CatalogPage &page);
+    void requestIcon(int row, const QString &path);
+    void onIconDecoded(const QString &path, const QImage &image);
+    static QString resolvePath(const QString &imagePath);
+
+    QList<CatalogHeader> rows;
+    int nextAfterId = 0;          // -1 once every page is loaded, or while filtered
+    bool pageLoading = false;
+    DbRequest rowsRequest;
+
+    QThreadPool decoders;
+    QCache<QString, QPixmap> icons;
+    QHash<QString, QHash<int, int>> pendingIcons;   // path -> image id -> row of each item waiting for it
+    QPixmap placeholder;
+    // Bumped by resets; icons decoded for an older row list are still cached but not announced
+    std::shared_ptr<std::atomic_int> generation = std::make_shared<std::atomic_int>(0);
+};
+
+// Fixed-size cell for the catalog grid: icon above design number and company.
+// A constant size hint lets the view lay out any number of rows without measuring them.
+class CatalogItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+protected:
+    void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
+};
+
+#endif // CATALOGMODEL_H
@@ -0,0 +1,189 @@
+#include <QDebug>
+#include <QRegularExpression>
+#include <QSet>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "catalogsearch.h"
+#include "connectionpool.h"
+
+namespace {
+// bm25 column weights: design_no, company_name, image_type, note
+const char *const RankExpression = "bm25(catalog_fts, 10.0, 4.0, 2.0, 1.0)";
+}
+
+QString CatalogSearch::matchExpression(const QString &text)
+{
+    // Each word becomes a quoted prefix phrase, so punctuation in design numbers ("MM-102")
+    // is tokenized like the indexed text and never parsed as FTS5 syntax
+    static const QRegularExpression whitespace("\\s+");
+    QStringList terms;
+    for (const QString &word : text.split(whitespace, Qt::SkipEmptyParts)) {
+        QString escaped = word;
+        escaped.replace('"', "\"\"");
+        terms << QStringLiteral("\"%1\"*").arg(escaped);
+    }
+    return terms.join(' ');
+}
+
+QString CatalogSearch::filterSql(const CatalogSearchQuery &query, bool hasText)
+{
+    QStringList conditions = {"COALESCE(d.\"delete\", 0) = 0"};
+    if (hasText)
+        conditions << "d.image_id IN (SELECT rowid FROM catalog_fts WHERE catalog_fts MATCH :match)";
+    if (!query.goldKarat.isEmpty())
+        conditions << "d.image_id IN (SELECT image_id FROM catalog_gold WHERE karat = :karat)";
+    if (!query.diamondShape.isEmpty()) {
+        conditions << (query.diamondSize.isEmpty()
+                           ? "d.image_id IN (SELECT image_id FROM catalog_diamond WHERE type = :shape)"
+                           : "d.image_id IN (SELECT image_id FROM catalog_diamond WHERE type = :shape AND size_mm = :size)");
+    }
+    if (!query.stoneType.isEmpty())
+        conditions << "d.image_id IN (SELECT image_id FROM catalog_stone WHERE type = :stoneType)";
+    return conditions.join(" AND ");
+}
+
+void CatalogSearch::bindFilters(QSqlQuery &sqlQuery, const CatalogSearchQuery &query, const QString &match)
+{
+    if (!match.isEmpty())
+        sqlQuery.bindValue(":match", match);
+    if (!query.goldKarat.isEmpty())
+        sqlQuery.bindValue(":karat", query.goldKarat);
+    if (!query.diamondShape.isEmpty()) {
+        sqlQuery.bindValue(":shape", query.diamondShape);
+        if (!query.diamondSize.isEmpty())
+            sqlQuery.bindValue(":size", query.diamondSize);
+    }
+    if (!query.stoneType.isEmpty())
+        sqlQuery.bindValue(":stoneType", query.stoneType);
+}
+
+CatalogSearchResult CatalogSearch::run(const CatalogSearchQuery &query)
+{
+    CatalogSearchResult result;
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in CatalogSearch:" << db.lastError().text();
+        return result;
+    }
+
+    const QString match = matchExpression(query.text);
+    const bool hasText = !match.isEmpty();
+
+    // With text, rank by relevance from the FTS side; without, list in catalog order
+    const QString sql = hasText
+        ? QString(R"(
+            SELECT d.image_id, d.design_no, d.image_path, d.company_name
+            FROM catalog_fts f JOIN image_data d ON d.image_id = f.rowid
+            WHERE catalog_fts MATCH :match AND %1
+            ORDER BY %2
+            LIMIT :limit
+        )").arg(filterSql(query, false), RankExpression)
+        : QString(R"(
+            SELECT d.image_id, d.design_no, d.image_path, d.company_name
+            FROM image_data d
+            WHERE %1
+            ORDER BY d.image_id
+            LIMIT :limit
+        )").arg(filterSql(query, false));
+
+    {
+        PooledQuery rows = ConnectionPool::instance().prepare(db, sql);
+        bindFilters(rows.query(), query, match);
+        rows->bindValue(":limit", qMax(1, query.limit));
+
+        if (!rows->exec()) {
+            qWarning() << "[ERROR] Catalog search failed:" << rows->lastError().text();
+            return result;
+        }
+        while (rows->next()) {
+            CatalogHeader header;
+            header.imageId = rows->value(0).toInt();
+            header.designNo = rows->value(1).toString();
+            header.imagePath = rows->value(2).toString();
+            header.companyName = rows->value(3).toString();
+            result.rows.append(header);
+        }
+    }
+
+    result.facets.goldKarats = facetCounts(db, "catalog_gold", "karat", query, match);
+    result.facets.diamondShapes = facetCounts(db, "catalog_diamond", "type", query, match);
+    result.facets.stoneTypes = facetCounts(db, "catalog_stone", "type", query, match);
+
+    return result;
+}
+
+QList<CatalogHeader> CatalogSearch::designNoContaining(const QString &text, int limit,
+                                                      const QList<CatalogHeader> &found)
+{
+    QList<CatalogHeader> headers;
+    const QString trimmed = text.trimmed();
+    if (trimmed.isEmpty() || limit <= 0)
+        return headers;
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in CatalogSearch:" << db.lastError().text();
+        return headers;
+    }
+
+    QSet<int> skip;
+    for (const CatalogHeader &header : found)
+        skip.insert(header.imageId);
+
+    QString pattern = trimmed;
+    pattern.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+
+    PooledQuery rows = ConnectionPool::instance().prepare(db, R"(
+        SELECT image_id, design_no, image_path, company_name
+        FROM image_data
+        WHERE COALESCE("delete", 0) = 0 AND design_no LIKE :pattern ESCAPE '\'
+        ORDER BY image_id
+        LIMIT :limit
+    )");
+    rows->bindValue(":pattern", "%" + pattern + "%");
+    rows->bindValue(":limit", limit + skip.size());
+
+    if (!rows->exec()) {
+        qWarning() << "[ERROR] Design number search failed:" << rows->lastError().text();
+        return headers;
+    }
+    while (rows->next() && headers.size() < limit) {
+        CatalogHeader header;
+        header.imageId = rows->value(0).toInt();
+        if (skip.contains(header.imageId))
+            continue;
+        header.designNo = rows->value(1).toString();
+        header.imagePath = rows->value(2).toString();
+        header.companyName = rows->value(3).toString();
+        headers.append(header);
+    }
+    return headers;
+}
+
+QList<CatalogFacetCount> CatalogSearch::facetCounts(QSqlDatabase &db, const QString &table, const QString &column,
+                                                    const CatalogSearchQuery &query, const QString &match)
+{
+    QList<CatalogFacetCount> counts;
+
+    const QString sql = QString(R"(
+        SELECT c.%2, COUNT(DISTINCT c.image_id)
+        FROM %1 c JOIN image_data d ON d.image_id = c.image_id
+        WHERE c.%2 <> '' AND %3
+        GROUP BY c.%2
+        ORDER BY 2 DESC, 1
+    )").arg(table, column, filterSql(query, !match.isEmpty()));
+
+    PooledQuery facet = ConnectionPool::instance().prepare(db, sql);
+    bindFilters(facet.query(), query, match);
+
+    if (!facet->exec()) {
+        qWarning() << "[ERROR] Facet count on" << table << "failed:" << facet->lastError().text();
+        return counts;
+    }
+    while (facet->next())
+        counts.append({facet->value(0).toString(), facet->value(1).toInt()});
+
+    return counts;
+}
@@ -0,0 +1,38 @@
+#ifndef CATALOGSEARCH_H
+#define CATALOGSEARCH_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+#include "commontypes.h"
+
+// Ranked, faceted search over image_data.
+// Text goes through the catalog_fts FTS5 index (bm25, design number weighted highest);
+// facet filters and counts come from the catalog_gold / catalog_diamond / catalog_stone
+// child tables. Rows flagged "delete" are never returned. Runs on any thread with a pooled
+// connection, so callers normally submit it to DbExecutor.
+class CatalogSearch
+{
+public:
+    static CatalogSearchResult run(const CatalogSearchQuery &query);
+
+    // FTS5 MATCH expression for user input: every word must match as a prefix.
+    // Empty when the input has no searchable text.
+    static QString matchExpression(const QString &text);
+
+    // Live designs whose design number contains text anywhere (case-insensitive), in catalog
+    // order and without the rows already in found; for inputs such as "02" that FTS prefix
+    // matching cannot find inside "MM-102"
+    static QList<CatalogHeader> designNoContaining(const QString &text, int limit,
+                                                   const QList<CatalogHeader> &found = {});
+
+private:
+    // "image_id IN (...)" filter shared by the result and facet queries
+    static QString filterSql(const CatalogSearchQuery &query, bool hasText);
+    static void bindFilters(QSqlQuery &sqlQuery, const CatalogSearchQuery &query, const QString &match);
+    static QList<CatalogFacetCount> facetCounts(QSqlDatabase &db, const QString &table, const QString &column,
+                                                const CatalogSearchQuery &query, const QString &match);
+};
+
+#endif // CATALOGSEARCH_H
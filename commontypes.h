@@ -1,7 +1,10 @@
 #ifndef COMMONTYPES_H
 #define COMMONTYPES_H
 
+#include <QList>
+#include <QMap>
 #include <QString>
+#include <QStringList>
 
 // Struct to hold selection data for cart items
 struct SelectionData {
@@ -136,6 +139,219 @@ struct StoneData {
     QString sizeMM;
 };
 
+// Reference-table key for one entry of an image_data diamond/stone JSON array
+struct WeightKey {
+    bool isDiamond = true;
+    QString shape;        // "Round" selects Round_diamond
+    QString sizeMM;       // as written; fancy and stone sizes may be text such as "4x6"
+};
+
+// One row of the OrderList table (OrderBook-Detail joined with Order-Status)
+struct OrderListRow {
+    QString sellerId;
+    QString partyId;
+    QString jobNo;
+    QString manager;
+    QString designer;
+    QString manufacturer;
+    QString accountant;
+    QString orderDate;
+    QString deliveryDate;
+    QString imagePath;
+    QString orderApprove;
+    QString designApprove;
+    QString qualityApprove;
+    QString orderNote;
+    QString designNote;
+    QString qualityNote;
+};
+
+struct JewelryMenuItem {
+    int id = 0;
+    int parentId = -1;   // -1 for top-level categories
+    QString name;
+    QString displayText;
+};
+
+// Admin user list: one row per user with their most recent PDF
+struct UserSummary {
+    QString userId;
+    QString companyName;
+    QString lastPdfPath;
+};
+
+// Catalog row for browsing; the JSON details are read per record when it is shown
+struct CatalogHeader {
+    int imageId = 0;
+    QString designNo;
+    QString imagePath;
+    QString companyName;
+};
+
+// One page of a keyset scan over image_data ordered by image_id
+struct CatalogPage {
+    QList<CatalogHeader> rows;
+    int nextAfterId = -1;   // afterImageId for the next page, -1 after the last page
+};
+
+// Catalog search: free text plus optional facet filters (empty = any)
+struct CatalogSearchQuery {
+    QString text;           // matched as prefixes against design no, company, type and note
+    QString goldKarat;
+    QString diamondShape;
+    QString diamondSize;
+    QString stoneType;
+    int limit = 100;
+};
+
+struct CatalogFacetCount {
+    QString value;
+    int count = 0;          // matching designs with this value
+};
+
+struct CatalogFacets {
+    QList<CatalogFacetCount> goldKarats;
+    QList<CatalogFacetCount> diamondShapes;
+    QList<CatalogFacetCount> stoneTypes;
+};
+
+struct CatalogSearchResult {
+    QList<CatalogHeader> rows;   // best match first
+    CatalogFacets facets;        // counts over every match, not just rows
+};
+
+// One design read from an Add_Catalog workbook, with its Add_Diamond / Add_Stone rows
+struct CatalogImportRow {
+    int sheetRow = 0;            // Add_Catalog row, for messages
+    QString designNo;
+    QString imageType;
+    QString companyName;
+    int goldKarat = 0;
+    double goldWeight = 0.0;
+    QString imagePath;           // as written in the sheet until the image is stored
+    QString note;
+    QList<StoneData> diamonds;
+    QList<StoneData> stones;
+};
 
+// What an import would do with one design, decided by the dry run
+struct CatalogImportPlanRow {
+    enum Action { Insert, Update, Skip };
+
+    CatalogImportRow row;
+    Action action = Skip;
+    QStringList problems;        // why the row is skipped
+    QStringList changes;         // fields an update changes
+};
+
+// Dry-run result: nothing has been written; committing applies the Insert/Update rows
+struct CatalogImportPlan {
+    QString filePath;
+    QString error;               // the workbook could not be checked at all
+    bool cancelled = false;      // the dry run stopped early; rows are incomplete
+    QList<CatalogImportPlanRow> rows;   // sheet order
+    int inserts = 0;
+    int updates = 0;
+    int skips = 0;
+};
+
+struct CatalogImportSummary {
+    bool ok = false;
+    bool cancelled = false;
+    QString error;               // why nothing was imported
+    int rows = 0;
+    int inserted = 0;
+    int updated = 0;
+    int failed = 0;
+    int imagesStored = 0;
+    int imagesMissing = 0;       // kept the sheet's path
+};
+
+// One row of catalog_diamond / catalog_stone (an entry of the diamond/stone JSON)
+struct CatalogPiece {
+    int imageId = 0;
+    QString type;
+    QString sizeMM;
+    int quantity = 0;
+};
+
+// One row of catalog_gold (an entry of the gold_weight JSON)
+struct CatalogGold {
+    int imageId = 0;
+    QString karat;
+    double weight = 0.0;
+};
+
+// One row of the jobsheet_movements ledger
+struct JobSheetMovement {
+    QString jobNo;
+    QString material;    // "gold", "diamond", "stone" or "other"
+    QString direction;   // "issue", "return", "broken" or "dust"
+    QString type;        // gold/solder/Dust/Product, or the diamond/stone type
+    QString size;
+    int pcs = 0;
+    double weight = 0.0;
+    QString ts;          // yyyy-MM-dd HH:mm:ss; empty for imported entries that had no date
+    QString user;
+};
+
+// SUM of the ledger per (material, direction) for one job
+struct JobSheetMovementTotal {
+    QString material;
+    QString direction;
+    int pcs = 0;
+    double weight = 0.0;
+    double productWeight = 0.0;  // part of weight with type "Product"
+};
+
+
+// One design of a cart PDF, with its image path and weights resolved up front
+struct CartPdfItem {
+    int imageId = 0;
+    QString imagePath;
+    QString goldType;
+    int itemCount = 0;
+    double goldWeight = 0.0;     // grams for all itemCount pieces
+    QString diamondJson;
+};
+
+// One (shape, size) row of a cart PDF's diamond or stone summary
+struct CartPdfPieceRow {
+    QString type;
+    QString sizeMM;
+    int quantity = 0;
+    double weight = 0.0;         // carats per piece
+    double totalWeight = 0.0;
+};
+
+// Everything a cart PDF shows, copied out of the cart so rendering needs no widgets
+struct CartPdfData {
+    QString pdfPath;
+    QString userId;
+    QString userName;
+    QString companyName;
+    QString mobileNo;
+    QList<CartPdfItem> items;
+    QMap<QString, double> goldByKarat;
+    QList<CartPdfPieceRow> diamonds;
+    QList<CartPdfPieceRow> stones;
+};
+
+// One job sheet to render; the sheet template is shared, these fill its value cells
+struct JobSheetPdfData {
+    QString pdfPath;
+    QString jobNo;
+    QString partyId;
+    QString orderDate;
+    QString deliveryDate;
+};
+
+struct PdfRenderResult {
+    QString pdfPath;
+    bool ok = false;
+    bool cancelled = false;
+    QString error;
+    int pages = 0;
+};
 
 #endif // COMMONTYPES_H
@@ -0,0 +1,234 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QThread>
+
+#include "connectionpool.h"
+#include "databasebootstrap.h"
+
+PooledQuery::PooledQuery(const QSqlQuery &query, const QSharedPointer<Entry> &entry)
+    : q(query), entry(entry)
+{
+}
+
+PooledQuery::PooledQuery(PooledQuery &&other) noexcept
+    : q(other.q), entry(std::move(other.entry))
+{
+    other.q = QSqlQuery(); // moved-from must not reset the shared statement
+}
+
+PooledQuery::~PooledQuery()
+{
+    q.finish(); // reset the statement so it releases its read lock
+    if (entry)
+        entry->inUse = false;
+}
+
+ConnectionPool &ConnectionPool::instance()
+{
+    static ConnectionPool pool;
+    return pool;
+}
+
+QString ConnectionPool::absolutePath(const QString &relativePath)
+{
+    return QDir(QCoreApplication::applicationDirPath()).filePath(relativePath);
+}
+
+QString ConnectionPool::connectionNameFor(const QString &dbPath, QThread *thread)
+{
+    return QStringLiteral("pool_%1_%2")
+        .arg(QFileInfo(dbPath).completeBaseName())
+        .arg(reinterpret_cast<quintptr>(thread), 0, 16);
+}
+
+QSqlDatabase ConnectionPool::acquire(const QString &relativePath)
+{
+    const QString dbPath = absolutePath(relativePath);
+    QThread *thread = QThread::currentThread();
+    const QString connName = connectionNameFor(dbPath, thread);
+
+    {
+        QMutexLocker locker(&mutex);
+        if (QSqlDatabase::contains(connName)) {
+            QSqlDatabase db = QSqlDatabase::database(connName, false);
+            if (db.isOpen()) {
+                ++counters.hits;
+                return db;
+            }
+        }
+        ++counters.misses;
+    }
+
+    QSqlDatabase db = QSqlDatabase::contains(connName)
+                          ? QSqlDatabase::database(connName, false)
+                          : QSqlDatabase::addDatabase("QSQLITE", connName);
+    db.setDatabaseName(dbPath);
+
+    QElapsedTimer timer;
+    timer.start();
+    const bool opened = db.open();
+    if (opened)
+        DatabaseBootstrap::configureConnection(db);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    QMutexLocker locker(&mutex);
+    counters.openTimeNs += elapsed;
+
+    if (!opened) {
+        ++counters.openFailures;
+        qWarning() << "[ERROR] ConnectionPool failed to open" << dbPath << ":" << db.lastError().text();
+        return db;
+    }
+
+    QStringList &threadConns = connectionsByThread[thread];
+    if (threadConns.isEmpty() && thread != QCoreApplication::instance()->thread()) {
+        // finished() is emitted from the worker itself, so the handles are closed on their own thread
+        QObject::connect(thread, &QThread::finished, thread, [this, thread]() {
+            releaseThread(thread);
+        }, Qt::DirectConnection);
+    }
+    if (!threadConns.contains(connName)) {
+        threadConns.append(connName);
+        ++counters.openConnections;
+    }
+
+    return db;
+}
+
+PooledQuery ConnectionPool::prepare(const QSqlDatabase &db, const QString &sql)
+{
+    const QString connName = db.connectionName();
+
+    {
+        QMutexLocker locker(&mutex);
+        auto &statements = statementsByConnection[connName];
+        const QSharedPointer<PooledQuery::Entry> cached = statements.value(sql);
+
+        // A statement still checked out (e.g. re-entrant use of the same SQL) gets a private copy
+        if (cached && !cached->inUse) {
+            ++counters.statementHits;
+            cached->inUse = true;
+            cached->lastUsed = ++statementClock;
+            return PooledQuery(cached->query, cached);
+        }
+        ++counters.statementMisses;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.prepare(sql)) {
+        qWarning() << "[ERROR] ConnectionPool failed to prepare statement:" << query.lastError().text()
+                   << "| SQL:" << sql;
+        return PooledQuery(query, {});
+    }
+
+    QMutexLocker locker(&mutex);
+    auto &statements = statementsByConnection[connName];
+    if (statements.contains(sql))
+        return PooledQuery(query, {});
+
+    if (statements.size() >= MaxStatementsPerConnection) {
+        // Make room by finalizing the least recently used statement not checked out
+        auto oldest = statements.end();
+        for (auto it = statements.begin(); it != statements.end(); ++it) {
+            if (!it.value()->inUse && (oldest == statements.end() || it.value()->lastUsed < oldest.value()->lastUsed))
+                oldest = it;
+        }
+        if (oldest == statements.end())
+            return PooledQuery(query, {});
+        statements.erase(oldest);
+        --counters.cachedStatements;
+        ++counters.statementEvictions;
+    }
+
+    auto entry = QSharedPointer<PooledQuery::Entry>::create();
+    entry->query = query;
+    entry->inUse = true;
+    entry->lastUsed = ++statementClock;
+    statements.insert(sql, entry);
+    ++counters.cachedStatements;
+    return PooledQuery(query, entry);
+}
+
+int ConnectionPool::inListSize(int count)
+{
+    for (int size : {8, 32, 128})
+        if (count <= size)
+            return size;
+    return MaxInListSize;
+}
+
+QString ConnectionPool::inListPlaceholders(int size)
+{
+    QString placeholders;
+    placeholders.reserve(size * 3);
+    for (int i = 0; i < size; ++i)
+        placeholders += i == 0 ? QStringLiteral("?") : QStringLiteral(", ?");
+    return placeholders;
+}
+
+void ConnectionPool::releaseCurrentThread()
+{
+    releaseThread(QThread::currentThread());
+}
+
+void ConnectionPool::releaseThread(QThread *thread)
+{
+    QStringList connNames;
+    {
+        QMutexLocker locker(&mutex);
+        connNames = connectionsByThread.take(thread);
+        counters.openConnections -= connNames.size();
+    }
+    closeConnections(connNames);
+}
+
+void ConnectionPool::closeAll()
+{
+    QStringList connNames;
+    {
+        QMutexLocker locker(&mutex);
+        for (const QStringList &names : std::as_const(connectionsByThread))
+            connNames += names;
+        connectionsByThread.clear();
+        counters.openConnections = 0;
+    }
+    closeConnections(connNames);
+}
+
+void ConnectionPool::closeConnections(const QStringList &connNames)
+{
+    for (const QString &name : connNames) {
+        {
+            // Cached statements must be finalized before their connection goes away
+            QMutexLocker locker(&mutex);
+            counters.cachedStatements -= statementsByConnection.take(name).size();
+        }
+        {
+            QSqlDatabase db = QSqlDatabase::database(name, false);
+            db.close();
+        } // handle destroyed before removal
+        QSqlDatabase::removeDatabase(name);
+    }
+}
+
+ConnectionPool::Stats ConnectionPool::stats() const
+{
+    QMutexLocker locker(&mutex);
+    return counters;
+}
+
+void ConnectionPool::resetStats()
+{
+    QMutexLocker locker(&mutex);
+    const int open = counters.openConnections;
+    const int cached = counters.cachedStatements;
+    counters = Stats();
+    counters.openConnections = open;
+    counters.cachedStatements = cached;
+}
@@ -0,0 +1,116 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+
+class QThread;
+
+// Database files used by the application, relative to the application directory
+namespace DbFile {
+inline const QString Image          = QStringLiteral("database/mega_mine_image.db");
+inline const QString OrderBook      = QStringLiteral("database/mega_mine_orderbook.db");
+inline const QString Authentication = QStringLiteral("database/luxeMineAuthentication.db");
+inline const QString Admin          = QStringLiteral("database/mega_mine.db");
+}
+
+// A compiled statement checked out of the pool's per-connection cache.
+// The statement is reset (not finalized) when this goes out of scope, so it never holds a
+// read lock between uses and the next prepare() of the same SQL text skips compilation.
+class PooledQuery
+{
+public:
+    PooledQuery(PooledQuery &&other) noexcept;
+    ~PooledQuery();
+    Q_DISABLE_COPY(PooledQuery)
+
+    QSqlQuery &query() { return q; }
+    QSqlQuery *operator->() { return &q; }
+    QSqlQuery &operator*() { return q; }
+
+private:
+    friend class ConnectionPool;
+    struct Entry {
+        QSqlQuery query;
+        bool inUse = false;
+        quint64 lastUsed = 0;   // pool clock at the last checkout, for LRU eviction
+    };
+
+    PooledQuery(const QSqlQuery &query, const QSharedPointer<Entry> &entry);
+
+    QSqlQuery q;
+    QSharedPointer<Entry> entry; // null when the statement is not cached
+};
+
+// Long-lived SQLite connections keyed by (database file, thread).
+// A QSqlDatabase may only be used from the thread that opened it, so each thread gets
+// its own handle per file. Handles stay open until their thread finishes or closeAll()
+// is called at shutdown; callers must never close() or removeDatabase() them.
+class ConnectionPool
+{
+public:
+    struct Stats {
+        quint64 hits = 0;          // acquire() served by an already-open handle
+        quint64 misses = 0;        // acquire() that had to open a handle
+        quint64 openFailures = 0;
+        qint64 openTimeNs = 0;     // total time spent in QSqlDatabase::open()
+        int openConnections = 0;
+        quint64 statementHits = 0;   // prepare() served by a cached statement
+        quint64 statementMisses = 0; // prepare() that compiled the SQL text
+        quint64 statementEvictions = 0; // least recently used statements dropped for new ones
+        int cachedStatements = 0;
+    };
+
+    static ConnectionPool &instance();
+
+    static QString absolutePath(const QString &relativePath);
+
+    // Returns the calling thread's open handle for the given file, opening it on first use.
+    // On failure the returned handle is not open and lastError() describes why.
+    QSqlDatabase acquire(const QString &relativePath);
+
+    // Returns a prepared statement for sql on db, reusing the compiled one cached for that
+    // connection. db must be a handle returned by acquire() on the calling thread.
+    // A full cache drops its least recently used statement.
+    PooledQuery prepare(const QSqlDatabase &db, const QString &sql);
+
+    // "IN (?, ?, …)" lists are built for a few fixed lengths so that lookups of any size
+    // share a handful of cached statements instead of one per length. inListSize() is the
+    // length to build for count values (count <= MaxInListSize, SQLite's parameter limit
+    // allowing); callers bind the extra slots to a repeat of their last value.
+    static constexpr int MaxInListSize = 500;
+    static int inListSize(int count);
+    static QString inListPlaceholders(int size);
+
+    // Closes the calling thread's handles. Runs automatically when a worker QThread finishes.
+    void releaseCurrentThread();
+
+    // Closes every pooled handle; call once on shutdown after worker threads have stopped.
+    void closeAll();
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    ConnectionPool() = default;
+    Q_DISABLE_COPY(ConnectionPool)
+
+    static constexpr int MaxStatementsPerConnection = 64;
+
+    static QString connectionNameFor(const QString &dbPath, QThread *thread);
+    void closeConnections(const QStringList &connNames);
+    void releaseThread(QThread *thread);
+
+    mutable QMutex mutex;
+    QHash<QThread *, QStringList> connectionsByThread;
+    QHash<QString, QHash<QString, QSharedPointer<PooledQuery::Entry>>> statementsByConnection;
+    Stats counters;
+    quint64 statementClock = 0;
+};
+
+#endif // CONNECTIONPOOL_H
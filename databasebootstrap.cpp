@@ -0,0 +1,106 @@
+#include <QDebug>
+#include <QFile>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <atomic>
+
+#include "connectionpool.h"
+#include "databasebootstrap.h"
+#include "databaseutils.h"
+#include "schemamigrations.h"
+
+namespace {
+std::atomic<int> busyTimeout{5000};
+
+// synchronous=NORMAL is durable under WAL except for the last commits on power loss;
+// negative cache_size is in KiB
+const char *const ConnectionPragmas[] = {
+    "PRAGMA synchronous = NORMAL",
+    "PRAGMA cache_size = -16384",
+    "PRAGMA mmap_size = 268435456",
+    "PRAGMA temp_store = MEMORY",
+};
+}
+
+bool DatabaseBootstrap::run()
+{
+    bool ok = true;
+
+    // Both files are written concurrently by manager, designer and manufacturer sessions
+    for (const QString &file : {DbFile::Image, DbFile::OrderBook}) {
+        if (!QFile::exists(ConnectionPool::absolutePath(file))) {
+            qWarning() << "[ERROR] Database file not found:" << ConnectionPool::absolutePath(file);
+            ok = false;
+            continue;
+        }
+        ok = enableWal(file) && ok;
+    }
+
+    // Script sets under :/migrations/, one per file
+    const QList<QPair<QString, QString>> migrationSets = {
+        {DbFile::Image, "image"},
+        {DbFile::OrderBook, "orderbook"},
+        {DbFile::Authentication, "authentication"},
+    };
+    SchemaMigrations::registerDataStep("orderbook", 2, &DatabaseUtils::importLegacyJobSheetMovements);
+
+    for (const auto &set : migrationSets) {
+        // Never let the migration create a missing database file
+        if (!QFile::exists(ConnectionPool::absolutePath(set.first)))
+            continue;
+        ok = SchemaMigrations::migrate(set.first, set.second) && ok;
+    }
+
+    return ok;
+}
+
+bool DatabaseBootstrap::enableWal(const QString &relativePath)
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(relativePath);
+    if (!db.isOpen()) return false;
+
+    // journal_mode is persistent in the file, so this only does work the first time
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA journal_mode = WAL") || !query.next()) {
+        qWarning() << "[ERROR] Failed to enable WAL on" << relativePath << ":" << query.lastError().text();
+        return false;
+    }
+
+    const QString mode = query.value(0).toString();
+    if (mode.compare("wal", Qt::CaseInsensitive) != 0) {
+        qWarning() << "[WARNING]" << relativePath << "is still in journal mode" << mode;
+        return false;
+    }
+
+    return true;
+}
+
+bool DatabaseBootstrap::configureConnection(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+
+    if (!query.exec(QString("PRAGMA busy_timeout = %1").arg(busyTimeoutMs()))) {
+        qWarning() << "[ERROR] Failed to set busy_timeout:" << query.lastError().text();
+        return false;
+    }
+
+    bool ok = true;
+    for (const char *pragma : ConnectionPragmas) {
+        if (!query.exec(pragma)) {
+            qWarning() << "[WARNING] Pragma failed:" << pragma << query.lastError().text();
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+int DatabaseBootstrap::busyTimeoutMs()
+{
+    return busyTimeout.load();
+}
+
+void DatabaseBootstrap::setBusyTimeoutMs(int ms)
+{
+    busyTimeout.store(qMax(0, ms));
+}
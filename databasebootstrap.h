@@ -0,0 +1,28 @@
+#ifndef DATABASEBOOTSTRAP_H
+#define DATABASEBOOTSTRAP_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// Startup configuration for the application's SQLite files.
+// run() switches the shared databases to WAL so readers (OrderList refreshes) never wait
+// behind a writer (JobSheet, status changes) and applies pending schema migrations;
+// configureConnection() applies the per-connection pragmas to every handle ConnectionPool opens.
+class DatabaseBootstrap
+{
+public:
+    // Call once after QApplication is created and before any window queries the databases
+    static bool run();
+
+    static bool configureConnection(QSqlDatabase &db);
+
+    // How long a statement waits on a locked database before failing with SQLITE_BUSY.
+    // Applies to handles opened after the call.
+    static int busyTimeoutMs();
+    static void setBusyTimeoutMs(int ms);
+
+private:
+    static bool enableWal(const QString &relativePath);
+};
+
+#endif // DATABASEBOOTSTRAP_H
@@ -9,168 +9,279 @@
 #include <QDateTime>
 #include <QPixmap>
 #include <QJsonObject>
-#include <QHeaderView>
 #include <QCoreApplication>
 #include <QRandomGenerator>
 #include <QUuid>
-#include <QSet>
+#include <QElapsedTimer>
+
+#include <algorithm>
 
 #include "databaseutils.h"
 #include "commontypes.h"
+#include "connectionpool.h"
+#include "dbexecutor.h"
+#include "imageingest.h"
+#include "referencedatacache.h"
+#include "rowmapper.h"
+#include "schemamigrations.h"
+#include "thumbnailcache.h"
+
+namespace {
+// Shared with logQueryPlans() so the diagnostics always explain the statements actually run
+const char *const OrderListSql = R"(
+    SELECT
+        od.sellerId, od.partyId, os.jobNo,
+        os.Manager, os.Designer, os.Manufacturer, os.Accountant,
+        od.orderDate, od.deliveryDate, od.image1Path,
+        os.Order_Approve, os.Design_Approve, os.Quality_Approve,
+        os.Order_Note, os.Design_Note, os.Quality_Note
+    FROM "OrderBook-Detail" od
+    LEFT JOIN "Order-Status" os ON od.jobNo = os.jobNo
+)";
+
+const char *const JobSheetRequestsSql = R"(
+    SELECT
+        D.sellerId,
+        D.partyId,
+        D.jobNo,
+        O.Manager,
+        O.Designer,
+        O.Manufacturer,
+        O.Accountant,
+        S.id AS requestId,
+        S.role,
+        S.userId,
+        S.fromStatus,
+        S.toStatus,
+        S.requestTime
+    FROM "OrderBook-Detail" D
+    JOIN "Order-Status" O ON D.jobNo = O.jobNo
+    LEFT JOIN (
+        SELECT r.*
+        FROM StatusChangeRequests r
+        WHERE r.status = 'Pending'
+          AND r.requestTime = (
+              SELECT MAX(requestTime)
+              FROM StatusChangeRequests
+              WHERE jobNo = r.jobNo
+                AND status = 'Pending'
+          )
+    ) S ON D.jobNo = S.jobNo;
+)";
+}
 
-//Admin Logic
-bool DatabaseUtils::deleteJewelryMenuItem(int id)
+// Price editor model; every row it writes back drops the cached reference data
+class ReferenceTableModel : public QSqlTableModel
 {
-    const QString connName = QStringLiteral("delete_menu_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    bool success = false;
+public:
+    using QSqlTableModel::QSqlTableModel;
 
+protected:
+    bool updateRowInTable(int row, const QSqlRecord &values) override
     {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) {
-            qDebug() << "Error: Failed to open database:" << db.lastError().text();
-            return false;
-        }
-
-        QSqlQuery query(db);
-        query.prepare("DELETE FROM jewelry_menu WHERE id = :id");
-        query.bindValue(":id", id);
-
-        success = query.exec();
-        if (!success) {
-            qDebug() << "Error: Failed to delete jewelry menu item:" << query.lastError().text();
-        }
+        return invalidateOn(QSqlTableModel::updateRowInTable(row, values));
+    }
+    bool insertRowIntoTable(const QSqlRecord &values) override
+    {
+        return invalidateOn(QSqlTableModel::insertRowIntoTable(values));
+    }
+    bool deleteRowFromTable(int row) override
+    {
+        return invalidateOn(QSqlTableModel::deleteRowFromTable(row));
+    }
 
-        db.close(); // Ensure DB is closed before removing
+private:
+    static bool invalidateOn(bool written)
+    {
+        if (written)
+            ReferenceDataCache::instance().invalidate();
+        return written;
     }
+};
+
+// Column bindings, in the SELECT order of the queries that read them
+template <>
+struct RowMapping<OrderListRow> {
+    static constexpr auto columns = std::make_tuple(
+        &OrderListRow::sellerId, &OrderListRow::partyId, &OrderListRow::jobNo,
+        &OrderListRow::manager, &OrderListRow::designer, &OrderListRow::manufacturer, &OrderListRow::accountant,
+        &OrderListRow::orderDate, &OrderListRow::deliveryDate, &OrderListRow::imagePath,
+        &OrderListRow::orderApprove, &OrderListRow::designApprove, &OrderListRow::qualityApprove,
+        &OrderListRow::orderNote, &OrderListRow::designNote, &OrderListRow::qualityNote);
+};
+
+template <>
+struct RowMapping<JewelryMenuItem> {
+    static constexpr auto columns = std::make_tuple(
+        &JewelryMenuItem::id, &JewelryMenuItem::parentId, &JewelryMenuItem::name, &JewelryMenuItem::displayText);
+};
+
+template <>
+struct RowMapping<ImageRecord> {
+    static constexpr auto columns = std::make_tuple(
+        &ImageRecord::imageId, &ImageRecord::imagePath, &ImageRecord::imageType, &ImageRecord::designNo,
+        &ImageRecord::companyName, &ImageRecord::goldJson, &ImageRecord::diamondJson, &ImageRecord::stoneJson,
+        &ImageRecord::time, &ImageRecord::note);
+};
+
+template <>
+struct RowMapping<CatalogHeader> {
+    static constexpr auto columns = std::make_tuple(
+        &CatalogHeader::imageId, &CatalogHeader::designNo, &CatalogHeader::imagePath, &CatalogHeader::companyName);
+};
+
+template <>
+struct RowMapping<CatalogPiece> {
+    static constexpr auto columns = std::make_tuple(
+        &CatalogPiece::imageId, &CatalogPiece::type, &CatalogPiece::sizeMM, &CatalogPiece::quantity);
+};
+
+template <>
+struct RowMapping<CatalogGold> {
+    static constexpr auto columns = std::make_tuple(
+        &CatalogGold::imageId, &CatalogGold::karat, &CatalogGold::weight);
+};
+
+template <>
+struct RowMapping<JobSheetMovement> {
+    static constexpr auto columns = std::make_tuple(
+        &JobSheetMovement::jobNo, &JobSheetMovement::material, &JobSheetMovement::direction,
+        &JobSheetMovement::type, &JobSheetMovement::size, &JobSheetMovement::pcs, &JobSheetMovement::weight,
+        &JobSheetMovement::ts, &JobSheetMovement::user);
+};
+
+template <>
+struct RowMapping<JobSheetMovementTotal> {
+    static constexpr auto columns = std::make_tuple(
+        &JobSheetMovementTotal::material, &JobSheetMovementTotal::direction, &JobSheetMovementTotal::pcs,
+        &JobSheetMovementTotal::weight, &JobSheetMovementTotal::productWeight);
+};
+
+namespace {
+// Runs sql (with an %1 placeholder for the id list) over imageIds in chunks that stay
+// under SQLite's bound-parameter limit and maps every row onto Row
+template <typename Row>
+QList<Row> readByImageIds(const QList<int> &imageIds, const QString &sql)
+{
+    QList<int> ids = imageIds;
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    if (ids.isEmpty())
+        return {};
 
-    QSqlDatabase::removeDatabase(connName); // Proper cleanup
-    return success;
-}
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open image DB:" << db.lastError().text();
+        return {};
+    }
 
-bool DatabaseUtils::insertJewelryMenuItem(int parentId, const QString &name, const QString &displayText)
-{
-    const QString connName = QStringLiteral("insert_menu_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    bool success = false;
+    QList<Row> rows;
+    constexpr int ChunkSize = ConnectionPool::MaxInListSize;
+    for (int start = 0; start < ids.size(); start += ChunkSize) {
+        const int count = qMin(ChunkSize, int(ids.size()) - start);
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
+        // Padded to a fixed list length so every chunk size shares a few cached statements;
+        // the repeated last id matches no extra rows
+        const int size = ConnectionPool::inListSize(count);
+        PooledQuery query = ConnectionPool::instance().prepare(db, sql.arg(ConnectionPool::inListPlaceholders(size)));
+        for (int i = 0; i < size; ++i)
+            query->bindValue(i, ids[start + qMin(i, count - 1)]);
 
-        if (!db.open()) {
-            qDebug() << "Failed to open DB in insertJewelryMenuItem:" << db.lastError().text();
-            return false;
+        if (!query->exec()) {
+            qWarning() << "[ERROR] Catalog child query failed:" << query->lastError().text();
+            return {};
         }
+        rows += RowMapper::readAll<Row>(query.query());
+    }
 
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                INSERT INTO jewelry_menu (parent_id, name, display_text)
-                VALUES (:parent_id, :name, :display_text)
-            )");
+    return rows;
+}
+}
 
-            query.bindValue(":parent_id", parentId == -1 ? QVariant(QVariant::Int) : QVariant(parentId));
-            query.bindValue(":name", name);
-            query.bindValue(":display_text", displayText);
+//Admin Logic
+bool DatabaseUtils::deleteJewelryMenuItem(int id)
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Error: Failed to open database:" << db.lastError().text();
+        return false;
+    }
 
-            success = query.exec();
-            if (!success) {
-                qDebug() << "Insert failed in jewelry_menu:" << query.lastError().text();
-            }
-        } // query destroyed here
+    QSqlQuery query(db);
+    query.prepare("DELETE FROM jewelry_menu WHERE id = :id");
+    query.bindValue(":id", id);
 
-        db.close();
+    const bool success = query.exec();
+    if (!success) {
+        qDebug() << "Error: Failed to delete jewelry menu item:" << query.lastError().text();
     }
 
-    QSqlDatabase::removeDatabase(connName); // Safe cleanup
     return success;
 }
 
-QList<QVariantList> DatabaseUtils::fetchJewelryMenuItems()
+bool DatabaseUtils::insertJewelryMenuItem(int parentId, const QString &name, const QString &displayText)
 {
-    QList<QVariantList> menuItems;
-    const QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-
-    const QString connName = QStringLiteral("menu_items_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qWarning() << "[ERROR] Failed to open database:" << db.lastError().text();
-            return menuItems;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Failed to open DB in insertJewelryMenuItem:" << db.lastError().text();
+        return false;
+    }
 
-        QSqlQuery query(db);
-        if (!query.exec("SELECT id, parent_id, name, display_text "
-                        "FROM jewelry_menu ORDER BY parent_id ASC, name ASC")) {
-            qWarning() << "[ERROR] Query failed:" << query.lastError().text();
-            db.close();
-            return menuItems;
-        }
+    QSqlQuery query(db);
+    query.prepare(R"(
+        INSERT INTO jewelry_menu (parent_id, name, display_text)
+        VALUES (:parent_id, :name, :display_text)
+    )");
 
-        while (query.next()) {
-            QVariantList item;
-            item << query.value(0).toInt();
-            item << (query.value(1).isNull() ? -1 : query.value(1).toInt());
-            item << query.value(2).toString();
-            item << query.value(3).toString();
-            menuItems.append(item);
-        }
+    query.bindValue(":parent_id", parentId == -1 ? QVariant(QVariant::Int) : QVariant(parentId));
+    query.bindValue(":name", name);
+    query.bindValue(":display_text", displayText);
 
-        db.close();
+    const bool success = query.exec();
+    if (!success) {
+        qDebug() << "Insert failed in jewelry_menu:" << query.lastError().text();
     }
 
-    QSqlDatabase::removeDatabase(connName);
-    return menuItems;
+    return success;
 }
 
-QMap<QString, QString> DatabaseUtils::fetchGoldPrices()
+QList<JewelryMenuItem> DatabaseUtils::fetchJewelryMenuItems()
 {
-    const QString connectionName = "gold_conn";
-    QMap<QString, QString> prices;
+    QList<JewelryMenuItem> menuItems;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return {};
-
-        {
-            QSqlQuery query("SELECT Kt, Price FROM Gold_Price", db);
-            if (!query.exec()) return {};
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open database:" << db.lastError().text();
+        return menuItems;
+    }
 
-            while (query.next()) {
-                prices[query.value(0).toString().trimmed()] = query.value(1).toString();
-            }
-        } // QSqlQuery destroyed
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT id, COALESCE(parent_id, -1), name, display_text "
+                    "FROM jewelry_menu ORDER BY parent_id ASC, name ASC")) {
+        qWarning() << "[ERROR] Query failed:" << query.lastError().text();
+        return menuItems;
+    }
 
-        // db.close(); // optional, but good
-    } // QSqlDatabase destroyed
+    menuItems = RowMapper::readAll<JewelryMenuItem>(query);
+    return menuItems;
+}
 
-    QSqlDatabase::removeDatabase(connectionName); // safe now
-    return prices;
+QMap<QString, QString> DatabaseUtils::fetchGoldPrices()
+{
+    return ReferenceDataCache::instance().goldPrices();
 }
 
 bool DatabaseUtils::updateGoldPrices(const QMap<QString, QString> &priceUpdates)
 {
-    const QString connectionName = "update_gold_conn";
     bool success = true;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return false;
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) return false;
 
-        db.transaction(); // start transaction
+    db.transaction(); // start transaction
 
+    {
         QSqlQuery query(db);
         query.prepare("UPDATE Gold_Price SET Price = :price WHERE Kt = :kt");
 
@@ -185,142 +296,96 @@ bool DatabaseUtils::updateGoldPrices(const QMap<QString, QString> &priceUpdates)
                 }
             }
         }
+    } // statement finalized before commit
 
-        if (success) db.commit();
-        else db.rollback();
-
-        db.close(); // optional, explicit
-    }
+    if (success) success = db.commit();
+    if (!success) db.rollback();
 
-    QSqlDatabase::removeDatabase(connectionName);
+    ReferenceDataCache::instance().invalidate();
     return success;
 }
 
 bool DatabaseUtils::sizeMMExists(const QString &table, double sizeMM)
 {
-    const QString connectionName = "check_conn";
     bool exists = false;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) {
-            qWarning() << "DB open failed (sizeMMExists):" << db.lastError();
-            QSqlDatabase::removeDatabase(connectionName);  // cleanup
-            return false;
-        }
-
-        QSqlQuery query(db);
-        query.prepare("SELECT COUNT(*) FROM " + table + " WHERE sizeMM = :sizeMM");
-        query.bindValue(":sizeMM", sizeMM);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "DB open failed (sizeMMExists):" << db.lastError();
+        return false;
+    }
 
-        if (query.exec() && query.next()) {
-            exists = query.value(0).toInt() > 0;
-        }
+    PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT COUNT(*) FROM " + table + " WHERE sizeMM = :sizeMM");
+    query->bindValue(":sizeMM", sizeMM);
 
-        db.close();
+    if (query->exec() && query->next()) {
+        exists = query->value(0).toInt() > 0;
     }
 
-    QSqlDatabase::removeDatabase(connectionName);
     return exists;
 }
 
 bool DatabaseUtils::insertRoundDiamond(const QString &sieve, double sizeMM, double weight, double price)
 {
-    const QString connectionName = "insert_round_conn";
-    bool success = false;
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) {
-            qWarning() << "DB open failed (insertRoundDiamond):" << db.lastError();
-            QSqlDatabase::removeDatabase(connectionName);  // cleanup
-            return false;
-        }
-
-        QSqlQuery query(db);
-        query.prepare(R"(
-            INSERT INTO Round_diamond (sieve, sizeMM, weight, price)
-            VALUES (:sieve, :sizeMM, :weight, :price)
-        )");
-        query.bindValue(":sieve", sieve);
-        query.bindValue(":sizeMM", sizeMM);
-        query.bindValue(":weight", weight);
-        query.bindValue(":price", price);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "DB open failed (insertRoundDiamond):" << db.lastError();
+        return false;
+    }
 
-        success = query.exec();
+    QSqlQuery query(db);
+    query.prepare(R"(
+        INSERT INTO Round_diamond (sieve, sizeMM, weight, price)
+        VALUES (:sieve, :sizeMM, :weight, :price)
+    )");
+    query.bindValue(":sieve", sieve);
+    query.bindValue(":sizeMM", sizeMM);
+    query.bindValue(":weight", weight);
+    query.bindValue(":price", price);
 
-        db.close();
-    }
+    if (!query.exec())
+        return false;
 
-    QSqlDatabase::removeDatabase(connectionName);
-    return success;
+    ReferenceDataCache::instance().invalidate();
+    return true;
 }
 
 bool DatabaseUtils::insertFancyDiamond(const QString &shape, const QString &sizeMM, double weight, double price)
 {
-    const QString connectionName = "insert_fancy_conn";
-    bool success = false;
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qWarning() << "DB open failed (insertFancyDiamond):" << db.lastError();
-            QSqlDatabase::removeDatabase(connectionName);  // cleanup even on failure
-            return false;
-        }
-
-        QSqlQuery query(db);
-        query.prepare(R"(
-            INSERT INTO Fancy_diamond (shape, sizeMM, weight, price)
-            VALUES (:shape, :sizeMM, :weight, :price)
-        )");
-        query.bindValue(":shape", shape);
-        query.bindValue(":sizeMM", sizeMM);
-        query.bindValue(":weight", weight);
-        query.bindValue(":price", price);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "DB open failed (insertFancyDiamond):" << db.lastError();
+        return false;
+    }
 
-        if (!query.exec()) {
-            qWarning() << "Insert FancyDiamond failed:" << query.lastError();
-        } else {
-            success = true;
-        }
+    QSqlQuery query(db);
+    query.prepare(R"(
+        INSERT INTO Fancy_diamond (shape, sizeMM, weight, price)
+        VALUES (:shape, :sizeMM, :weight, :price)
+    )");
+    query.bindValue(":shape", shape);
+    query.bindValue(":sizeMM", sizeMM);
+    query.bindValue(":weight", weight);
+    query.bindValue(":price", price);
 
-        db.close(); // optional but good hygiene
-    } // db out of scope
+    if (!query.exec()) {
+        qWarning() << "Insert FancyDiamond failed:" << query.lastError();
+        return false;
+    }
 
-    QSqlDatabase::removeDatabase(connectionName); // guaranteed cleanup
-    return success;
+    ReferenceDataCache::instance().invalidate();
+    return true;
 }
 
 QSqlTableModel* DatabaseUtils::createTableModel(QObject *parent, const QString &table)
 {
-    QSqlDatabase db;
-
-    if (QSqlDatabase::contains("table_model_conn")) {
-        db = QSqlDatabase::database("table_model_conn");
-    } else {
-        db = QSqlDatabase::addDatabase("QSQLITE", "table_model_conn");
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-    }
-
-    if (!db.open()) {
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
         qWarning() << "Failed to open DB for table model:" << db.lastError();
         return nullptr;
     }
 
-    auto *model = new QSqlTableModel(parent, db);
+    auto *model = new ReferenceTableModel(parent, db);
     model->setTable(table);
     model->setEditStrategy(QSqlTableModel::OnManualSubmit);
 
@@ -330,7 +395,7 @@ QSqlTableModel* DatabaseUtils::createTableModel(QObject *parent, const QString &
         return nullptr;
     }
 
-    return model; // keep DB alive while model exists
+    return model; // pooled handle outlives the model
 }
 
 QStringList DatabaseUtils::fetchRoles()
@@ -338,94 +403,70 @@ QStringList DatabaseUtils::fetchRoles()
     QStringList roles;
     QDir::setCurrent(QCoreApplication::applicationDirPath());
 
-    const QString connName = QStringLiteral("fetch_roles_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Authentication);
+    if (!db.isOpen()) {
+        qDebug() << "Failed to open database for fetchRoles:" << db.lastError().text();
+        return roles;
+    }
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/luxeMineAuthentication.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/luxeMineAuthentication.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "Failed to open database for fetchRoles:" << db.lastError().text();
-            return roles;
+    QSqlQuery query(db);
+    if (!query.exec("SELECT role FROM OrderBook_Roles")) {
+        qDebug() << "Failed to execute role query:" << query.lastError().text();
+    } else {
+        roles << "-";
+        while (query.next()) {
+            roles << query.value(0).toString();
         }
+    }
 
-        {
-            QSqlQuery query(db);
-            if (!query.exec("SELECT role FROM OrderBook_Roles")) {
-                qDebug() << "Failed to execute role query:" << query.lastError().text();
-            } else {
-                roles << "-";
-                while (query.next()) {
-                    roles << query.value(0).toString();
-                }
-            }
-        } // QSqlQuery destroyed here
-
-        db.close(); // optional, but keeps things explicit
-    } // db handle destroyed here
-
-    QSqlDatabase::removeDatabase(connName); // connection freed from pool
     return roles;
 }
 
 QStringList DatabaseUtils::fetchImagePaths()
 {
-    const QString connectionName = "images_conn";
     QStringList paths;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qWarning() << "Failed to open image DB:" << db.lastError();
-            return {};
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "Failed to open image DB:" << db.lastError();
+        return {};
+    }
 
-        QSqlQuery query(db);
-        if (!query.exec("SELECT image_path FROM image_data")) {
-            qWarning() << "Image query failed:" << query.lastError();
-            return {};
-        }
+    QSqlQuery query(db);
+    if (!query.exec("SELECT image_path FROM image_data")) {
+        qWarning() << "Image query failed:" << query.lastError();
+        return {};
+    }
 
-        paths.reserve(100); // just a guess, avoids multiple reallocations
-        while (query.next()) {
-            paths.append(query.value(0).toString());
-        }
-    } // QSqlQuery and QSqlDatabase go out of scope
+    paths.reserve(100); // just a guess, avoids multiple reallocations
+    while (query.next()) {
+        paths.append(query.value(0).toString());
+    }
 
-    QSqlDatabase::removeDatabase(connectionName);
     return paths;
 }
 
 bool DatabaseUtils::deleteUser(const QString &userId)
 {
-    const QString connName = QStringLiteral("delete_user_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-
+    const QString dbPath = ConnectionPool::absolutePath(DbFile::Image);
     if (!QFile::exists(dbPath)) {
         qWarning() << "Database file not found:" << dbPath;
         return false;
     }
 
-    bool success = true;
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
-        if (!db.open()) {
-            qWarning() << "Failed to open DB:" << db.lastError().text();
-            return false;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "Failed to open DB:" << db.lastError().text();
+        return false;
+    }
 
-        if (!db.transaction()) {
-            qWarning() << "Failed to begin transaction:" << db.lastError().text();
-            return false;
-        }
+    if (!db.transaction()) {
+        qWarning() << "Failed to begin transaction:" << db.lastError().text();
+        return false;
+    }
 
+    bool success = true;
+    {
         QSqlQuery query(db);
 
         // delete from user_cart
@@ -433,7 +474,6 @@ bool DatabaseUtils::deleteUser(const QString &userId)
         query.bindValue(":userId", userId);
         if (!query.exec()) {
             qWarning() << "Failed to delete from user_cart:" << query.lastError().text();
-            db.rollback();
             success = false;
         }
 
@@ -443,130 +483,121 @@ bool DatabaseUtils::deleteUser(const QString &userId)
             query.bindValue(":userId", userId);
             if (!query.exec()) {
                 qWarning() << "Failed to delete from users:" << query.lastError().text();
-                db.rollback();
                 success = false;
             }
         }
+    }
 
-        // final commit
-        if (success && !db.commit()) {
-            qWarning() << "Commit failed:" << db.lastError().text();
-            db.rollback();
-            success = false;
-        }
-    } // db goes out of scope
+    if (!success) {
+        db.rollback();
+        return false;
+    }
 
-    QSqlDatabase::removeDatabase(connName); // safe now
-    return success;
+    // final commit
+    if (!db.commit()) {
+        qWarning() << "Commit failed:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    return true;
 }
 
-QList<QVariantList> DatabaseUtils::fetchUserDetailsForAdmin()
+QList<UserSummary> DatabaseUtils::fetchUserDetailsForAdmin()
 {
-    QList<QVariantList> userDetails;
-    const QString connName = QStringLiteral("user_details_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
+    QList<UserSummary> userDetails;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-
-        QFile dbFile(dbPath);
-        if (!dbFile.exists()) {
-            qDebug() << "Error: Database file does not exist at path:" << dbPath;
-            return userDetails;
-        }
+    const QString dbPath = ConnectionPool::absolutePath(DbFile::Image);
+    if (!QFile::exists(dbPath)) {
+        qDebug() << "Error: Database file does not exist at path:" << dbPath;
+        return userDetails;
+    }
 
-        if (!db.open()) {
-            qDebug() << "Error: Failed to open database:" << db.lastError().text();
-            return userDetails;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Error: Failed to open database:" << db.lastError().text();
+        return userDetails;
+    }
 
-        QMap<QString, QVariantList> userMap;
+    QMap<QString, UserSummary> userMap;
 
-        {
-            QSqlQuery query(db);
-            query.prepare(
-                "SELECT u.user_id, u.company_name, uc.pdf_path "
-                "FROM users u "
-                "LEFT JOIN user_cart uc ON u.user_id = uc.user_id"
-                );
+    QSqlQuery query(db);
+    query.prepare(
+        "SELECT u.user_id, u.company_name, uc.pdf_path "
+        "FROM users u "
+        "LEFT JOIN user_cart uc ON u.user_id = uc.user_id"
+        );
+
+    if (!query.exec()) {
+        qDebug() << "Error executing query:" << query.lastError().text();
+        return userDetails;
+    }
 
-            if (!query.exec()) {
-                qDebug() << "Error executing query:" << query.lastError().text();
-                return userDetails;
-            }
+    while (query.next()) {
+        if (DbExecutor::isCancelled())
+            return {};
+
+        QString userId = query.value("user_id").toString();
+        QString companyName = query.value("company_name").toString();
+        QString pdfPathsJson = query.value("pdf_path").toString();
+        QString lastPdfPath;
 
-            while (query.next()) {
-                QString userId = query.value("user_id").toString();
-                QString companyName = query.value("company_name").toString();
-                QString pdfPathsJson = query.value("pdf_path").toString();
-                QString lastPdfPath;
-
-                if (!pdfPathsJson.isEmpty()) {
-                    QJsonDocument doc = QJsonDocument::fromJson(pdfPathsJson.toUtf8());
-                    if (doc.isArray()) {
-                        QJsonArray pdfArray = doc.array();
-                        if (!pdfArray.isEmpty()) {
-                            QJsonObject latestPdf = pdfArray[0].toObject();
-                            for (const QJsonValue &value : pdfArray) {
-                                QJsonObject pdfObj = value.toObject();
-                                if (pdfObj["time"].toString() > latestPdf["time"].toString()) {
-                                    latestPdf = pdfObj;
-                                }
-                            }
-                            lastPdfPath = latestPdf["path"].toString();
+        if (!pdfPathsJson.isEmpty()) {
+            QJsonDocument doc = QJsonDocument::fromJson(pdfPathsJson.toUtf8());
+            if (doc.isArray()) {
+                QJsonArray pdfArray = doc.array();
+                if (!pdfArray.isEmpty()) {
+                    QJsonObject latestPdf = pdfArray[0].toObject();
+                    for (const QJsonValue &value : pdfArray) {
+                        QJsonObject pdfObj = value.toObject();
+                        if (pdfObj["time"].toString() > latestPdf["time"].toString()) {
+                            latestPdf = pdfObj;
                         }
                     }
-                }
-
-                if (!userMap.contains(userId)) {
-                    userMap[userId] = {userId, companyName, lastPdfPath};
-                } else if (!lastPdfPath.isEmpty() && userMap[userId][2].toString().isEmpty()) {
-                    userMap[userId][2] = lastPdfPath;
+                    lastPdfPath = latestPdf["path"].toString();
                 }
             }
         }
 
-        userDetails = userMap.values();
-
+        auto it = userMap.find(userId);
+        if (it == userMap.end()) {
+            userMap.insert(userId, {userId, companyName, lastPdfPath});
+        } else if (!lastPdfPath.isEmpty() && it->lastPdfPath.isEmpty()) {
+            it->lastPdfPath = lastPdfPath;
+        }
     }
 
-    QSqlDatabase::removeDatabase(connName); // Now safe
+    userDetails = userMap.values();
     return userDetails;
 }
 
 QList<PdfRecord> DatabaseUtils::getUserPdfs(const QString &userId)
 {
     QList<PdfRecord> pdfRecords;
-    const QString connName = QStringLiteral("get_pdfs_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
 
+    const QString dbPath = ConnectionPool::absolutePath(DbFile::Image);
     if (!QFile::exists(dbPath)) {
         qDebug() << "Error: Database file does not exist at path:" << dbPath;
         return pdfRecords;
     }
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "Error: Failed to open database:" << db.lastError().text();
-            return pdfRecords;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Error: Failed to open database:" << db.lastError().text();
+        return pdfRecords;
+    }
 
-        QSqlQuery query(db);
-        query.prepare("SELECT pdf_path FROM user_cart WHERE user_id = :userId AND pdf_path IS NOT NULL");
-        query.bindValue(":userId", userId);
+    {
+        PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT pdf_path FROM user_cart WHERE user_id = :userId AND pdf_path IS NOT NULL");
+        query->bindValue(":userId", userId);
 
-        if (!query.exec()) {
-            qDebug() << "Error: Failed to query pdf_path for user:" << userId << ":" << query.lastError().text();
-            db.close();
+        if (!query->exec()) {
+            qDebug() << "Error: Failed to query pdf_path for user:" << userId << ":" << query->lastError().text();
             return pdfRecords;
         }
 
-        while (query.next()) {
-            QString pdfPathsJson = query.value("pdf_path").toString();
+        while (query->next()) {
+            QString pdfPathsJson = query->value("pdf_path").toString();
             if (pdfPathsJson.isEmpty()) continue;
 
             QJsonDocument doc = QJsonDocument::fromJson(pdfPathsJson.toUtf8());
@@ -588,14 +619,8 @@ QList<PdfRecord> DatabaseUtils::getUserPdfs(const QString &userId)
                 }
             }
         }
-
-
-        db.close();  // Explicitly close before connection removal
-
     }
 
-    QSqlDatabase::removeDatabase(connName); // safe now
-
     if (pdfRecords.isEmpty()) {
         qDebug() << "No PDFs found for user:" << userId;
     } else {
@@ -609,217 +634,170 @@ QList<PdfRecord> DatabaseUtils::getUserPdfs(const QString &userId)
 
 bool DatabaseUtils::checkAdminCredentials(const QString &username, const QString &password, QString &role)
 {
-    const QString connName = QStringLiteral("admin_login_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     bool valid = false;
+    QDir::setCurrent(QCoreApplication::applicationDirPath());
 
-    {
-        QDir::setCurrent(QCoreApplication::applicationDirPath());
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "Failed to connect to admin_login DB:" << db.lastError().text();
-            // ensure cleanup even on failure
-            QSqlDatabase::removeDatabase(connName);
-            return false;
-        }
-
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                SELECT role
-                FROM admin_login
-                WHERE username = :username
-                  AND password_hash = :password
-            )");
-            query.bindValue(":username", username);
-            query.bindValue(":password", password);
-
-            if (query.exec() && query.next()) {
-                role = query.value("role").toString();
-                valid = true;
-            } else if (query.lastError().isValid()) {
-                qDebug() << "Query error in checkAdminCredentials:"
-                         << query.lastError().text();
-            }
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Admin);
+    if (!db.isOpen()) {
+        qDebug() << "Failed to connect to admin_login DB:" << db.lastError().text();
+        return false;
+    }
 
-        db.close(); // optional but fine
+    QSqlQuery query(db);
+    query.prepare(R"(
+        SELECT role
+        FROM admin_login
+        WHERE username = :username
+          AND password_hash = :password
+    )");
+    query.bindValue(":username", username);
+    query.bindValue(":password", password);
+
+    if (query.exec() && query.next()) {
+        role = query.value("role").toString();
+        valid = true;
+    } else if (query.lastError().isValid()) {
+        qDebug() << "Query error in checkAdminCredentials:"
+                 << query.lastError().text();
     }
 
-    QSqlDatabase::removeDatabase(connName);
     return valid;
 }
 
 bool DatabaseUtils::createOrderBookUser(const QString &userId, const QString &userName, const QString &password, const QString &role, const QString &date, QString &errorMsg)
 {
-    const QString connName = QStringLiteral("create_user_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    bool success = false;
+    QDir::setCurrent(QCoreApplication::applicationDirPath());
 
-    {
-        QDir::setCurrent(QCoreApplication::applicationDirPath());
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/luxeMineAuthentication.db");
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Authentication);
+    if (!db.isOpen()) {
+        errorMsg = "Failed to connect to database: " + db.lastError().text();
+        return false;
+    }
 
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
+    // --- Check duplicate userId
+    {
+        QSqlQuery checkQuery(db);
+        checkQuery.prepare("SELECT userId FROM OrderBook_Login WHERE userId = :userId");
+        checkQuery.bindValue(":userId", userId);
 
-        if (!db.open()) {
-            errorMsg = "Failed to connect to database: " + db.lastError().text();
+        if (!checkQuery.exec()) {
+            errorMsg = "Failed to check existing user: " + checkQuery.lastError().text();
             return false;
         }
 
-        // --- Check duplicate userId
-        {
-            QSqlQuery checkQuery(db);
-            checkQuery.prepare("SELECT userId FROM OrderBook_Login WHERE userId = :userId");
-            checkQuery.bindValue(":userId", userId);
-
-            if (!checkQuery.exec()) {
-                errorMsg = "Failed to check existing user: " + checkQuery.lastError().text();
-                db.close();
-                QSqlDatabase::removeDatabase(connName);
-                return false;
-            }
-
-            if (checkQuery.next()) {
-                errorMsg = "User ID already exists.";
-                db.close();
-                QSqlDatabase::removeDatabase(connName);
-                return false;
-            }
-        }
-
-        // --- Insert new user
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                INSERT INTO OrderBook_Login (userId, userName, password, date, role)
-                VALUES (:userId, :userName, :password, :date, :role)
-            )");
-            query.bindValue(":userId", userId);
-            query.bindValue(":userName", userName);
-            query.bindValue(":password", password); // Consider hashing this
-            query.bindValue(":date", date);
-            query.bindValue(":role", role);
-
-            if (!query.exec()) {
-                errorMsg = "Failed to save user: " + query.lastError().text();
-            } else {
-                success = true;
-            }
+        if (checkQuery.next()) {
+            errorMsg = "User ID already exists.";
+            return false;
         }
+    }
 
-        db.close();
+    // --- Insert new user
+    QSqlQuery query(db);
+    query.prepare(R"(
+        INSERT INTO OrderBook_Login (userId, userName, password, date, role)
+        VALUES (:userId, :userName, :password, :date, :role)
+    )");
+    query.bindValue(":userId", userId);
+    query.bindValue(":userName", userName);
+    query.bindValue(":password", password); // Consider hashing this
+    query.bindValue(":date", date);
+    query.bindValue(":role", role);
+
+    if (!query.exec()) {
+        errorMsg = "Failed to save user: " + query.lastError().text();
+        return false;
     }
 
-    QSqlDatabase::removeDatabase(connName);
-    return success;
+    return true;
 }
 
 bool DatabaseUtils::updateStatusChangeRequest(int requestId, bool approved, const QString &note)
 {
-    const QString connName = QStringLiteral("status_change_update_conn_%").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "[ERROR] DB Open Failed:" << db.lastError().text();
-            return false; // db handle destroyed automatically
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] DB Open Failed:" << db.lastError().text();
+        return false;
+    }
 
-        if (approved) {
-            QString jobNo, role, toStatus;
-
-            {
-                QSqlQuery selectQuery(db);
-                selectQuery.prepare(R"(
-                    SELECT jobNo, role, toStatus
-                    FROM StatusChangeRequests
-                    WHERE id = :id
-                )");
-                selectQuery.bindValue(":id", requestId);
-
-                if (!selectQuery.exec() || !selectQuery.next()) {
-                    qDebug() << "[ERROR] SELECT failed:" << selectQuery.lastError().text();
-                    return false;
-                }
+    if (approved) {
+        QString jobNo, role, toStatus;
 
-                jobNo = selectQuery.value("jobNo").toString();
-                role = selectQuery.value("role").toString();
-                toStatus = selectQuery.value("toStatus").toString();
-            } // selectQuery destroyed here
+        {
+            QSqlQuery selectQuery(db);
+            selectQuery.prepare(R"(
+                SELECT jobNo, role, toStatus
+                FROM StatusChangeRequests
+                WHERE id = :id
+            )");
+            selectQuery.bindValue(":id", requestId);
 
-            QStringList roleOrder = {"Manager", "Designer", "Manufacturer", "Accountant"};
-            int roleIndex = roleOrder.indexOf(role);
-            if (roleIndex == -1) {
-                qDebug() << "[ERROR] Invalid role:" << role;
+            if (!selectQuery.exec() || !selectQuery.next()) {
+                qDebug() << "[ERROR] SELECT failed:" << selectQuery.lastError().text();
                 return false;
             }
 
-            QStringList setParts;
-            for (int i = 0; i < roleOrder.size(); ++i) {
-                if (i == roleIndex)
-                    setParts << QString("%1 = '%2'").arg(roleOrder[i], toStatus);
-                else if (i > roleIndex)
-                    setParts << QString("%1 = 'Pending'").arg(roleOrder[i]);
-            }
+            jobNo = selectQuery.value("jobNo").toString();
+            role = selectQuery.value("role").toString();
+            toStatus = selectQuery.value("toStatus").toString();
+        } // selectQuery destroyed here
 
-            QString updateSQL = QString(R"(
-                UPDATE "Order-Status"
-                SET %1
-                WHERE jobNo = '%2'
-            )").arg(setParts.join(", "), jobNo);
-
-            {
-                QSqlQuery updateQuery(db);
-                if (!updateQuery.exec(updateSQL)) {
-                    qDebug() << "[ERROR] Failed to update Order-Status:" << updateQuery.lastError().text();
-                    return false;
-                }
-            } // updateQuery destroyed here
+        QStringList roleOrder = {"Manager", "Designer", "Manufacturer", "Accountant"};
+        int roleIndex = roleOrder.indexOf(role);
+        if (roleIndex == -1) {
+            qDebug() << "[ERROR] Invalid role:" << role;
+            return false;
         }
 
-        {
-            QSqlQuery finalUpdateQuery(db);
-            if (approved) {
-                finalUpdateQuery.prepare(R"(
-                    UPDATE StatusChangeRequests
-                    SET status = 'Approved'
-                    WHERE id = :id
-                )");
-                finalUpdateQuery.bindValue(":id", requestId);
-            } else {
-                finalUpdateQuery.prepare(R"(
-                    UPDATE StatusChangeRequests
-                    SET status = 'Declined',
-                        note = :note
-                    WHERE id = :id
-                )");
-                finalUpdateQuery.bindValue(":note", note);
-                finalUpdateQuery.bindValue(":id", requestId);
-            }
+        QStringList setParts;
+        for (int i = 0; i < roleOrder.size(); ++i) {
+            if (i == roleIndex)
+                setParts << QString("%1 = '%2'").arg(roleOrder[i], toStatus);
+            else if (i > roleIndex)
+                setParts << QString("%1 = 'Pending'").arg(roleOrder[i]);
+        }
 
-            if (!finalUpdateQuery.exec()) {
-                qDebug() << "[ERROR] Failed to update StatusChangeRequests:" << finalUpdateQuery.lastError().text();
-                return false;
-            }
-        } // finalUpdateQuery destroyed here
+        QString updateSQL = QString(R"(
+            UPDATE "Order-Status"
+            SET %1
+            WHERE jobNo = '%2'
+        )").arg(setParts.join(", "), jobNo);
+
+        QSqlQuery updateQuery(db);
+        if (!updateQuery.exec(updateSQL)) {
+            qDebug() << "[ERROR] Failed to update Order-Status:" << updateQuery.lastError().text();
+            return false;
+        }
+    }
+
+    QSqlQuery finalUpdateQuery(db);
+    if (approved) {
+        finalUpdateQuery.prepare(R"(
+            UPDATE StatusChangeRequests
+            SET status = 'Approved'
+            WHERE id = :id
+        )");
+        finalUpdateQuery.bindValue(":id", requestId);
+    } else {
+        finalUpdateQuery.prepare(R"(
+            UPDATE StatusChangeRequests
+            SET status = 'Declined',
+                note = :note
+            WHERE id = :id
+        )");
+        finalUpdateQuery.bindValue(":note", note);
+        finalUpdateQuery.bindValue(":id", requestId);
+    }
 
-        db.close(); // optional, but makes intent explicit
-    } // db handle destroyed here
+    if (!finalUpdateQuery.exec()) {
+        qDebug() << "[ERROR] Failed to update StatusChangeRequests:" << finalUpdateQuery.lastError().text();
+        return false;
+    }
 
-    QSqlDatabase::removeDatabase(connName); // now safe — all queries destroyedŚ
     return true;
 }
 
 bool DatabaseUtils::updateRoleStatus(const QString &jobNo, const QString &role, const QString &newStatus)
 {
-    const QString connName = QStringLiteral("update_role_status_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     bool success = false;
     // qDebug()<<role;
     QString normalizedRole = role.toLower();
@@ -836,114 +814,64 @@ bool DatabaseUtils::updateRoleStatus(const QString &jobNo, const QString &role,
         return false;
     }
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (db.open()) {
-            QSqlQuery query(db);
-            QString column = roleToColumn[normalizedRole];
-            QString sql = QString(R"(UPDATE "Order-Status" SET "%1" = :status WHERE jobNo = :jobNo)").arg(column);
-
-            query.prepare(sql);
-            query.bindValue(":status", newStatus);
-            query.bindValue(":jobNo", jobNo);
-
-            success = query.exec();
-            if (!success) {
-                qWarning() << "[ERROR] Failed to update role status:" << query.lastError().text()
-                    << "| SQL:" << sql
-                    << "| jobNo:" << jobNo
-                    << "| newStatus:" << newStatus;
-            }
-        } else {
-            qWarning() << "[ERROR] DB open failed in updateRoleStatus:" << db.lastError().text();
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (db.isOpen()) {
+        QSqlQuery query(db);
+        QString column = roleToColumn[normalizedRole];
+        QString sql = QString(R"(UPDATE "Order-Status" SET "%1" = :status WHERE jobNo = :jobNo)").arg(column);
+
+        query.prepare(sql);
+        query.bindValue(":status", newStatus);
+        query.bindValue(":jobNo", jobNo);
 
-        db.close();
+        success = query.exec();
+        if (!success) {
+            qWarning() << "[ERROR] Failed to update role status:" << query.lastError().text()
+                << "| SQL:" << sql
+                << "| jobNo:" << jobNo
+                << "| newStatus:" << newStatus;
+        }
+    } else {
+        qWarning() << "[ERROR] DB open failed in updateRoleStatus:" << db.lastError().text();
     }
-    QSqlDatabase::removeDatabase(connName);
+
     return success;
 }
 
 QList<JobSheetRequest> DatabaseUtils::fetchJobSheetRequests()
 {
     QList<JobSheetRequest> results;
-    const QString connName = QStringLiteral("fetch_jobsheet_requests_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
 
-    {
-        QString dbPath = QCoreApplication::applicationDirPath() + "/database/mega_mine_orderbook.db";
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[fetchJobSheetRequests][ERROR] DB open failed:" << db.lastError().text();
+        return results;
+    }
 
-        if (!db.open()) {
-            qDebug() << "[fetchJobSheetRequests][ERROR] DB open failed:" << db.lastError().text();
-            // db will go out of scope before removeDatabase()
-        } else {
-            QString queryStr = R"(
-                SELECT
-                    D.sellerId,
-                    D.partyId,
-                    D.jobNo,
-                    O.Manager,
-                    O.Designer,
-                    O.Manufacturer,
-                    O.Accountant,
-                    S.id AS requestId,
-                    S.role,
-                    S.userId,
-                    S.fromStatus,
-                    S.toStatus,
-                    S.requestTime
-                FROM "OrderBook-Detail" D
-                JOIN "Order-Status" O ON D.jobNo = O.jobNo
-                LEFT JOIN (
-                    SELECT r.*
-                    FROM StatusChangeRequests r
-                    WHERE r.status = 'Pending'
-                      AND r.requestTime = (
-                          SELECT MAX(requestTime)
-                          FROM StatusChangeRequests
-                          WHERE jobNo = r.jobNo
-                            AND status = 'Pending'
-                      )
-                ) S ON D.jobNo = S.jobNo;
-            )";
-
-            QSqlQuery query(db);
-            if (!query.exec(queryStr)) {
-                qDebug() << "[fetchJobSheetRequests][ERROR] Query failed:" << query.lastError().text();
-            } else {
-                while (query.next()) {
-                    JobSheetRequest row;
-                    row.sellerId        = query.value(0).toString();
-                    row.partyId         = query.value(1).toString();
-                    row.jobNo           = query.value(2).toString();
-                    row.manager         = query.value(3).toString();
-                    row.designer        = query.value(4).toString();
-                    row.manufacturer    = query.value(5).toString();
-                    row.accountant      = query.value(6).toString();
-                    row.requestId       = query.value(7).toInt();
-                    row.requestRole     = query.value(8).toString();
-                    row.requestRoleId   = query.value(9).toString();
-                    row.fromStatus      = query.value(10).toString();
-                    row.toStatus        = query.value(11).toString();
-                    row.requestTime     = query.value(12).toDateTime().toString(Qt::ISODate);
-                    results.append(row);
-                }
-            }
-            // query destroyed here
 
-            db.close();
+    QSqlQuery query(db);
+    if (!query.exec(JobSheetRequestsSql)) {
+        qDebug() << "[fetchJobSheetRequests][ERROR] Query failed:" << query.lastError().text();
+    } else {
+        while (query.next()) {
+            JobSheetRequest row;
+            row.sellerId        = query.value(0).toString();
+            row.partyId         = query.value(1).toString();
+            row.jobNo           = query.value(2).toString();
+            row.manager         = query.value(3).toString();
+            row.designer        = query.value(4).toString();
+            row.manufacturer    = query.value(5).toString();
+            row.accountant      = query.value(6).toString();
+            row.requestId       = query.value(7).toInt();
+            row.requestRole     = query.value(8).toString();
+            row.requestRoleId   = query.value(9).toString();
+            row.fromStatus      = query.value(10).toString();
+            row.toStatus        = query.value(11).toString();
+            row.requestTime     = query.value(12).toDateTime().toString(Qt::ISODate);
+            results.append(row);
         }
-        // db destroyed here
     }
 
-    // Now safe to remove connection
-    QSqlDatabase::removeDatabase(connName);
-
     return results;
 }
 
@@ -951,379 +879,320 @@ QList<JobSheetRequest> DatabaseUtils::fetchJobSheetRequests()
 //User Logic
 bool DatabaseUtils::userExists(const QString &userId)
 {
-    const QString connectionName = "user_check_conn";
-    bool exists = false;
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return false;
-
-        {
-            QSqlQuery query(db);
-            query.prepare("SELECT user_id FROM users WHERE user_id = :user_id");
-            query.bindValue(":user_id", userId);
-            exists = query.exec() && query.next();
-        } // QSqlQuery destroyed here
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) return false;
 
-        db.close(); // optional
-    } // QSqlDatabase destroyed here
-
-    QSqlDatabase::removeDatabase(connectionName); // now safe
-    return exists;
+    PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT user_id FROM users WHERE user_id = :user_id");
+    query->bindValue(":user_id", userId);
+    return query->exec() && query->next();
 }
 
 bool DatabaseUtils::userExistsByMobileAndName(const QString &userId, const QString &name)
 {
-    const QString connectionName = "user_mobile_check_conn";
-    bool exists = false;
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return false;
-
-        {
-            QSqlQuery query(db);
-            query.prepare("SELECT user_id FROM users WHERE mobile_no = :mobile_no AND name = :name");
-            query.bindValue(":mobile_no", userId);
-            query.bindValue(":name", name);
-            exists = query.exec() && query.next();
-        } // QSqlQuery destroyed here
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) return false;
 
-        db.close(); // optional but safe
-    } // QSqlDatabase destroyed here
-
-    QSqlDatabase::removeDatabase(connectionName); // now safe
-    return exists;
+    PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT user_id FROM users WHERE mobile_no = :mobile_no AND name = :name");
+    query->bindValue(":mobile_no", userId);
+    query->bindValue(":name", name);
+    return query->exec() && query->next();
 }
 
 bool DatabaseUtils::insertUser(const QString &userId, const QString &companyName, const QString &mobileNo, const QString &gstNo, const QString &name, const QString &emailId, const QString &address)
 {
-    const QString connectionName = "user_insert_conn";
-    bool success = false;
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) return false;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return false;
-
-        {
-            QSqlQuery query(db);
-            query.prepare("INSERT INTO users (user_id, company_name, mobile_no, gst_no, name, email_id, address, time) "
-                          "VALUES (:user_id, :company_name, :mobile_no, :gst_no, :name, :email_id, :address, :time)");
-            query.bindValue(":user_id", userId);
-            query.bindValue(":company_name", companyName);
-            query.bindValue(":mobile_no", mobileNo);
-            query.bindValue(":gst_no", gstNo);
-            query.bindValue(":name", name);
-            query.bindValue(":email_id", emailId);
-            query.bindValue(":address", address);
-            query.bindValue(":time", QDateTime::currentDateTime().toString(Qt::ISODate));
-
-            success = query.exec();
-        } // QSqlQuery destroyed here
-
-        db.close(); // optional but safe
-    } // QSqlDatabase destroyed here
-
-    QSqlDatabase::removeDatabase(connectionName); // now safe
-    return success;
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO users (user_id, company_name, mobile_no, gst_no, name, email_id, address, time) "
+                  "VALUES (:user_id, :company_name, :mobile_no, :gst_no, :name, :email_id, :address, :time)");
+    query.bindValue(":user_id", userId);
+    query.bindValue(":company_name", companyName);
+    query.bindValue(":mobile_no", mobileNo);
+    query.bindValue(":gst_no", gstNo);
+    query.bindValue(":name", name);
+    query.bindValue(":email_id", emailId);
+    query.bindValue(":address", address);
+    query.bindValue(":time", QDateTime::currentDateTime().toString(Qt::ISODate));
+
+    return query.exec();
 }
 
 QList<SelectionData> DatabaseUtils::loadUserCart(const QString &userId)
 {
     QList<SelectionData> selections;
-    const QString connectionName = "load_cart_conn";
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return selections;
 
-        {
-            QSqlQuery query(db);
-            query.prepare("SELECT cart_details FROM user_cart WHERE user_id = :userId");
-            query.bindValue(":userId", userId);
-
-            if (query.exec() && query.next()) {
-                QString cartJson = query.value(0).toString();
-                QJsonDocument doc = QJsonDocument::fromJson(cartJson.toUtf8());
-                if (doc.isArray()) {
-                    QJsonArray cartArray = doc.array();
-                    for (const QJsonValue &value : cartArray) {
-                        QJsonObject obj = value.toObject();
-                        SelectionData selection;
-                        selection.imageId    = obj["imageId"].toInt();
-                        selection.goldType   = obj["goldType"].toString();
-                        selection.itemCount  = obj["itemCount"].toInt();
-                        selection.diamondJson = obj["diamondJson"].toString();
-                        selection.stoneJson   = obj["stoneJson"].toString();
-                        selection.pdf_path    = obj["pdf_path"].toString();   // restore pdf_path
-                        selections.append(selection);
-                    }
-                }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) return selections;
+
+    PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT cart_details FROM user_cart WHERE user_id = :userId");
+    query->bindValue(":userId", userId);
+
+    if (query->exec() && query->next()) {
+        QString cartJson = query->value(0).toString();
+        QJsonDocument doc = QJsonDocument::fromJson(cartJson.toUtf8());
+        if (doc.isArray()) {
+            QJsonArray cartArray = doc.array();
+            for (const QJsonValue &value : cartArray) {
+                QJsonObject obj = value.toObject();
+                SelectionData selection;
+                selection.imageId    = obj["imageId"].toInt();
+                selection.goldType   = obj["goldType"].toString();
+                selection.itemCount  = obj["itemCount"].toInt();
+                selection.diamondJson = obj["diamondJson"].toString();
+                selection.stoneJson   = obj["stoneJson"].toString();
+                selection.pdf_path    = obj["pdf_path"].toString();   // restore pdf_path
+                selections.append(selection);
             }
-        } // QSqlQuery destroyed here
-
-        db.close();
-    } // db destroyed
+        }
+    }
 
-    QSqlDatabase::removeDatabase(connectionName);
     return selections;
 }
 
 bool DatabaseUtils::saveUserCart(const QString &userId, const QList<SelectionData> &selections)
 {
-    const QString connName = QStringLiteral("save_cart_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
+    const QString dbPath = ConnectionPool::absolutePath(DbFile::Image);
+    if (!QFile::exists(dbPath)) {
+        qDebug() << "Error: Database file does not exist at path:" << dbPath;
+        return false;
+    }
 
-        QFile dbFile(dbPath);
-        if (!dbFile.exists()) {
-            qDebug() << "Error: Database file does not exist at path:" << dbPath;
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Error: Failed to open database:" << db.lastError().text();
+        return false;
+    }
+
+    // --- Check if table exists
+    {
+        QSqlQuery checkTableQuery(db);
+        checkTableQuery.prepare("SELECT name FROM sqlite_master WHERE type='table' AND name='user_cart'");
+        if (!checkTableQuery.exec() || !checkTableQuery.next()) {
+            qDebug() << "Error: user_cart table does not exist.";
             return false;
         }
+    }
 
-        if (!db.open()) {
-            qDebug() << "Error: Failed to open database:" << db.lastError().text();
+    // --- Check user exists
+    {
+        QSqlQuery userCheckQuery(db);
+        userCheckQuery.prepare("SELECT user_id FROM users WHERE user_id = :userId");
+        userCheckQuery.bindValue(":userId", userId);
+        if (!userCheckQuery.exec() || !userCheckQuery.next()) {
+            qDebug() << "Error: user_id" << userId << "does not exist in users table.";
             return false;
         }
+    }
 
-        // --- Check if table exists
-        {
-            QSqlQuery checkTableQuery(db);
-            checkTableQuery.prepare("SELECT name FROM sqlite_master WHERE type='table' AND name='user_cart'");
-            if (!checkTableQuery.exec() || !checkTableQuery.next()) {
-                qDebug() << "Error: user_cart table does not exist.";
-                return false;
-            }
-        }
+    if (selections.isEmpty()) {
+        QSqlQuery deleteQuery(db);
+        deleteQuery.prepare("DELETE FROM user_cart WHERE user_id = :userId");
+        deleteQuery.bindValue(":userId", userId);
 
-        // --- Check user exists
-        {
-            QSqlQuery userCheckQuery(db);
-            userCheckQuery.prepare("SELECT user_id FROM users WHERE user_id = :userId");
-            userCheckQuery.bindValue(":userId", userId);
-            if (!userCheckQuery.exec() || !userCheckQuery.next()) {
-                qDebug() << "Error: user_id" << userId << "does not exist in users table.";
-                return false;
-            }
+        if (!deleteQuery.exec()) {
+            qDebug() << "Error: Failed to delete empty cart for user:" << userId
+                     << deleteQuery.lastError().text();
+            return false;
         }
 
-        if (selections.isEmpty()) {
-            QSqlQuery deleteQuery(db);
-            deleteQuery.prepare("DELETE FROM user_cart WHERE user_id = :userId");
-            deleteQuery.bindValue(":userId", userId);
-
-            if (!deleteQuery.exec()) {
-                qDebug() << "Error: Failed to delete empty cart for user:" << userId
-                         << deleteQuery.lastError().text();
-                db.close();
-                QSqlDatabase::removeDatabase(connName);   // cleanup even on failure
-                return false;
-            }
-
-            db.close();
-            QSqlDatabase::removeDatabase(connName);   // cleanup on success
-            qDebug() << "Cart cleared for user:" << userId;
-            return true;
-        }
+        qDebug() << "Cart cleared for user:" << userId;
+        return true;
+    }
 
 
-        db.transaction();
+    db.transaction();
 
-        // --- Fetch existing pdf_path
-        QString pdfPathsJson = "[]";
-        {
-            QSqlQuery fetchQuery(db);
-            fetchQuery.prepare("SELECT pdf_path FROM user_cart WHERE user_id = :userId");
-            fetchQuery.bindValue(":userId", userId);
-            if (fetchQuery.exec() && fetchQuery.next()) {
-                pdfPathsJson = fetchQuery.value(0).toString();
-                if (pdfPathsJson.isEmpty()) pdfPathsJson = "[]";
-            }
+    // --- Fetch existing pdf_path
+    QString pdfPathsJson = "[]";
+    {
+        QSqlQuery fetchQuery(db);
+        fetchQuery.prepare("SELECT pdf_path FROM user_cart WHERE user_id = :userId");
+        fetchQuery.bindValue(":userId", userId);
+        if (fetchQuery.exec() && fetchQuery.next()) {
+            pdfPathsJson = fetchQuery.value(0).toString();
+            if (pdfPathsJson.isEmpty()) pdfPathsJson = "[]";
         }
+    }
 
-        // --- Parse existing JSON
-        QJsonArray pdfArray = QJsonDocument::fromJson(pdfPathsJson.toUtf8()).array();
-        QSet<QString> existingPaths;
-        QString currentTime = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
+    // --- Parse existing JSON
+    QJsonArray pdfArray = QJsonDocument::fromJson(pdfPathsJson.toUtf8()).array();
+    QSet<QString> existingPaths;
+    QString currentTime = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
 
-        for (const QJsonValue &val : pdfArray) {
-            QString path = val.toObject()["path"].toString();
-            if (!path.isEmpty()) {
-                existingPaths.insert(QDir::cleanPath(path));
-            }
+    for (const QJsonValue &val : pdfArray) {
+        QString path = val.toObject()["path"].toString();
+        if (!path.isEmpty()) {
+            existingPaths.insert(QDir::cleanPath(path));
         }
+    }
 
-        for (const SelectionData &selection : selections) {
-            if (!selection.pdf_path.isEmpty()) {
-                QString normPath = QDir::cleanPath(selection.pdf_path);
-                if (QFile::exists(normPath) && !existingPaths.contains(normPath)) {
-                    QJsonObject pdfEntry;
-                    pdfEntry["path"] = QDir::toNativeSeparators(normPath);
-                    pdfEntry["time"] = currentTime;
-                    pdfArray.append(pdfEntry);
-                    existingPaths.insert(normPath);
-                } else if (!QFile::exists(normPath)) {
-                    qDebug() << "Warning: PDF file does not exist:" << normPath;
-                }
+    for (const SelectionData &selection : selections) {
+        if (!selection.pdf_path.isEmpty()) {
+            QString normPath = QDir::cleanPath(selection.pdf_path);
+            if (QFile::exists(normPath) && !existingPaths.contains(normPath)) {
+                QJsonObject pdfEntry;
+                pdfEntry["path"] = QDir::toNativeSeparators(normPath);
+                pdfEntry["time"] = currentTime;
+                pdfArray.append(pdfEntry);
+                existingPaths.insert(normPath);
+            } else if (!QFile::exists(normPath)) {
+                qDebug() << "Warning: PDF file does not exist:" << normPath;
             }
         }
+    }
 
-        // --- Prepare cart JSON
-        QJsonArray cartArray;
-        for (const SelectionData &s : selections) {
-            QJsonObject obj;
-            obj["imageId"]     = s.imageId;
-            obj["goldType"]    = s.goldType;
-            obj["itemCount"]   = s.itemCount;
-            obj["diamondJson"] = s.diamondJson;  // store as string
-            obj["stoneJson"]   = s.stoneJson;    // store as string
-            obj["pdf_path"]    = s.pdf_path;     // also keep in cart JSON
-            cartArray.append(obj);
-        }
-        QString cartJson = QString(QJsonDocument(cartArray).toJson(QJsonDocument::Compact));
-
-        QString pdfJson = QString(QJsonDocument(pdfArray).toJson(QJsonDocument::Compact));
+    // --- Prepare cart JSON
+    QJsonArray cartArray;
+    for (const SelectionData &s : selections) {
+        QJsonObject obj;
+        obj["imageId"]     = s.imageId;
+        obj["goldType"]    = s.goldType;
+        obj["itemCount"]   = s.itemCount;
+        obj["diamondJson"] = s.diamondJson;  // store as string
+        obj["stoneJson"]   = s.stoneJson;    // store as string
+        obj["pdf_path"]    = s.pdf_path;     // also keep in cart JSON
+        cartArray.append(obj);
+    }
+    QString cartJson = QString(QJsonDocument(cartArray).toJson(QJsonDocument::Compact));
 
-        // --- Delete previous
-        {
-            QSqlQuery deleteQuery(db);
-            deleteQuery.prepare("DELETE FROM user_cart WHERE user_id = :userId");
-            deleteQuery.bindValue(":userId", userId);
-            if (!deleteQuery.exec()) {
-                qDebug() << "Error: Failed to delete from user_cart:" << deleteQuery.lastError().text();
-                db.rollback();
-                return false;
-            }
-        }
+    QString pdfJson = QString(QJsonDocument(pdfArray).toJson(QJsonDocument::Compact));
 
-        // --- Insert new
-        {
-            QSqlQuery insertQuery(db);
-            insertQuery.prepare("INSERT INTO user_cart (user_id, image_id, cart_details, pdf_path, time) "
-                                "VALUES (:userId, :imageId, :cartDetails, :pdfPath, :time)");
-            insertQuery.bindValue(":userId", userId);
-            insertQuery.bindValue(":imageId", selections.first().imageId);
-            insertQuery.bindValue(":cartDetails", cartJson);
-            insertQuery.bindValue(":pdfPath", pdfJson);
-            insertQuery.bindValue(":time", currentTime);
-
-            if (!insertQuery.exec()) {
-                qDebug() << "Error: Failed to insert into user_cart:" << insertQuery.lastError().text();
-                db.rollback();
-                return false;
-            }
+    // --- Delete previous
+    {
+        QSqlQuery deleteQuery(db);
+        deleteQuery.prepare("DELETE FROM user_cart WHERE user_id = :userId");
+        deleteQuery.bindValue(":userId", userId);
+        if (!deleteQuery.exec()) {
+            qDebug() << "Error: Failed to delete from user_cart:" << deleteQuery.lastError().text();
+            db.rollback();
+            return false;
         }
+    }
 
-        if (!db.commit()) {
-            qDebug() << "Error: Commit failed:" << db.lastError().text();
+    // --- Insert new
+    {
+        QSqlQuery insertQuery(db);
+        insertQuery.prepare("INSERT INTO user_cart (user_id, image_id, cart_details, pdf_path, time) "
+                            "VALUES (:userId, :imageId, :cartDetails, :pdfPath, :time)");
+        insertQuery.bindValue(":userId", userId);
+        insertQuery.bindValue(":imageId", selections.first().imageId);
+        insertQuery.bindValue(":cartDetails", cartJson);
+        insertQuery.bindValue(":pdfPath", pdfJson);
+        insertQuery.bindValue(":time", currentTime);
+
+        if (!insertQuery.exec()) {
+            qDebug() << "Error: Failed to insert into user_cart:" << insertQuery.lastError().text();
             db.rollback();
             return false;
         }
+    }
 
-        qDebug() << "Successfully saved cart for user:" << userId;
+    if (!db.commit()) {
+        qDebug() << "Error: Commit failed:" << db.lastError().text();
+        db.rollback();
+        return false;
     }
 
-    QSqlDatabase::removeDatabase(connName); // safe now
+    qDebug() << "Successfully saved cart for user:" << userId;
     return true;
 }
 
-QList<ImageRecord> DatabaseUtils::getAllItems()
+CatalogPage DatabaseUtils::fetchCatalogPage(int afterImageId, int limit)
 {
-    QList<ImageRecord> items;
-    const QString connName = QStringLiteral("get_all_items_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
+    CatalogPage page;
+    if (limit <= 0)
+        return page;
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Error: Could not open database for fetchCatalogPage:" << db.lastError().text();
+        return page;
+    }
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) {
-            qDebug() << "Error: Could not open database for getAllItems:" << db.lastError().text();
-            return items;
-        }
+    // Keyset on the primary key: every page is an index range scan, however deep
+    // One extra row tells whether another page follows
+    PooledQuery query = ConnectionPool::instance().prepare(db, R"(
+        SELECT image_id, design_no, image_path, company_name
+        FROM image_data
+        WHERE image_id > :afterId AND COALESCE("delete", 0) = 0
+        ORDER BY image_id
+        LIMIT :limit
+    )");
+    query->bindValue(":afterId", afterImageId);
+    query->bindValue(":limit", limit + 1);
 
-        {
-            QSqlQuery query(db);
-            query.prepare("SELECT image_id, image_path, image_type, design_no, company_name, gold_weight, diamond, stone, time, note FROM image_data");
-
-            if (query.exec()) {
-                while (query.next()) {
-                    ImageRecord record;
-                    record.imageId = query.value(0).toInt();
-                    record.imagePath = query.value(1).toString();
-                    record.imageType = query.value(2).toString();
-                    record.designNo = query.value(3).toString();
-                    record.companyName = query.value(4).toString();
-                    record.goldJson = query.value(5).toString();
-                    record.diamondJson = query.value(6).toString();
-                    record.stoneJson = query.value(7).toString();
-                    record.time = query.value(8).toString();
-                    record.note = query.value(9).toString();
-                    items.append(record);
-                }
-            } else {
-                qDebug() << "Error: Failed to execute query in getAllItems:" << query.lastError().text();
-            }
-        } // query destroyed here before db.close()
+    if (!query->exec()) {
+        qDebug() << "Error: Failed to execute query in fetchCatalogPage:" << query->lastError().text();
+        return page;
+    }
+
+    page.rows = RowMapper::readAll<CatalogHeader>(query.query(), limit + 1);
+    if (page.rows.size() > limit) {
+        page.rows.removeLast();
+        page.nextAfterId = page.rows.last().imageId;
+    }
+
+    return page;
+}
 
-        db.close();
+std::optional<ImageRecord> DatabaseUtils::fetchCatalogRecord(int imageId)
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Error: Could not open database for fetchCatalogRecord:" << db.lastError().text();
+        return std::nullopt;
     }
-    QSqlDatabase::removeDatabase(connName); // Safe to remove after scope ends
-    return items;
+
+    PooledQuery query = ConnectionPool::instance().prepare(db,
+        "SELECT image_id, image_path, image_type, design_no, company_name, gold_weight, diamond, stone, time, note "
+        "FROM image_data WHERE image_id = :imageId");
+    query->bindValue(":imageId", imageId);
+
+    if (!query->exec()) {
+        qDebug() << "Error: Failed to execute query in fetchCatalogRecord:" << query->lastError().text();
+        return std::nullopt;
+    }
+
+    const QList<ImageRecord> records = RowMapper::readAll<ImageRecord>(query.query(), 1);
+    if (records.isEmpty())
+        return std::nullopt;
+    return records.first();
 }
 
 QPixmap DatabaseUtils::fetchImagePixmap(int imageId)
 {
-    const QString connectionName = "image_pixmap_conn";
     QPixmap pixmap;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) {
-            qDebug() << "Failed to open DB for fetchImagePixmap:" << db.lastError().text();
-            return QPixmap(":/icon/placeholder.png");
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Failed to open DB for fetchImagePixmap:" << db.lastError().text();
+        return QPixmap(":/icon/placeholder.png");
+    }
 
-        {
-            QSqlQuery query(db);
-            query.prepare("SELECT image_path FROM image_data WHERE image_id = :imageId");
-            query.bindValue(":imageId", imageId);
-
-            if (query.exec() && query.next()) {
-                const QString imagePath = query.value(0).toString();
-                if (!imagePath.isEmpty() && QFile::exists(imagePath)) {
-                    if (!pixmap.load(imagePath)) {
-                        qWarning() << "Failed to load image from:" << imagePath;
-                    }
-                }
-            } else {
-                qDebug() << "No image path found for id:" << imageId << query.lastError().text();
-            }
-        } // query destroyed
+    PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT image_path FROM image_data WHERE image_id = :imageId");
+    query->bindValue(":imageId", imageId);
 
-        db.close();
-    } // db destroyed
+    if (query->exec() && query->next()) {
+        const QString imagePath = query->value(0).toString();
+        if (!imagePath.isEmpty() && QFile::exists(imagePath)) {
+            pixmap = ThumbnailCache::instance().pixmap(imagePath, ThumbnailCache::Small);
+            if (pixmap.isNull())
+                qWarning() << "Failed to load image from:" << imagePath;
+        }
+    } else {
+        qDebug() << "No image path found for id:" << imageId << query->lastError().text();
+    }
 
-    QSqlDatabase::removeDatabase(connectionName);
     return pixmap.isNull() ? QPixmap(":/icon/placeholder.png") : pixmap;
 }
 
+QList<CatalogHeader> DatabaseUtils::fetchCatalogHeaders(const QList<int> &imageIds)
+{
+    return readByImageIds<CatalogHeader>(imageIds,
+        "SELECT image_id, design_no, image_path, company_name FROM image_data WHERE image_id IN (%1)");
+}
+
 QString DatabaseUtils::fetchJsonData(int imageId, const QString &column)
 {
     if (column != "diamond" && column != "stone") {
@@ -1331,229 +1200,98 @@ QString DatabaseUtils::fetchJsonData(int imageId, const QString &column)
         return "[]";
     }
 
-    const QString connectionName = "fetch_json_conn";
     QString json = "[]";
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) {
-            qDebug() << "Error: Failed to open database for fetchJsonData:" << db.lastError().text();
-            return "[]";
-        }
-
-        {
-            QSqlQuery query(db);
-            query.prepare(QString("SELECT %1 FROM image_data WHERE image_id = :imageId").arg(column));
-            query.bindValue(":imageId", imageId);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "Error: Failed to open database for fetchJsonData:" << db.lastError().text();
+        return "[]";
+    }
 
-            if (query.exec() && query.next()) {
-                json = query.value(0).toString();
-            } else {
-                qDebug() << "No JSON data found for imageId =" << imageId << ", column =" << column;
-            }
-        }
+    PooledQuery query = ConnectionPool::instance().prepare(db, QString("SELECT %1 FROM image_data WHERE image_id = :imageId").arg(column));
+    query->bindValue(":imageId", imageId);
 
-        db.close();
+    if (query->exec() && query->next()) {
+        json = query->value(0).toString();
+    } else {
+        qDebug() << "No JSON data found for imageId =" << imageId << ", column =" << column;
     }
 
-    QSqlDatabase::removeDatabase(connectionName);
     return json.isEmpty() ? "[]" : json;
 }
 
 QPair<QString, QString> DatabaseUtils::fetchDiamondDetails(int imageId)
 {
-    const QString connectionName = "diamond_details_conn";
-    QString json, detailText;
-    double totalWeight = 0.0;
-    QMap<QString, double> weightByType;
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return {};
-
-        {
-            QSqlQuery query(db);
-            query.prepare("SELECT diamond FROM image_data WHERE image_id = :imageId");
-            query.bindValue(":imageId", imageId);
-
-            if (query.exec() && query.next()) {
-                json = query.value("diamond").toString();
-
-                // validate JSON before using
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8(), &parseError);
-                if (parseError.error != QJsonParseError::NoError || !doc.isArray()) {
-                    json.clear(); // avoid passing invalid JSON
-                } else {
-                    QJsonArray array = doc.array();
-
-                    for (const QJsonValue &value : array) {
-                        if (!value.isObject()) continue;
-
-                        QJsonObject obj = value.toObject();
-                        QString type = obj["type"].toString().trimmed().toLower();
-                        QString sizeMM = obj["sizeMM"].toString().trimmed();
-                        int quantity = obj["quantity"].toString().toInt();
-                        {
-                            QSqlQuery weightQuery(db);
-                            if (type == "round") {
-                                bool ok;
-                                double sizeMMValue = sizeMM.toDouble(&ok);
-                                if (!ok) continue;
-
-                                weightQuery.prepare(R"(
-                                    SELECT weight FROM Round_diamond
-                                    WHERE ABS(sizeMM - :sizeMM) =
-                                        (SELECT MIN(ABS(sizeMM - :sizeMM)) FROM Round_diamond)
-                                )");
-                                weightQuery.bindValue(":sizeMM", sizeMMValue);
-                            } else {
-                                weightQuery.prepare("SELECT weight FROM Fancy_diamond WHERE LOWER(shape) = LOWER(:type) AND sizeMM = :sizeMM");
-                                weightQuery.bindValue(":type", type);
-                                weightQuery.bindValue(":sizeMM", sizeMM);
-                            }
-
-                            if (weightQuery.exec() && weightQuery.next()) {
-                                double weightPerDiamond = weightQuery.value("weight").toDouble();
-                                double totalWeightForEntry = quantity * weightPerDiamond;
-                                // qDebug()<<quantity<<weightPerDiamond;///////
-                                weightByType[type] += totalWeightForEntry;
-                                totalWeight += totalWeightForEntry;
-                                // qDebug()<<totalWeight;
-                            }
-                        } // weightQuery destroyed here
-                    }
-                    // qDebug()<<json<<"-----"<<detailText;
-                    for (auto it = weightByType.constBegin(); it != weightByType.constEnd(); ++it) {
-                        // qDebug()<<it;
-                        // qDebug()<<it.key()<<it.value();
-                        detailText += QString("%1\t\t%2ct\n").arg(it.key(), -10).arg(it.value(), 0, 'f', 2);
-                    }
-                }
-            }
-        } // outer query destroyed
-
-        db.close();
-    } // QSqlDatabase destroyed
-
-    QSqlDatabase::removeDatabase(connectionName);
-
-    return {json, detailText};
+    return fetchPieceDetails(imageId, "diamond");
 }
 
 QPair<QString, QString> DatabaseUtils::fetchStoneDetails(int imageId)
 {
-    const QString connectionName = "stone_details_conn";
+    return fetchPieceDetails(imageId, "stone");
+}
+
+QPair<QString, QString> DatabaseUtils::fetchPieceDetails(int imageId, const QString &type)
+{
     QString json, detailText;
-    double totalWeight = 0.0;
     QMap<QString, double> weightByType;
+    const bool isDiamond = (type == "diamond");
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return {};
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) return {};
 
-        {
-            QSqlQuery query(db);
-            query.prepare("SELECT stone FROM image_data WHERE image_id = :imageId");
-            query.bindValue(":imageId", imageId);
-
-            if (query.exec() && query.next()) {
-                json = query.value("stone").toString();
-
-                // validate JSON before using
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8(), &parseError);
-                if (parseError.error == QJsonParseError::NoError && doc.isArray()) {
-                    QJsonArray array = doc.array();
-
-                    for (const QJsonValue &value : array) {
-                        if (!value.isObject()) continue;
-
-                        QJsonObject obj = value.toObject();
-                        QString type = obj["type"].toString().trimmed().toLower();
-                        QString sizeMM = obj["sizeMM"].toString().trimmed();
-                        int quantity = obj["quantity"].toString().toInt(); // simpler & safer
-
-                        {
-                            QSqlQuery weightQuery(db);
-                            weightQuery.prepare("SELECT weight FROM stones WHERE LOWER(shape) = LOWER(:shape) AND sizeMM = :sizeMM");
-                            weightQuery.bindValue(":shape", type);
-                            weightQuery.bindValue(":sizeMM", sizeMM);
-
-                            if (weightQuery.exec() && weightQuery.next()) {
-                                double weightPerStone = weightQuery.value("weight").toDouble();
-                                double totalWeightForEntry = quantity * weightPerStone;
-                                weightByType[type] += totalWeightForEntry;
-                                totalWeight += totalWeightForEntry;
-                            }
-                        } // weightQuery destroyed here
-                    }
-
-                    for (auto it = weightByType.constBegin(); it != weightByType.constEnd(); ++it) {
-                        detailText += QString("%1\t\t%2ct\n").arg(it.key(), -10).arg(it.value(), 0, 'f', 2);
-                    }
-                } else {
-                    json.clear(); // don't store bad JSON
-                }
-            }
-        } // query destroyed
+    // JSON text for the detail views comes from the compatibility view so it always
+    // matches the child rows the totals are computed from
+    PooledQuery query = ConnectionPool::instance().prepare(db,
+        QString("SELECT %1 FROM catalog_json WHERE image_id = :imageId").arg(isDiamond ? "diamond" : "stone"));
+    query->bindValue(":imageId", imageId);
+    if (!query->exec() || !query->next())
+        return {};
+    json = query->value(0).toString();
+
+    ReferenceDataCache &refData = ReferenceDataCache::instance();
+    for (const CatalogPiece &piece : fetchCatalogPieces({imageId}, type)) {
+        const QString pieceType = piece.type.trimmed().toLower();
+        const bool isRound = isDiamond && pieceType == "round";
+        bool ok = true;
+        const double sizeMMValue = isRound ? piece.sizeMM.trimmed().toDouble(&ok) : 0.0;
+        if (!ok) continue;
+
+        // Round sizes snap to the closest listed size; fancy and stone sizes may be text
+        const std::optional<double> weightPerPiece = !isDiamond ? refData.stoneWeight(pieceType, piece.sizeMM)
+                                                    : isRound   ? refData.nearestRoundWeight(sizeMMValue)
+                                                                : refData.fancyWeight(pieceType, piece.sizeMM);
+        if (weightPerPiece)
+            weightByType[pieceType] += piece.quantity * *weightPerPiece;
+    }
 
-        db.close();
-    } // db destroyed
+    for (auto it = weightByType.constBegin(); it != weightByType.constEnd(); ++it)
+        detailText += QString("%1\t\t%2ct\n").arg(it.key(), -10).arg(it.value(), 0, 'f', 2);
 
-    QSqlDatabase::removeDatabase(connectionName);
     return {json, detailText};
 }
 
-double DatabaseUtils::calculateTotalGoldWeight(const QList<SelectionData> &selections)
+QList<CatalogPiece> DatabaseUtils::fetchCatalogPieces(const QList<int> &imageIds, const QString &type)
 {
-    const QString connectionName = "gold_weight_conn";
-    double totalGoldWeight = 0.0;
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return 0.0;
-
-        QHash<int, QString> goldCache;
-        QSqlQuery query(db);
+    // Table names cannot be bound, so only the two piece tables are accepted
+    if (type != "diamond" && type != "stone") {
+        qWarning() << "[ERROR] fetchCatalogPieces: unsupported type" << type;
+        return {};
+    }
 
-        for (const SelectionData &selection : selections) {
-            if (!goldCache.contains(selection.imageId)) {
-                query.prepare("SELECT gold_weight FROM image_data WHERE image_id = :imageId");
-                query.bindValue(":imageId", selection.imageId);
-                if (query.exec() && query.next()) {
-                    goldCache[selection.imageId] = query.value(0).toString();
-                }
-            }
+    return readByImageIds<CatalogPiece>(imageIds,
+        QString("SELECT image_id, type, size_mm, quantity FROM catalog_%1 WHERE image_id IN (%2) ORDER BY image_id, seq")
+            .arg(type, "%1"));
+}
 
-            QString goldWeightJson = goldCache.value(selection.imageId);
-            QJsonDocument doc = QJsonDocument::fromJson(goldWeightJson.toUtf8());
-            if (doc.isArray()) {
-                for (const QJsonValue &value : doc.array()) {
-                    QJsonObject obj = value.toObject();
-                    if (obj["karat"].toString() == selection.goldType) {
-                        totalGoldWeight += obj["weight(g)"].toString().toDouble() * selection.itemCount;
-                        break;
-                    }
-                }
-            }
-        }
+QList<CatalogGold> DatabaseUtils::fetchCatalogGold(const QList<int> &imageIds)
+{
+    return readByImageIds<CatalogGold>(imageIds,
+        "SELECT image_id, karat, weight FROM catalog_gold WHERE image_id IN (%1) ORDER BY image_id, seq");
+}
 
-        db.close();
-    }
-    QSqlDatabase::removeDatabase(connectionName);
-    return totalGoldWeight;
+QList<double> DatabaseUtils::resolveWeights(const QList<WeightKey> &keys)
+{
+    return ReferenceDataCache::instance().weights(keys);
 }
 
 QJsonObject DatabaseUtils::parseGoldJson(const QString &goldJson)
@@ -1593,228 +1331,27 @@ QJsonArray DatabaseUtils::parseJsonArray(const QString &json)
     return doc.isArray() ? doc.array() : QJsonArray();
 }
 
-void DatabaseUtils::updateSummaryTable(QTableWidget *table, const QList<SelectionData> &selections, const QString &type)
-{
-    QStringList headers = {"Shape/Type", "SizeMM", "Quantity", "Weight", "Total Weight"};
-    table->setColumnCount(headers.size());
-    table->setHorizontalHeaderLabels(headers);
-    table->horizontalHeader()->setVisible(true);
-    table->horizontalHeader()->setStyleSheet("QHeaderView::section { background-color: black; color: white; font-weight: bold; font-size: 14px; }");
-    table->setRowCount(0);
-
-    QMap<QPair<QString, QString>, QPair<int, double>> aggregates;
-    const QString connectionName = "summary_table_conn";
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-        if (!db.open()) return;
-
-        {
-            for (const SelectionData &selection : selections) {
-                QSqlQuery query(db);
-                query.prepare(QString("SELECT %1 FROM image_data WHERE image_id = :imageId").arg(type));
-                query.bindValue(":imageId", selection.imageId);
-                if (query.exec() && query.next()) {
-                    QString json = query.value(0).toString();
-                    QJsonArray array = parseJsonArray(json);
-                    for (const QJsonValue &value : array) {
-                        QJsonObject obj = value.toObject();
-                        int baseQuantity = obj["quantity"].toString().toInt();
-                        int adjustedQuantity = baseQuantity * selection.itemCount;
-                        QString sizeMMStr = obj["sizeMM"].toString();
-                        QString shape = obj["type"].toString();
-
-                        double singleWeight = 0.0;
-
-                        {
-                            QSqlQuery weightQuery(db);
-                            if (type == "diamond") {
-                                QString tableName = (shape == "Round") ? "Round_diamond" : "Fancy_diamond";
-                                if (shape == "Round") {
-                                    double sizeMM = sizeMMStr.toDouble();
-                                    weightQuery.prepare("SELECT weight FROM Round_diamond WHERE sizeMM = :sizeMM");
-                                    weightQuery.bindValue(":sizeMM", sizeMM);
-                                } else {
-                                    weightQuery.prepare("SELECT weight FROM Fancy_diamond WHERE shape = :shape AND sizeMM = :sizeMM");
-                                    weightQuery.bindValue(":shape", shape);
-                                    weightQuery.bindValue(":sizeMM", sizeMMStr);
-                                }
-                            } else {
-                                weightQuery.prepare("SELECT weight FROM stones WHERE shape = :shape AND sizeMM = :sizeMM");
-                                weightQuery.bindValue(":shape", shape);
-                                weightQuery.bindValue(":sizeMM", sizeMMStr);
-                            }
-
-                            if (weightQuery.exec() && weightQuery.next()) {
-                                singleWeight = weightQuery.value("weight").toDouble();
-                            }
-                        } // weightQuery destroyed here
-
-                        QPair<QString, QString> key(shape, sizeMMStr);
-                        QPair<int, double> &aggregate = aggregates[key];
-                        aggregate.first += adjustedQuantity;
-                        aggregate.second += singleWeight * adjustedQuantity;
-                    }
-                }
-            }
-        } // all QSqlQuery destroyed here
-
-        db.close(); // optional
-    } // db destroyed here
-
-    QSqlDatabase::removeDatabase(connectionName); // now safe
-
-    // Fill table
-    int totalQuantity = 0;
-    double totalWeight = 0.0;
-
-    for (auto it = aggregates.begin(); it != aggregates.end(); ++it) {
-        QString shape = it.key().first;
-        QString sizeMMStr = it.key().second;
-        int rowQuantity = it.value().first;
-        double rowTotalWeight = it.value().second;
-        double singleWeight = rowQuantity > 0 ? rowTotalWeight / rowQuantity : 0.0;
-
-        int row = table->rowCount();
-        table->insertRow(row);
-        table->setItem(row, 0, new QTableWidgetItem(shape));
-        table->setItem(row, 1, new QTableWidgetItem(sizeMMStr));
-        table->setItem(row, 2, new QTableWidgetItem(QString::number(rowQuantity)));
-        table->setItem(row, 3, new QTableWidgetItem(QString::number(singleWeight, 'f', 3) + "ct"));
-        table->setItem(row, 4, new QTableWidgetItem(QString::number(rowTotalWeight, 'f', 3) + "ct"));
-
-        totalQuantity += rowQuantity;
-        totalWeight += rowTotalWeight;
-    }
-
-    if (table->rowCount() > 0) {
-        int totalRow = table->rowCount();
-        table->insertRow(totalRow);
-        table->setItem(totalRow, 0, new QTableWidgetItem("Total"));
-        table->setItem(totalRow, 2, new QTableWidgetItem(QString::number(totalQuantity)));
-        table->setItem(totalRow, 4, new QTableWidgetItem(QString::number(totalWeight, 'f', 3) + "ct"));
-    }
-
-    table->resizeColumnsToContents();
-    table->resizeRowsToContents();
-}
-
 
 //AddCatalog Logic
 QStringList DatabaseUtils::fetchShapes(const QString &tableType)
 {
-    const QString connectionName = "shapes_conn";
-    QStringList shapes;
-
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) {
-        QSqlDatabase::removeDatabase(connectionName);
-        return {};
-    }
-
-    {
-        QSqlQuery query(db);
-        QString queryStr = (tableType == "diamond")
-                               ? "SELECT DISTINCT shape FROM Fancy_diamond UNION SELECT 'Round' FROM Round_diamond"
-                               : "SELECT DISTINCT shape FROM stones";
-
-        if (!query.exec(queryStr)) {
-            db.close();
-            QSqlDatabase::removeDatabase(connectionName);
-            return {};
-        }
-
-        while (query.next()) {
-            shapes.append(query.value(0).toString());
-        }
-    }
-
-    db.close();
-    QSqlDatabase::removeDatabase(connectionName);
-    return shapes;
+    return (tableType == "diamond") ? ReferenceDataCache::instance().diamondShapes()
+                                    : ReferenceDataCache::instance().stoneShapes();
 }
 
 QStringList DatabaseUtils::fetchSizes(const QString &tableType, const QString &shape)
 {
-    const QString connectionName = "sizes_conn";
-    QStringList sizes;
-
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) {
-        QSqlDatabase::removeDatabase(connectionName);
-        return {};
-    }
-
-    {
-        QSqlQuery query(db);
-
-        if (tableType == "diamond") {
-            if (shape == "Round") {
-                query.prepare("SELECT DISTINCT sizeMM FROM Round_diamond ORDER BY sizeMM");
-            } else {
-                query.prepare("SELECT DISTINCT sizeMM FROM Fancy_diamond WHERE shape = :shape ORDER BY sizeMM");
-                query.bindValue(":shape", shape);
-            }
-        } else {
-            query.prepare("SELECT DISTINCT sizeMM FROM stones WHERE shape = :shape ORDER BY sizeMM");
-            query.bindValue(":shape", shape);
-        }
-
-        if (!query.exec()) {
-            db.close();
-            QSqlDatabase::removeDatabase(connectionName);
-            return {};
-        }
-
-        while (query.next()) {
-            sizes.append(query.value(0).toString());
-        }
-    }
-
-    db.close();
-    QSqlDatabase::removeDatabase(connectionName);
-    return sizes;
+    ReferenceDataCache &refData = ReferenceDataCache::instance();
+    if (tableType == "diamond")
+        return (shape == "Round") ? refData.roundSizes() : refData.fancySizes(shape);
+    return refData.stoneSizes(shape);
 }
 
 QString DatabaseUtils::saveImage(const QString &imagePath)
 {
-    QFileInfo sourceInfo(imagePath);
-    if (!sourceInfo.exists()) {
-        qWarning() << "Source image does not exist:" << imagePath;
-        return {};
-    }
-
-    // 1. Get the file extension (e.g., "jpg", "png")
-    QString extension = sourceInfo.suffix();
-
-    // 2. Generate a new, unique filename using a UUID
-    // Example result: "67c9a2e65a5c4c6d979953a1a632b70d.jpg"
-    QString uniqueName = QUuid::createUuid().toString(QUuid::WithoutBraces) + "." + extension;
-
-    // 3. Construct the full destination path where the file will be saved
-    QString targetDir = QDir(QCoreApplication::applicationDirPath()).filePath("images");
-    QDir().mkpath(targetDir); // Ensure the directory exists
-    QString newImagePath = QDir(targetDir).filePath(uniqueName);
-
-    // 4. Perform the copy operation
-    if (!QFile::copy(imagePath, newImagePath)) {
-        qWarning() << "Failed to copy image from" << imagePath << "to" << newImagePath;
-        return {};
-    }
-
-    // 5. MODIFIED: Return the relative path in the exact format "images/filename.type"
-    // The filename here is our new unique filename.
-
-    return "images/" + uniqueName;
+    // Oriented, size-capped and stored once per content; the returned path is relative to
+    // the application directory, e.g. "images/store/3f/3f2a...c9.jpg"
+    return ImageIngest::ingest(imagePath);
 }
 
 // bool DatabaseUtils::insertCatalogData(const QString &imagePath, const QString &imageType, const QString &designNo,
@@ -1876,84 +1413,70 @@ QString DatabaseUtils::insertCatalogData(const QString &imagePath, const QString
                                               const QJsonArray &diamondArray, const QJsonArray &stoneArray,
                                               const QString &note)
 {
-    const QString connectionName = "insert_conn";
     QString success ;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath())
-                             .filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            QSqlDatabase::removeDatabase(connectionName);
-            return "error";
-        }
-
-        QJsonDocument goldDoc(goldArray);
-        QJsonDocument diamondDoc(diamondArray);
-        QJsonDocument stoneDoc(stoneArray);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) return "error";
 
-        // --- Check if designNo exists ---
-        bool exists = false;
-        {
-            QSqlQuery checkQuery(db);
-            checkQuery.prepare("SELECT COUNT(*) FROM image_data WHERE design_no = :design_no AND \"delete\" = 0");
-            checkQuery.bindValue(":design_no", designNo);
+    QJsonDocument goldDoc(goldArray);
+    QJsonDocument diamondDoc(diamondArray);
+    QJsonDocument stoneDoc(stoneArray);
 
-            if (checkQuery.exec() && checkQuery.next()) {
-                exists = (checkQuery.value(0).toInt() > 0);
-            } else {
-                qDebug() << "Check designNo failed:" << checkQuery.lastError().text();
-            }
-        }
+    // --- Check if designNo exists ---
+    bool exists = false;
+    {
+        PooledQuery checkQuery = ConnectionPool::instance().prepare(db, "SELECT COUNT(*) FROM image_data WHERE design_no = :design_no AND \"delete\" = 0");
+        checkQuery->bindValue(":design_no", designNo);
 
-        QSqlQuery query(db);
-        if (exists) {
-            // --- UPDATE existing record ---
-            success = "modify" ;
-            query.prepare(R"(
-                UPDATE image_data SET
-                    image_path = :image_path,
-                    image_type = :image_type,
-                    company_name = :company_name,
-                    gold_weight = :gold_weight,
-                    diamond = :diamond,
-                    stone = :stone,
-                    time = :time,
-                    note = :note
-                WHERE design_no = :design_no
-            )");
+        if (checkQuery->exec() && checkQuery->next()) {
+            exists = (checkQuery->value(0).toInt() > 0);
         } else {
-            // --- INSERT new record ---
-            success = "insert" ;
-            query.prepare(R"(
-                INSERT INTO image_data
-                    (image_path, image_type, design_no, company_name, gold_weight, diamond, stone, time, note)
-                VALUES
-                    (:image_path, :image_type, :design_no, :company_name, :gold_weight, :diamond, :stone, :time, :note)
-            )");
+            qDebug() << "Check designNo failed:" << checkQuery->lastError().text();
         }
+    }
 
-        query.bindValue(":image_path", imagePath);
-        query.bindValue(":image_type", imageType);
-        query.bindValue(":design_no", designNo);
-        query.bindValue(":company_name", companyName);
-        query.bindValue(":gold_weight", goldDoc.toJson(QJsonDocument::Compact));
-        query.bindValue(":diamond", diamondDoc.toJson(QJsonDocument::Compact));
-        query.bindValue(":stone", stoneDoc.toJson(QJsonDocument::Compact));
-        query.bindValue(":time", QDateTime::currentDateTime().toString(Qt::ISODate));
-        query.bindValue(":note", note);
-
-        if (!query.exec()) {
-            qDebug() << (exists ? "Update failed:" : "Insert failed:") << query.lastError().text();
-            success = "error" ;
-        }
+    QSqlQuery query(db);
+    if (exists) {
+        // --- UPDATE existing record ---
+        success = "modify" ;
+        query.prepare(R"(
+            UPDATE image_data SET
+                image_path = :image_path,
+                image_type = :image_type,
+                company_name = :company_name,
+                gold_weight = :gold_weight,
+                diamond = :diamond,
+                stone = :stone,
+                time = :time,
+                note = :note
+            WHERE design_no = :design_no
+        )");
+    } else {
+        // --- INSERT new record ---
+        success = "insert" ;
+        query.prepare(R"(
+            INSERT INTO image_data
+                (image_path, image_type, design_no, company_name, gold_weight, diamond, stone, time, note)
+            VALUES
+                (:image_path, :image_type, :design_no, :company_name, :gold_weight, :diamond, :stone, :time, :note)
+        )");
+    }
 
-        db.close();
+    query.bindValue(":image_path", imagePath);
+    query.bindValue(":image_type", imageType);
+    query.bindValue(":design_no", designNo);
+    query.bindValue(":company_name", companyName);
+    query.bindValue(":gold_weight", goldDoc.toJson(QJsonDocument::Compact));
+    query.bindValue(":diamond", diamondDoc.toJson(QJsonDocument::Compact));
+    query.bindValue(":stone", stoneDoc.toJson(QJsonDocument::Compact));
+    query.bindValue(":time", QDateTime::currentDateTime().toString(Qt::ISODate));
+    query.bindValue(":note", note);
+
+    if (!query.exec()) {
+        qDebug() << (exists ? "Update failed:" : "Insert failed:") << query.lastError().text();
+        success = "error" ;
     }
 
-    QSqlDatabase::removeDatabase(connectionName);
     return success;
 }
 
@@ -2022,217 +1545,34 @@ QJsonArray DatabaseUtils::buildStoneArray(const QList<QVariantMap> &stoneRows, c
 
 
 
-bool DatabaseUtils::excelBulkInsertCatalog(const QString &filePath)
-{
-    QXlsx::Document xlsx(filePath);
-    if (!xlsx.load()) {
-        qWarning() << "[WARNING] Failed to load Excel: " << filePath;
-        return false;
-    }
-
-    // 1. Read Add_Catalog Sheet
-    if (!xlsx.selectSheet("Add_Catalog")) {
-        qWarning() << "Add_Catalog sheet not found";
-        return false;
-    }
-
-    QMap<QString, QJsonObject> catalogMap; // design_no -> base object
-    int row = 2; // assuming row 1 is headers
-    while (!xlsx.read(row, 1).toString().isEmpty()) {
-        QString designNo = xlsx.read(row, 1).toString();
-        QJsonObject catalog;
-        catalog["designNo"]    = designNo;
-        catalog["type"]        = xlsx.read(row, 2).toString();
-        catalog["companyName"] = xlsx.read(row, 3).toString();
-        catalog["goldKt"]      = xlsx.read(row, 4).toInt();
-        catalog["goldWeight"]  = xlsx.read(row, 5).toDouble();
-        catalog["imagePath"]   = xlsx.read(row, 6).toString();
-        catalog["note"]        = xlsx.read(row, 7).toString();
-        catalog["diamond"]     = QJsonArray();
-        catalog["stone"]       = QJsonArray();
-        catalogMap[designNo]   = catalog;
-        row++;
-    }
-
-    // 2. Read Add_Diamond Sheet
-    if (xlsx.selectSheet("Add_Diamond")) {
-        row = 2;
-        while (!xlsx.read(row, 1).toString().isEmpty()) {
-            QString designNo = xlsx.read(row, 1).toString();
-            if (!catalogMap.contains(designNo)) {
-                row++;
-                continue;
-            }
-
-            QJsonArray arr = catalogMap[designNo]["diamond"].toArray();
-            QJsonObject diamond;
-            diamond["type"]     = xlsx.read(row, 2).toString();
-            diamond["sizeMM"]   = xlsx.read(row, 3).toString();
-            diamond["quantity"] = xlsx.read(row, 4).toString();
-            arr.append(diamond);
-            catalogMap[designNo]["diamond"] = arr;
-
-            row++;
-        }
-    }
-
-    // 3. Read Add_Stone Sheet
-    if (xlsx.selectSheet("Add_Stone")) {
-        row = 2;
-        while (!xlsx.read(row, 1).toString().isEmpty()) {
-            QString designNo = xlsx.read(row, 1).toString();
-            if (!catalogMap.contains(designNo)) {
-                row++;
-                continue;
-            }
-
-            QJsonArray arr = catalogMap[designNo]["stone"].toArray();
-            QJsonObject stone;
-            stone["type"]     = xlsx.read(row, 2).toString();
-            stone["sizeMM"]   = xlsx.read(row, 3).toString();
-            stone["quantity"] = xlsx.read(row, 4).toString();
-            arr.append(stone);
-            catalogMap[designNo]["stone"] = arr;
-
-            row++;
-        }
-    }
-
-    // 4. Insert All Into DB
-    const QString connName = QStringLiteral("bulk_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-    db.setDatabaseName(dbPath);
+bool DatabaseUtils::userLoginValidate(const QString &userId, const QString &passwd) {
+    QString userStoredPasswd;
 
-    if (!db.open()) {
-        qWarning() << "DB open failed";
-        QSqlDatabase::removeDatabase(connName);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open authentication DB:" << db.lastError().text();
         return false;
     }
 
-    QSqlQuery query(db);
-    db.transaction(); // bulk insert = faster
-
-    for (auto it = catalogMap.begin(); it != catalogMap.end(); ++it) {
-        const QJsonObject &catalog = it.value();
-
-        QJsonArray diamondArray = catalog["diamond"].toArray();
-        QJsonArray stoneArray   = catalog["stone"].toArray();
-        QJsonArray goldArray    = DatabaseUtils::generateGoldWeights(
-            catalog["goldKt"].toInt(),
-            catalog["goldWeight"].toDouble()
-            );
-
-        QJsonDocument goldDoc(goldArray);
-        QJsonDocument diamondDoc(diamondArray);
-        QJsonDocument stoneDoc(stoneArray);
-
-        QString designNo = catalog["designNo"].toString() ;
-
-        // Check if design already exists
-
-        QSqlQuery checkQuery(db) ;
-        checkQuery.prepare("SELECT COUNT(*) FROM image_data WHERE design_no = :design_no") ;
-        checkQuery.bindValue(":design_no", designNo) ;
-
-        if (!checkQuery.exec()){
-            qWarning() << "Check query failed: " << checkQuery.lastError().text() ;
-            continue ;
-        }
-
-        checkQuery.next() ;
-        bool designNoExists = checkQuery.value(0).toInt() > 0 ;
-        if (designNoExists) {
-            // Update design values
-            query.prepare(R"(
-                UPDATE image_data
-                SET image_path = :image_path,
-                    image_type = :image_type,
-                    company_name = :company_name,
-                    gold_weight = :gold_weight,
-                    diamond = :diamond,
-                    stone = :stone,
-                    note = :note,
-                    time = :time
-                WHERE design_no = :design_no
-            )") ;
-        }else {
-            // Insert new design
-            query.prepare(R"(
-                INSERT INTO image_data
-                (image_path, image_type, design_no, company_name, gold_weight, diamond, stone, time, note)
-                VALUES (:image_path, :image_type, :design_no, :company_name, :gold_weight, :diamond, :stone, :time, :note)
-            )");
-        }
-
-
-        query.bindValue(":image_path", catalog["imagePath"].toString());
-        query.bindValue(":image_type", catalog["type"].toString());
-        query.bindValue(":design_no", catalog["designNo"].toString());
-        query.bindValue(":company_name", catalog["companyName"].toString());
-        query.bindValue(":gold_weight", goldDoc.toJson(QJsonDocument::Compact));
-        query.bindValue(":diamond", diamondDoc.toJson(QJsonDocument::Compact));
-        query.bindValue(":stone", stoneDoc.toJson(QJsonDocument::Compact));
-        query.bindValue(":time", QDateTime::currentDateTime().toString(Qt::ISODate));
-        query.bindValue(":note", catalog["note"].toString());
-
-        if (!query.exec()) {
-            if (designNoExists) {
-                qWarning() << "[ERROR] Bulk update failed for design " << catalog["designNo"].toString() << ":" << query.lastError().text(); ;
-            }else {
-                qWarning() << "[ERROR] Bulk insert failed for design " << catalog["designNo"].toString() << ":" << query.lastError().text();
-            }
-        }
-    }
-
-    db.commit();
-    db.close();
-    QSqlDatabase::removeDatabase(connName);
-
-    return true;
-}
-
-
-bool DatabaseUtils::userLoginValidate(const QString &userId, const QString &passwd) {
-    QString dbPath = QDir(QCoreApplication::applicationDirPath())
-        .filePath("database/mega_mine_image.db");
-    QString connName = QStringLiteral("auth_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-
-    QString userStoredPasswd;
-
     {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open authentication DB:" << db.lastError().text();
-            return false;
-        }
-
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                SELECT password
-                FROM users
-                WHERE user_id = :id
-            )");
-            query.bindValue(":id", userId);
+        QSqlQuery query(db);
+        query.prepare(R"(
+            SELECT password
+            FROM users
+            WHERE user_id = :id
+        )");
+        query.bindValue(":id", userId);
 
-            if (query.exec()) {
-                if (query.next()) {
-                    userStoredPasswd = query.value(0).toString();
-                }
-            } else {
-                qDebug() << "[ERROR] Login query error:" << query.lastError().text();
-                return false;
+        if (query.exec()) {
+            if (query.next()) {
+                userStoredPasswd = query.value(0).toString();
             }
+        } else {
+            qDebug() << "[ERROR] Login query error:" << query.lastError().text();
+            return false;
         }
-
-        db.close();
     }
 
-    QSqlDatabase::removeDatabase(connName);
-
     return (!userStoredPasswd.isEmpty() && passwd == userStoredPasswd);
 }
 
@@ -2240,242 +1580,177 @@ bool DatabaseUtils::userLoginValidate(const QString &userId, const QString &pass
 LoginResult DatabaseUtils::authenticateUser(const QString &userId, const QString &password)
 {
     LoginResult result;
-    QString dbPath = QDir(QCoreApplication::applicationDirPath())
-                         .filePath("database/luxeMineAuthentication.db");
-
-    // Unique connection name
-    QString connName = QStringLiteral("auth_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
 
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open authentication DB: " << db.lastError().text();
-            return result;
-        }
-
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                SELECT userName, role
-                FROM OrderBook_Login
-                WHERE userId = :id AND password = :pwd
-            )");
-            query.bindValue(":id", userId);
-            query.bindValue(":pwd", password);
-
-            if (query.exec() && query.next()) {
-                result.success = true;
-                result.userName = query.value("userName").toString();
-                result.role = query.value("role").toString();
-            } else if (query.lastError().isValid()) {
-                qDebug() << "[ERROR] Login query error:" << query.lastError().text();
-            }
-        } // query destroyed
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Authentication);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open authentication DB: " << db.lastError().text();
+        return result;
+    }
 
-        db.close();
-    } // db destroyed
+    QSqlQuery query(db);
+    query.prepare(R"(
+        SELECT userName, role
+        FROM OrderBook_Login
+        WHERE userId = :id AND password = :pwd
+    )");
+    query.bindValue(":id", userId);
+    query.bindValue(":pwd", password);
+
+    if (query.exec() && query.next()) {
+        result.success = true;
+        result.userName = query.value("userName").toString();
+        result.role = query.value("role").toString();
+    } else if (query.lastError().isValid()) {
+        qDebug() << "[ERROR] Login query error:" << query.lastError().text();
+    }
 
-    QSqlDatabase::removeDatabase(connName); // safe cleanup
     return result;
 }
 
 QStringList DatabaseUtils::fetchPartyNamesForUser(const QString &userId)
 {
     QStringList partyList;
-    QString dbPath = QDir(QCoreApplication::applicationDirPath())
-                         .filePath("database/luxeMineAuthentication.db");
-
-    // Use a unique connection name to avoid conflicts
-    QString connName = QString("fetch_party_conn_%1").arg(QDateTime::currentMSecsSinceEpoch());
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
 
-        if (!db.open()) {
-            qDebug() << "Database connection failed for user:" << userId
-                     << "Error:" << db.lastError().text();
-            return partyList;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Authentication);
+    if (!db.isOpen()) {
+        qDebug() << "Database connection failed for user:" << userId
+                 << "Error:" << db.lastError().text();
+        return partyList;
+    }
 
-        QSqlQuery query(db);
-        query.prepare("SELECT name, id FROM Partys WHERE userId = :uid");
-        query.bindValue(":uid", userId);
+    QSqlQuery query(db);
+    query.prepare("SELECT name, id FROM Partys WHERE userId = :uid");
+    query.bindValue(":uid", userId);
 
-        if (!query.exec()) {
-            qDebug() << "Query failed for user:" << userId
-                     << "Error:" << query.lastError().text();
-        } else {
-            partyList.append("-");
-            while (query.next()) {
-                QString name = query.value(0).toString();
-                QString id = query.value(1).toString();
-                partyList.append(QString("%1 (%2)").arg(name, id));
-            }
+    if (!query.exec()) {
+        qDebug() << "Query failed for user:" << userId
+                 << "Error:" << query.lastError().text();
+    } else {
+        partyList.append("-");
+        while (query.next()) {
+            QString name = query.value(0).toString();
+            QString id = query.value(1).toString();
+            partyList.append(QString("%1 (%2)").arg(name, id));
         }
-    } // db + query go out of scope here
+    }
 
-    QSqlDatabase::removeDatabase(connName); // safe: query already destroyed
     return partyList;
 }
 
 bool DatabaseUtils::insertParty(const PartyData &party)
 {
-    QString dbPath = QDir(QCoreApplication::applicationDirPath())
-    .filePath("database/luxeMineAuthentication.db");
-
-    // Unique connection name
-    QString connName = QString("insert_party_conn_%1").arg(QDateTime::currentMSecsSinceEpoch());
-
-    bool success = false;
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open DB for party insert:" << db.lastError().text();
-            return false;
-        }
-
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                INSERT INTO Partys (id, name, email, mobileNo, address, city, state, country, areaCode, userId, date)
-                VALUES (:id, :name, :email, :mobileNo, :address, :city, :state, :country, :areaCode, :userId, :date)
-            )");
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Authentication);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open DB for party insert:" << db.lastError().text();
+        return false;
+    }
 
-            query.bindValue(":id", party.id);
-            query.bindValue(":name", party.name);
-            query.bindValue(":email", party.email);
-            query.bindValue(":mobileNo", party.mobileNo);
-            query.bindValue(":address", party.address);
-            query.bindValue(":city", party.city);
-            query.bindValue(":state", party.state);
-            query.bindValue(":country", party.country);
-            query.bindValue(":areaCode", party.areaCode);
-            query.bindValue(":userId", party.userId);
-            query.bindValue(":date", party.date);
-
-            success = query.exec();
-            if (!success) {
-                qDebug() << "[ERROR] Failed to insert party:" << query.lastError().text();
-            }
-        } // query destroyed here
+    QSqlQuery query(db);
+    query.prepare(R"(
+        INSERT INTO Partys (id, name, email, mobileNo, address, city, state, country, areaCode, userId, date)
+        VALUES (:id, :name, :email, :mobileNo, :address, :city, :state, :country, :areaCode, :userId, :date)
+    )");
 
-        db.close();
-    } // db destroyed here
+    query.bindValue(":id", party.id);
+    query.bindValue(":name", party.name);
+    query.bindValue(":email", party.email);
+    query.bindValue(":mobileNo", party.mobileNo);
+    query.bindValue(":address", party.address);
+    query.bindValue(":city", party.city);
+    query.bindValue(":state", party.state);
+    query.bindValue(":country", party.country);
+    query.bindValue(":areaCode", party.areaCode);
+    query.bindValue(":userId", party.userId);
+    query.bindValue(":date", party.date);
+
+    const bool success = query.exec();
+    if (!success) {
+        qDebug() << "[ERROR] Failed to insert party:" << query.lastError().text();
+    }
 
-    QSqlDatabase::removeDatabase(connName); // safe cleanup
     return success;
 }
 
 PartyInfo DatabaseUtils::fetchPartyDetails(const QString &userId, const QString &partyId)
 {
     PartyInfo info;
-    QString dbPath = QDir(QCoreApplication::applicationDirPath())
-                         .filePath("database/luxeMineAuthentication.db");
-
-    // Unique connection name (timestamp-based)
-    QString connName = QString("fetch_party_detail_conn_%1").arg(QDateTime::currentMSecsSinceEpoch());
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open DB in fetchPartyDetails:" << db.lastError().text();
-            return info;
-        }
 
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                SELECT id, name, address, city, state, country
-                FROM Partys
-                WHERE userId = :uid AND id = :pid
-                LIMIT 1
-            )");
-            query.bindValue(":uid", userId);
-            query.bindValue(":pid", partyId);
-
-            if (query.exec() && query.next()) {
-                info.id      = query.value("id").toString();
-                info.name    = query.value("name").toString();
-                info.address = query.value("address").toString();
-                info.city    = query.value("city").toString();
-                info.state   = query.value("state").toString();
-                info.country = query.value("country").toString();
-            } else {
-                qDebug() << "[ERROR] Query failed or no result in fetchPartyDetails:"
-                         << query.lastError().text();
-            }
-        } // query destroyed here
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Authentication);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open DB in fetchPartyDetails:" << db.lastError().text();
+        return info;
+    }
 
-        db.close();
-    } // db destroyed here
+    QSqlQuery query(db);
+    query.prepare(R"(
+        SELECT id, name, address, city, state, country
+        FROM Partys
+        WHERE userId = :uid AND id = :pid
+        LIMIT 1
+    )");
+    query.bindValue(":uid", userId);
+    query.bindValue(":pid", partyId);
+
+    if (query.exec() && query.next()) {
+        info.id      = query.value("id").toString();
+        info.name    = query.value("name").toString();
+        info.address = query.value("address").toString();
+        info.city    = query.value("city").toString();
+        info.state   = query.value("state").toString();
+        info.country = query.value("country").toString();
+    } else {
+        qDebug() << "[ERROR] Query failed or no result in fetchPartyDetails:"
+                 << query.lastError().text();
+    }
 
-    QSqlDatabase::removeDatabase(connName); // safe: query + db out of scope
     return info;
 }
 
 
 //OrderMenu Logic
 int DatabaseUtils::insertDummyOrder(const QString &sellerName, const QString &sellerId, const QString &partyName) {
-    const QString connName = QStringLiteral("insert_order_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     int newId = -1;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-        qDebug()<<dbPath;
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open DB:" << db.lastError().text();
-            return -1;
-        }
-
-        QSqlQuery query(db);
-        query.prepare(R"(INSERT INTO "OrderBook-Detail"
-                         (sellerName, sellerId, partyId, partyName, jobNo, orderNo, orderDate, deliveryDate)
-                         VALUES (?, ?, ?, ?, ?, ?, ?, ?))");
-
-        query.addBindValue(sellerName);
-        query.addBindValue(sellerId);
-        query.addBindValue("TEMP_ID");
-        query.addBindValue(partyName);
-        query.addBindValue("TEMP_JOB");
-        query.addBindValue("TEMP_ORDER");
-        query.addBindValue(QDate::currentDate().toString("yyyy-MM-dd"));
-        query.addBindValue(QDate::currentDate().addDays(1).toString("yyyy-MM-dd"));
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open DB:" << db.lastError().text();
+        return -1;
+    }
 
-        if (!query.exec()) {
-            qDebug() << "[ERROR] Insert failed:" << query.lastError().text();
-        } else {
-            newId = query.lastInsertId().toInt();
-        }
-    } // query + db go out of scope here
+    QSqlQuery query(db);
+    query.prepare(R"(INSERT INTO "OrderBook-Detail"
+                     (sellerName, sellerId, partyId, partyName, jobNo, orderNo, orderDate, deliveryDate)
+                     VALUES (?, ?, ?, ?, ?, ?, ?, ?))");
+
+    query.addBindValue(sellerName);
+    query.addBindValue(sellerId);
+    query.addBindValue("TEMP_ID");
+    query.addBindValue(partyName);
+    query.addBindValue("TEMP_JOB");
+    query.addBindValue("TEMP_ORDER");
+    query.addBindValue(QDate::currentDate().toString("yyyy-MM-dd"));
+    query.addBindValue(QDate::currentDate().addDays(1).toString("yyyy-MM-dd"));
+
+    if (!query.exec()) {
+        qDebug() << "[ERROR] Insert failed:" << query.lastError().text();
+    } else {
+        newId = query.lastInsertId().toInt();
+    }
 
-    QSqlDatabase::removeDatabase(connName);
     return newId;
 }
 
 int DatabaseUtils::getNextJobNumber() {
     int nextJobNumber = 1;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "next_job_conn");
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open DB in getNextJobNumber:" << db.lastError().text();
-            return 1;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open DB in getNextJobNumber:" << db.lastError().text();
+        return 1;
+    }
 
-        QSqlQuery query(db);
-        query.prepare(R"(
+    QSqlQuery query(db);
+    query.prepare(R"(
         SELECT jobNo FROM "OrderBook-Detail"
         WHERE jobNo LIKE 'JOB%' AND LENGTH(jobNo) > 3
         ORDER BY CAST(SUBSTR(jobNo, 4) AS INTEGER) DESC
@@ -2483,159 +1758,121 @@ int DatabaseUtils::getNextJobNumber() {
     )");
 
 
-        if (query.exec() && query.next()) {
-            QString lastJobNo = query.value(0).toString(); // e.g., "JOB00023"
-            bool ok;
-            int number = lastJobNo.mid(3).toInt(&ok);      // "00023" → 23
-            if (ok) nextJobNumber = number + 1;
-        } else {
-            qDebug() << "[ERROR] No previous jobNo found. Starting from 1.";
-        }
-
-        db.close();
+    if (query.exec() && query.next()) {
+        QString lastJobNo = query.value(0).toString(); // e.g., "JOB00023"
+        bool ok;
+        int number = lastJobNo.mid(3).toInt(&ok);      // "00023" → 23
+        if (ok) nextJobNumber = number + 1;
+    } else {
+        qDebug() << "[ERROR] No previous jobNo found. Starting from 1.";
     }
 
-    QSqlDatabase::removeDatabase("next_job_conn");
     return nextJobNumber;
 }
 
 int DatabaseUtils::getNextOrderNumberForSeller(const QString &sellerId) {
     int nextOrder = 1;
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "next_order_conn");
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open DB in getNextOrderNumberForSeller:" << db.lastError().text();
-            return 1;
-        }
 
-        QSqlQuery query(db);
-        // Extract numeric part after sellerId and cast to integer, then order by it
-        query.prepare(QString(R"(
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open DB in getNextOrderNumberForSeller:" << db.lastError().text();
+        return 1;
+    }
+
+    QSqlQuery query(db);
+    // Extract numeric part after sellerId and cast to integer, then order by it
+    query.prepare(QString(R"(
         SELECT orderNo FROM "OrderBook-Detail"
         WHERE orderNo LIKE :prefix AND LENGTH(orderNo) > :minLen
         ORDER BY CAST(SUBSTR(orderNo, :startPos) AS INTEGER) DESC
         LIMIT 1
     )"));
 
-        query.bindValue(":prefix", sellerId + "%");
-        query.bindValue(":minLen", sellerId.length());
-        query.bindValue(":startPos", sellerId.length() + 1); // SQLite is 1-based indexing
+    query.bindValue(":prefix", sellerId + "%");
+    query.bindValue(":minLen", sellerId.length());
+    query.bindValue(":startPos", sellerId.length() + 1); // SQLite is 1-based indexing
 
 
-        if (query.exec() && query.next()) {
-            QString lastOrder = query.value(0).toString(); // e.g., SELL12300007
-            QString numericPart = lastOrder.mid(sellerId.length()); // "00007"
-            bool ok;
-            int number = numericPart.toInt(&ok);
-            if (ok) nextOrder = number + 1;
-        } else {
-            qDebug() << "[ERROR] No previous orderNo found for seller:" << sellerId;
-        }
-
-        db.close();
-
+    if (query.exec() && query.next()) {
+        QString lastOrder = query.value(0).toString(); // e.g., SELL12300007
+        QString numericPart = lastOrder.mid(sellerId.length()); // "00007"
+        bool ok;
+        int number = numericPart.toInt(&ok);
+        if (ok) nextOrder = number + 1;
+    } else {
+        qDebug() << "[ERROR] No previous orderNo found for seller:" << sellerId;
     }
-    QSqlDatabase::removeDatabase("next_order_conn");
+
     return nextOrder;
 }
 
 bool DatabaseUtils::updateDummyOrder(int orderId, const QString &jobNo, const QString &orderNo) {
-    // QDir::setCurrent(QCoreApplication::applicationDirPath());
     bool success = false;
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "update_order_conn");
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
 
-        if (!db.open()) {
-            qDebug() << "Failed to open DB for update:" << db.lastError().text();
-            return false;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "Failed to open DB for update:" << db.lastError().text();
+        return false;
+    }
 
-        QSqlQuery query(db);
-        query.prepare(R"(
+    QSqlQuery query(db);
+    query.prepare(R"(
         UPDATE "OrderBook-Detail"
         SET jobNo = :jobNo, orderNo = :orderNo
         WHERE id = :orderId
     )");
 
-        query.bindValue(":jobNo", jobNo);
-        query.bindValue(":orderNo", orderNo);
-        query.bindValue(":orderId", orderId);
-
-        success = query.exec();
-        if (!success) {
-            qDebug() << "[ERROR] Update failed:" << query.lastError().text();
-        } else if (query.numRowsAffected() == 0) {
-            qDebug() << "[WARNING] No row updated: Check orderId:" << orderId;
-            success = false;
-        }
+    query.bindValue(":jobNo", jobNo);
+    query.bindValue(":orderNo", orderNo);
+    query.bindValue(":orderId", orderId);
 
-        db.close();
+    success = query.exec();
+    if (!success) {
+        qDebug() << "[ERROR] Update failed:" << query.lastError().text();
+    } else if (query.numRowsAffected() == 0) {
+        qDebug() << "[WARNING] No row updated: Check orderId:" << orderId;
+        success = false;
     }
-    QSqlDatabase::removeDatabase("update_order_conn");
+
     return success;
 }
 
 bool DatabaseUtils::cleanupUnsavedOrders()
 {
-    const QString connName = QStringLiteral("cleanup_unsaved_orders_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     bool success = false;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (db.open()) {
-            QSqlQuery query(db);
-            query.prepare(R"(DELETE FROM "OrderBook-Detail" WHERE isSaved = 0)");
-            success = query.exec();
-            if (!success) {
-                qWarning() << "[ERROR] Failed to cleanup unsaved orders:" << query.lastError().text();
-            }
-        } else {
-            qWarning() << "[ERROR] DB open failed in cleanupUnsavedOrders:" << db.lastError().text();
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (db.isOpen()) {
+        QSqlQuery query(db);
+        query.prepare(R"(DELETE FROM "OrderBook-Detail" WHERE isSaved = 0)");
+        success = query.exec();
+        if (!success) {
+            qWarning() << "[ERROR] Failed to cleanup unsaved orders:" << query.lastError().text();
         }
-
-        db.close();
+    } else {
+        qWarning() << "[ERROR] DB open failed in cleanupUnsavedOrders:" << db.lastError().text();
     }
-    QSqlDatabase::removeDatabase(connName);
+
     return success;
 }
 
 bool DatabaseUtils::saveOrder(const OrderData &order) {
     bool success = false;  // final result
-    const QString connName = QStringLiteral("save_order_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    // QDir::setCurrent(QCoreApplication::applicationDirPath());
-    // const QString dbPath = QCoreApplication::applicationDirPath() + "/database/mega_mine_orderbook.db";
-
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
 
-        if (!db.open()) {
-            qDebug() << "[ERROR] Failed to open DB in saveOrder:" << db.lastError().text();
-            return false;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open DB in saveOrder:" << db.lastError().text();
+        return false;
+    }
 
-        if (!db.transaction()) {
-            qDebug() << "[ERROR] Failed to start transaction:" << db.lastError().text();
-            db.close();
-            QSqlDatabase::removeDatabase(connName);
-            return false;
-        }
+    if (!db.transaction()) {
+        qDebug() << "[ERROR] Failed to start transaction:" << db.lastError().text();
+        return false;
+    }
 
-        {
-            QSqlQuery query(db);
-            query.prepare(R"(
+    {
+        QSqlQuery query(db);
+        query.prepare(R"(
             UPDATE "OrderBook-Detail" SET
                 sellerName = :sellerName, sellerId = :sellerId, partyId = :partyId, partyName = :partyName,
                 jobNo = :jobNo, orderNo = :orderNo,
@@ -2659,101 +1896,92 @@ bool DatabaseUtils::saveOrder(const OrderData &order) {
             WHERE id = :id
         )");
 
-            // bind values
-            query.bindValue(":sellerName", order.sellerName);
-            query.bindValue(":sellerId", order.sellerId);
-            query.bindValue(":partyId", order.partyId);
-            query.bindValue(":partyName", order.partyName);
-            query.bindValue(":jobNo", order.jobNo);
-            query.bindValue(":orderNo", order.orderNo);
-            query.bindValue(":clientId", order.clientId);
-            query.bindValue(":agencyId", order.agencyId);
-            query.bindValue(":shopId", order.shopId);
-            query.bindValue(":retailleId", order.retailleId);
-            query.bindValue(":starId", order.starId);
-            query.bindValue(":address", order.address);
-            query.bindValue(":city", order.city);
-            query.bindValue(":state", order.state);
-            query.bindValue(":country", order.country);
-            query.bindValue(":orderDate", order.orderDate);
-            query.bindValue(":deliveryDate", order.deliveryDate);
-            query.bindValue(":productName", order.productName);
-            query.bindValue(":productPis", order.productPis);
-            query.bindValue(":approxProductWt", order.approxProductWt);
-            query.bindValue(":metalPrice", order.metalPrice);
-            query.bindValue(":metalName", order.metalName);
-            query.bindValue(":metalPurity", order.metalPurity);
-            query.bindValue(":metalColor", order.metalColor);
-            query.bindValue(":sizeNo", order.sizeNo);
-            query.bindValue(":sizeMM", order.sizeMM);
-            query.bindValue(":length", order.length);
-            query.bindValue(":width", order.width);
-            query.bindValue(":height", order.height);
-            query.bindValue(":diaPacific", order.diaPacific);
-            query.bindValue(":diaPurity", order.diaPurity);
-            query.bindValue(":diaColor", order.diaColor);
-            query.bindValue(":diaPrice", order.diaPrice);
-            query.bindValue(":stPacific", order.stPacific);
-            query.bindValue(":stPurity", order.stPurity);
-            query.bindValue(":stColor", order.stColor);
-            query.bindValue(":stPrice", order.stPrice);
-            query.bindValue(":designNo1", order.designNo1);
-            query.bindValue(":designNo2", order.designNo2);
-            query.bindValue(":image1Path", order.image1Path);
-            query.bindValue(":image2Path", order.image2Path);
-            query.bindValue(":metalCertiName", order.metalCertiName);
-            query.bindValue(":metalCertiType", order.metalCertiType);
-            query.bindValue(":diaCertiName", order.diaCertiName);
-            query.bindValue(":diaCertiType", order.diaCertiType);
-            query.bindValue(":pesSaki", order.pesSaki);
-            query.bindValue(":chainLock", order.chainLock);
-            query.bindValue(":polish", order.polish);
-            query.bindValue(":settingLabour", order.settingLabour);
-            query.bindValue(":metalStemp", order.metalStemp);
-            query.bindValue(":paymentMethod", order.paymentMethod);
-            query.bindValue(":totalAmount", order.totalAmount);
-            query.bindValue(":advance", order.advance);
-            query.bindValue(":remaining", order.remaining);
-            query.bindValue(":note", order.note);
-            query.bindValue(":extraDetail", order.extraDetail);
-            query.bindValue(":id", order.id);
+        // bind values
+        query.bindValue(":sellerName", order.sellerName);
+        query.bindValue(":sellerId", order.sellerId);
+        query.bindValue(":partyId", order.partyId);
+        query.bindValue(":partyName", order.partyName);
+        query.bindValue(":jobNo", order.jobNo);
+        query.bindValue(":orderNo", order.orderNo);
+        query.bindValue(":clientId", order.clientId);
+        query.bindValue(":agencyId", order.agencyId);
+        query.bindValue(":shopId", order.shopId);
+        query.bindValue(":retailleId", order.retailleId);
+        query.bindValue(":starId", order.starId);
+        query.bindValue(":address", order.address);
+        query.bindValue(":city", order.city);
+        query.bindValue(":state", order.state);
+        query.bindValue(":country", order.country);
+        query.bindValue(":orderDate", order.orderDate);
+        query.bindValue(":deliveryDate", order.deliveryDate);
+        query.bindValue(":productName", order.productName);
+        query.bindValue(":productPis", order.productPis);
+        query.bindValue(":approxProductWt", order.approxProductWt);
+        query.bindValue(":metalPrice", order.metalPrice);
+        query.bindValue(":metalName", order.metalName);
+        query.bindValue(":metalPurity", order.metalPurity);
+        query.bindValue(":metalColor", order.metalColor);
+        query.bindValue(":sizeNo", order.sizeNo);
+        query.bindValue(":sizeMM", order.sizeMM);
+        query.bindValue(":length", order.length);
+        query.bindValue(":width", order.width);
+        query.bindValue(":height", order.height);
+        query.bindValue(":diaPacific", order.diaPacific);
+        query.bindValue(":diaPurity", order.diaPurity);
+        query.bindValue(":diaColor", order.diaColor);
+        query.bindValue(":diaPrice", order.diaPrice);
+        query.bindValue(":stPacific", order.stPacific);
+        query.bindValue(":stPurity", order.stPurity);
+        query.bindValue(":stColor", order.stColor);
+        query.bindValue(":stPrice", order.stPrice);
+        query.bindValue(":designNo1", order.designNo1);
+        query.bindValue(":designNo2", order.designNo2);
+        query.bindValue(":image1Path", order.image1Path);
+        query.bindValue(":image2Path", order.image2Path);
+        query.bindValue(":metalCertiName", order.metalCertiName);
+        query.bindValue(":metalCertiType", order.metalCertiType);
+        query.bindValue(":diaCertiName", order.diaCertiName);
+        query.bindValue(":diaCertiType", order.diaCertiType);
+        query.bindValue(":pesSaki", order.pesSaki);
+        query.bindValue(":chainLock", order.chainLock);
+        query.bindValue(":polish", order.polish);
+        query.bindValue(":settingLabour", order.settingLabour);
+        query.bindValue(":metalStemp", order.metalStemp);
+        query.bindValue(":paymentMethod", order.paymentMethod);
+        query.bindValue(":totalAmount", order.totalAmount);
+        query.bindValue(":advance", order.advance);
+        query.bindValue(":remaining", order.remaining);
+        query.bindValue(":note", order.note);
+        query.bindValue(":extraDetail", order.extraDetail);
+        query.bindValue(":id", order.id);
 
-            if (!query.exec()) {
-                qDebug() << "[ERROR] Update failed:" << query.lastError().text();
-                db.rollback();
-            } else {
-                QSqlQuery addStatus(db);
-                addStatus.prepare(R"(INSERT INTO "Order-Status" (jobNo) VALUES (:jobNo))");
-                addStatus.bindValue(":jobNo", order.jobNo);
-
-                if (!addStatus.exec()) {
-                    qDebug() << "[ERROR] Failed to insert into Order-Status:" << addStatus.lastError().text();
-                    db.rollback();
-                } else if (!db.commit()) {
-                    qDebug() << "[ERROR] Commit failed:" << db.lastError().text();
-                    db.rollback();
-                } else {
-                    success = true;
-                }
-            }
-        } // queries go out of scope here
+        if (!query.exec()) {
+            qDebug() << "[ERROR] Update failed:" << query.lastError().text();
+        } else {
+            QSqlQuery addStatus(db);
+            addStatus.prepare(R"(INSERT INTO "Order-Status" (jobNo) VALUES (:jobNo))");
+            addStatus.bindValue(":jobNo", order.jobNo);
 
-        if (success) {
-            if (!db.commit()) {
-                qDebug() << "[ERROR] Commit failed:" << db.lastError().text();
-                db.rollback(); // Attempt to roll back on failed commit
-                success = false;
+            if (!addStatus.exec()) {
+                qDebug() << "[ERROR] Failed to insert into Order-Status:" << addStatus.lastError().text();
+            } else {
+                success = true;
             }
-        } else {
-            qDebug() << "[ERROR] One of the queries failed. Rolling back transaction.";
-            db.rollback();
         }
+    } // queries go out of scope here
 
-
-        db.close();
-
+    // Pooled handle is reused, so the transaction must always be closed here
+    if (success) {
+        if (!db.commit()) {
+            qDebug() << "[ERROR] Commit failed:" << db.lastError().text();
+            db.rollback(); // Attempt to roll back on failed commit
+            success = false;
+        }
+    } else {
+        qDebug() << "[ERROR] One of the queries failed. Rolling back transaction.";
+        db.rollback();
     }
-    QSqlDatabase::removeDatabase(connName);
+
     return success;
 }
 
@@ -2761,308 +1989,211 @@ bool DatabaseUtils::saveOrder(const OrderData &order) {
 //OrderList Logic
 std::optional<JobSheetData> DatabaseUtils::fetchJobSheetData(const QString &jobNo)
 {
-    const QString connName = QStringLiteral("fetch_jobsheet_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     std::optional<JobSheetData> result;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName(QCoreApplication::applicationDirPath() + "/database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qWarning() << "[ERROR] Failed to open DB in fetchJobSheetData:" << db.lastError().text();
-            return std::nullopt;
-        }
-
-        QSqlQuery query(db);
-        query.prepare(R"(
-            SELECT sellerId, partyId, jobNo, orderNo, clientId,
-                   orderDate, deliveryDate, productPis, designNo1,
-                   metalPurity, metalColor, sizeNo, sizeMM,
-                   length, width, height, image1path
-            FROM "OrderBook-Detail"
-            WHERE jobNo = :jobNo
-        )");
-        query.bindValue(":jobNo", jobNo);
-
-        if (query.exec() && query.next()) {
-            JobSheetData data;
-            data.sellerId    = query.value("sellerId").toString();
-            data.partyId     = query.value("partyId").toString();
-            data.jobNo       = query.value("jobNo").toString();
-            data.orderNo     = query.value("orderNo").toString();
-            data.clientId    = query.value("clientId").toString();
-            data.orderDate   = query.value("orderDate").toString();
-            data.deliveryDate= query.value("deliveryDate").toString();
-            data.productPis  = query.value("productPis").toInt();
-            data.designNo    = query.value("designNo1").toString();
-            data.metalPurity = query.value("metalPurity").toString();
-            data.metalColor  = query.value("metalColor").toString();
-            data.sizeNo      = query.value("sizeNo").toDouble();
-            data.sizeMM      = query.value("sizeMM").toDouble();
-            data.length      = query.value("length").toDouble();
-            data.width       = query.value("width").toDouble();
-            data.height      = query.value("height").toDouble();
-            data.imagePath   = query.value("image1path").toString();
-
-            result = data;
-        } else {
-            qWarning() << "[WARNING] No data found for jobNo:" << jobNo
-                       << " Error:" << query.lastError().text();
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in fetchJobSheetData:" << db.lastError().text();
+        return std::nullopt;
+    }
 
-        db.close();
+    PooledQuery query = ConnectionPool::instance().prepare(db, R"(
+        SELECT sellerId, partyId, jobNo, orderNo, clientId,
+               orderDate, deliveryDate, productPis, designNo1,
+               metalPurity, metalColor, sizeNo, sizeMM,
+               length, width, height, image1path
+        FROM "OrderBook-Detail"
+        WHERE jobNo = :jobNo
+    )");
+    query->bindValue(":jobNo", jobNo);
+
+    if (query->exec() && query->next()) {
+        JobSheetData data;
+        data.sellerId    = query->value("sellerId").toString();
+        data.partyId     = query->value("partyId").toString();
+        data.jobNo       = query->value("jobNo").toString();
+        data.orderNo     = query->value("orderNo").toString();
+        data.clientId    = query->value("clientId").toString();
+        data.orderDate   = query->value("orderDate").toString();
+        data.deliveryDate= query->value("deliveryDate").toString();
+        data.productPis  = query->value("productPis").toInt();
+        data.designNo    = query->value("designNo1").toString();
+        data.metalPurity = query->value("metalPurity").toString();
+        data.metalColor  = query->value("metalColor").toString();
+        data.sizeNo      = query->value("sizeNo").toDouble();
+        data.sizeMM      = query->value("sizeMM").toDouble();
+        data.length      = query->value("length").toDouble();
+        data.width       = query->value("width").toDouble();
+        data.height      = query->value("height").toDouble();
+        data.imagePath   = query->value("image1path").toString();
+
+        result = data;
+    } else {
+        qWarning() << "[WARNING] No data found for jobNo:" << jobNo
+                   << " Error:" << query->lastError().text();
     }
 
-    QSqlDatabase::removeDatabase(connName);
     return result;
 }
 
 QPair<QString, QString> DatabaseUtils::fetchDiamondAndStoneJson(const QString &designNo)
 {
-    const QString connName = "fetch_diamond_stone_conn";
-    QString diamondJson, stoneJson;
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in fetchDiamondAndStoneJson:" << db.lastError().text();
+        return {};
+    }
 
+    int imageId = -1;
     {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qWarning() << "[ERROR] Failed to open DB in fetchDiamondAndStoneJson:" << db.lastError().text();
-            QSqlDatabase::removeDatabase(connName);
-            return {};
-        }
+        PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT image_id FROM image_data WHERE design_no = :designNo");
+        query->bindValue(":designNo", designNo);
 
-        // 🔹 Fetch diamond + stone JSON from image_data
-        QSqlQuery query(db);
-        query.prepare("SELECT diamond, stone FROM image_data WHERE design_no = :designNo");
-        query.bindValue(":designNo", designNo);
-
-        if (query.exec() && query.next()) {
-            diamondJson = query.value(0).toString();
-            stoneJson   = query.value(1).toString();
+        if (query->exec() && query->next()) {
+            imageId = query->value(0).toInt();
         } else {
-            qWarning() << "[WARNING] No diamond/stone JSON found for designNo:" << designNo;
-        }
-
-        // 🔹 Helper lambda to find single piece weight
-        auto getWeight = [&](const QString &type, const QString &sizeMM, bool isDiamond) -> double {
-            QSqlQuery q(db);
-            if (isDiamond) {
-                if (type.compare("Round", Qt::CaseInsensitive) == 0) {
-                    q.prepare("SELECT weight FROM Round_diamond WHERE sizeMM = ?");
-                    q.addBindValue(sizeMM.toDouble());
-                } else {
-                    q.prepare("SELECT weight FROM Fancy_diamond WHERE shape = ? AND sizeMM = ?");
-                    q.addBindValue(type);
-                    q.addBindValue(sizeMM);
-                }
-            } else {
-                q.prepare("SELECT weight FROM Stones WHERE shape = ? AND sizeMM = ?");
-                q.addBindValue(type);
-                q.addBindValue(sizeMM);
-            }
-            if (q.exec() && q.next())
-                return q.value(0).toDouble();
-            return 0.0;
-        };
-
-        // 🔹 Add weight info into diamond JSON
-        if (!diamondJson.isEmpty()) {
-            QJsonParseError err;
-            QJsonDocument doc = QJsonDocument::fromJson(diamondJson.toUtf8(), &err);
-            if (err.error == QJsonParseError::NoError && doc.isArray()) {
-                QJsonArray updated;
-                for (auto v : doc.array()) {
-                    if (!v.isObject()) continue;
-                    QJsonObject o = v.toObject();
-                    double wt = getWeight(o["type"].toString(), o["sizeMM"].toString(), true);
-                    o["weight"] = wt;
-                    updated.append(o);
-                }
-                diamondJson = QString::fromUtf8(QJsonDocument(updated).toJson(QJsonDocument::Compact));
-            }
+            qWarning() << "[WARNING] No diamond/stone data found for designNo:" << designNo;
+            return {};
         }
+    }
 
-        // 🔹 Add weight info into stone JSON
-        if (!stoneJson.isEmpty()) {
-            QJsonParseError err;
-            QJsonDocument doc = QJsonDocument::fromJson(stoneJson.toUtf8(), &err);
-            if (err.error == QJsonParseError::NoError && doc.isArray()) {
-                QJsonArray updated;
-                for (auto v : doc.array()) {
-                    if (!v.isObject()) continue;
-                    QJsonObject o = v.toObject();
-                    double wt = getWeight(o["type"].toString(), o["sizeMM"].toString(), false);
-                    o["weight"] = wt;
-                    updated.append(o);
-                }
-                stoneJson = QString::fromUtf8(QJsonDocument(updated).toJson(QJsonDocument::Compact));
-            }
-        }
+    // 🔹 Helper lambda to find single piece weight
+    auto getWeight = [](const QString &type, const QString &sizeMM, bool isDiamond) -> double {
+        const bool isRound = isDiamond && type.compare("Round", Qt::CaseInsensitive) == 0;
+        ReferenceDataCache &refData = ReferenceDataCache::instance();
+        bool numeric = false;
+        const double size = sizeMM.trimmed().toDouble(&numeric);
+        return (!isDiamond ? refData.stoneWeight(type, sizeMM)
+                : !isRound ? refData.fancyWeight(type, sizeMM)
+                : numeric  ? refData.roundWeight(size)
+                           : std::nullopt).value_or(0.0);
+    };
 
-        db.close();
-    }
-    QSqlDatabase::removeDatabase(connName);
+    // 🔹 Same shape as the stored JSON, plus the single piece weight
+    auto toJson = [&](const QString &type) {
+        QJsonArray array;
+        for (const CatalogPiece &piece : fetchCatalogPieces({imageId}, type)) {
+            QJsonObject o;
+            o["type"] = piece.type;
+            o["sizeMM"] = piece.sizeMM;
+            o["quantity"] = QString::number(piece.quantity);
+            o["weight"] = getWeight(piece.type, piece.sizeMM, type == "diamond");
+            array.append(o);
+        }
+        return QString::fromUtf8(QJsonDocument(array).toJson(QJsonDocument::Compact));
+    };
 
-    return {diamondJson, stoneJson};
+    return {toJson("diamond"), toJson("stone")};
 }
 
 bool DatabaseUtils::insertStatusChangeRequest(const QString &jobNo, const QString &userId, const QString &fromStatus, const QString &toStatus, const QString &role, const QString &note)
 {
-    const QString connName = QStringLiteral("insert_status_req_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     bool success = false;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (db.open()) {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                INSERT INTO StatusChangeRequests
-                (jobNo, userId, fromStatus, toStatus, requestTime, role, note)
-                VALUES
-                (:jobNo, :userId, :fromStatus, :toStatus, :requestTime, :role, :note)
-            )");
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (db.isOpen()) {
+        QSqlQuery query(db);
+        query.prepare(R"(
+            INSERT INTO StatusChangeRequests
+            (jobNo, userId, fromStatus, toStatus, requestTime, role, note)
+            VALUES
+            (:jobNo, :userId, :fromStatus, :toStatus, :requestTime, :role, :note)
+        )");
 
-            query.bindValue(":jobNo", jobNo);
-            query.bindValue(":userId", userId);
-            query.bindValue(":fromStatus", fromStatus);
-            query.bindValue(":toStatus", toStatus);
-            query.bindValue(":requestTime", QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
-            query.bindValue(":role", role);
-            query.bindValue(":note", note);
+        query.bindValue(":jobNo", jobNo);
+        query.bindValue(":userId", userId);
+        query.bindValue(":fromStatus", fromStatus);
+        query.bindValue(":toStatus", toStatus);
+        query.bindValue(":requestTime", QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+        query.bindValue(":role", role);
+        query.bindValue(":note", note);
 
-            success = query.exec();
-            if (!success)
-                qWarning() << "[ERROR] Failed to insert status change request:" << query.lastError().text();
-        } else {
-            qWarning() << "[ERROR] DB open failed in insertStatusChangeRequest:" << db.lastError().text();
-        }
-        db.close();
+        success = query.exec();
+        if (!success)
+            qWarning() << "[ERROR] Failed to insert status change request:" << query.lastError().text();
+    } else {
+        qWarning() << "[ERROR] DB open failed in insertStatusChangeRequest:" << db.lastError().text();
     }
-    QSqlDatabase::removeDatabase(connName);
+
     return success;
 }
 
 bool DatabaseUtils::approveStatusChange(const QString &jobNo, const QString &role, const QString &statusField, bool approved, const QString &note)
 {
-    const QString connName = QStringLiteral("approve_status_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     bool success = false;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (db.open()) {
-            QSqlQuery query(db);
-
-            if (role == "manager" && statusField == "Order Checked") {
-                query.prepare(R"(UPDATE "Order-Status"
-                                 SET Order_Approve = :approved,
-                                     Order_Note = CASE WHEN :approved = 1 THEN '' ELSE :note END
-                                 WHERE jobNo = :jobNo)");
-                query.bindValue(":approved", approved ? 1 : 0);
-                query.bindValue(":note", note);
-
-            } else if (role == "manager" && statusField == "Design Checked") {
-                query.prepare(R"(UPDATE "Order-Status"
-                                 SET Design_Approve = :approved,
-                                     Design_Note = CASE WHEN :approved = 1 THEN '' ELSE :note END,
-                                     Designer = CASE WHEN :approved = 0 THEN 'Working' ELSE Designer END
-                                 WHERE jobNo = :jobNo)");
-                query.bindValue(":approved", approved ? 1 : 0);
-                query.bindValue(":note", note);
-
-            } else if (role == "manager" && statusField == "QC Done") {
-                query.prepare(R"(UPDATE "Order-Status"
-                                 SET Quality_Approve = :approved,
-                                     Quality_Note = CASE WHEN :approved = 1 THEN '' ELSE :note END,
-                                     Manufacturer = CASE WHEN :approved = 0 THEN 'Working' ELSE Manufacturer END
-                                 WHERE jobNo = :jobNo)");
-                query.bindValue(":approved", approved ? 1 : 0);
-                query.bindValue(":note", note);
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (db.isOpen()) {
+        QSqlQuery query(db);
 
-            } else {
-                // [+] Fallback: update generic role column to new status
-                query.prepare(QString(R"(UPDATE "Order-Status" SET "%1" = :status WHERE jobNo = :jobNo)")
-                                  .arg(role));
-                query.bindValue(":status", statusField);
-            }
+        if (role == "manager" && statusField == "Order Checked") {
+            query.prepare(R"(UPDATE "Order-Status"
+                             SET Order_Approve = :approved,
+                                 Order_Note = CASE WHEN :approved = 1 THEN '' ELSE :note END
+                             WHERE jobNo = :jobNo)");
+            query.bindValue(":approved", approved ? 1 : 0);
+            query.bindValue(":note", note);
 
-            query.bindValue(":jobNo", jobNo);
+        } else if (role == "manager" && statusField == "Design Checked") {
+            query.prepare(R"(UPDATE "Order-Status"
+                             SET Design_Approve = :approved,
+                                 Design_Note = CASE WHEN :approved = 1 THEN '' ELSE :note END,
+                                 Designer = CASE WHEN :approved = 0 THEN 'Working' ELSE Designer END
+                             WHERE jobNo = :jobNo)");
+            query.bindValue(":approved", approved ? 1 : 0);
+            query.bindValue(":note", note);
+
+        } else if (role == "manager" && statusField == "QC Done") {
+            query.prepare(R"(UPDATE "Order-Status"
+                             SET Quality_Approve = :approved,
+                                 Quality_Note = CASE WHEN :approved = 1 THEN '' ELSE :note END,
+                                 Manufacturer = CASE WHEN :approved = 0 THEN 'Working' ELSE Manufacturer END
+                             WHERE jobNo = :jobNo)");
+            query.bindValue(":approved", approved ? 1 : 0);
+            query.bindValue(":note", note);
 
-            success = query.exec();
-            if (!success) {
-                qWarning() << "[ERROR] Failed to approve status change:"
-                           << query.lastError().text()
-                           << "| SQL:" << query.lastQuery();
-            }
         } else {
-            qWarning() << "[ERROR] DB open failed in approveStatusChange:" << db.lastError().text();
+            // [+] Fallback: update generic role column to new status
+            query.prepare(QString(R"(UPDATE "Order-Status" SET "%1" = :status WHERE jobNo = :jobNo)")
+                              .arg(role));
+            query.bindValue(":status", statusField);
         }
 
-        db.close();
+        query.bindValue(":jobNo", jobNo);
+
+        success = query.exec();
+        if (!success) {
+            qWarning() << "[ERROR] Failed to approve status change:"
+                       << query.lastError().text()
+                       << "| SQL:" << query.lastQuery();
+        }
+    } else {
+        qWarning() << "[ERROR] DB open failed in approveStatusChange:" << db.lastError().text();
     }
-    QSqlDatabase::removeDatabase(connName);
+
     return success;
 }
 
-QList<QVariantList> DatabaseUtils::fetchOrderListDetails() {
-    QList<QVariantList> orderList;
-
-    QString dbPath = QDir(QCoreApplication::applicationDirPath())
-                         .filePath("database/mega_mine_orderbook.db");
-
-    const QString connName = QStringLiteral("order_list_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        db.setDatabaseName(dbPath);
-
-        if (!db.open()) {
-            qDebug() << "[ERROR] Database not open:" << db.lastError().text();
-            return orderList;
-        }
-
-        QSqlQuery query(db);
-        query.prepare(R"(
-            SELECT
-                od.sellerId, od.partyId, os.jobNo,
-                os.Manager, os.Designer, os.Manufacturer, os.Accountant,
-                od.orderDate, od.deliveryDate, od.image1Path,
-                os.Order_Approve, os.Design_Approve, os.Quality_Approve,
-                os.Order_Note, os.Design_Note, os.Quality_Note
-            FROM "OrderBook-Detail" od
-            LEFT JOIN "Order-Status" os ON od.jobNo = os.jobNo
-        )");
+QList<OrderListRow> DatabaseUtils::fetchOrderListDetails() {
+    QList<OrderListRow> orderList;
 
-        if (!query.exec()) {
-            qDebug() << "[ERROR] Error executing query:" << query.lastError().text();
-            db.close();
-            QSqlDatabase::removeDatabase(connName);
-            return orderList;
-        }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Database not open:" << db.lastError().text();
+        return orderList;
+    }
 
-        int colCount = query.record().count();
-        while (query.next()) {
-            QVariantList row;
-            for (int i = 0; i < colCount; ++i) {
-                row.append(query.value(i));
-            }
-            orderList.append(row);
-        }
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(OrderListSql);
 
-        db.close(); // close before remove
+    if (!query.exec()) {
+        qDebug() << "[ERROR] Error executing query:" << query.lastError().text();
+        return orderList;
     }
 
-    QSqlDatabase::removeDatabase(connName);
+    // The LEFT JOIN yields exactly one row per OrderBook-Detail row when jobNo is unique
+    orderList = RowMapper::readAll<OrderListRow>(query, RowMapper::countRows(db, "OrderBook-Detail"));
     return orderList;
 }
 
@@ -3070,32 +2201,22 @@ QList<QVariantList> DatabaseUtils::fetchOrderListDetails() {
 //JobSheet Logic
 QString DatabaseUtils::fetchImagePathForDesign(const QString &designNo)
 {
-    const QString connName = QStringLiteral("fetch_img_path_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     QString imagePath;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_image.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-        db.setDatabaseName(dbPath);
-
-        if (db.open()) {
-            QSqlQuery query(db);
-            query.prepare("SELECT image_path FROM image_data WHERE design_no = :designNo");
-            query.bindValue(":designNo", designNo);
-
-            if (query.exec() && query.next()) {
-                imagePath = query.value("image_path").toString();
-            } else {
-                qWarning() << "[ERROR] No image found for designNo:" << designNo;
-            }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (db.isOpen()) {
+        PooledQuery query = ConnectionPool::instance().prepare(db, "SELECT image_path FROM image_data WHERE design_no = :designNo");
+        query->bindValue(":designNo", designNo);
 
-            db.close();
+        if (query->exec() && query->next()) {
+            imagePath = query->value("image_path").toString();
         } else {
-            qWarning() << "[ERROR] Failed to open DB in fetchImagePathForDesign:" << db.lastError().text();
+            qWarning() << "[ERROR] No image found for designNo:" << designNo;
         }
+    } else {
+        qWarning() << "[ERROR] Failed to open DB in fetchImagePathForDesign:" << db.lastError().text();
     }
-    QSqlDatabase::removeDatabase(connName);
+
     return imagePath;
 }
 
@@ -3136,40 +2257,231 @@ void DatabaseUtils::fillStoneTable(QTableWidget *table, const QString &designNo)
 
 bool DatabaseUtils::updateDesignNoAndImagePath(const QString &jobNo, const QString &designNo, const QString &imagePath)
 {
-    const QString connName = QStringLiteral("update_design_img_conn_%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
     bool success = false;
 
-    {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-        // db.setDatabaseName("database/mega_mine_orderbook.db");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (db.open()) {
-            QSqlQuery query(db);
-            query.prepare(R"(
-                UPDATE "OrderBook-Detail"
-                SET designNo1 = :designNo, image1path = :imagePath
-                WHERE jobNo = :jobNo
-            )");
-            query.bindValue(":designNo", designNo);
-            query.bindValue(":imagePath", imagePath);
-            query.bindValue(":jobNo", jobNo);
-
-            if (query.exec()) {
-                qDebug() << "[+] Design number and image path updated for jobNo:" << jobNo;
-                success = true;
-            } else {
-                qWarning() << "[ERROR] Failed to update OrderBook-Detail:" << query.lastError().text();
-            }
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (db.isOpen()) {
+        QSqlQuery query(db);
+        query.prepare(R"(
+            UPDATE "OrderBook-Detail"
+            SET designNo1 = :designNo, image1path = :imagePath
+            WHERE jobNo = :jobNo
+        )");
+        query.bindValue(":designNo", designNo);
+        query.bindValue(":imagePath", imagePath);
+        query.bindValue(":jobNo", jobNo);
 
-            db.close();
+        if (query.exec()) {
+            qDebug() << "[+] Design number and image path updated for jobNo:" << jobNo;
+            success = true;
         } else {
-            qWarning() << "[ERROR] Failed to open DB in updateDesignNoAndImagePath:" << db.lastError().text();
+            qWarning() << "[ERROR] Failed to update OrderBook-Detail:" << query.lastError().text();
         }
+    } else {
+        qWarning() << "[ERROR] Failed to open DB in updateDesignNoAndImagePath:" << db.lastError().text();
     }
 
-    QSqlDatabase::removeDatabase(connName);
     return success;
 }
 
+
+bool DatabaseUtils::insertJobSheetMovement(const JobSheetMovement &movement)
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in insertJobSheetMovement:" << db.lastError().text();
+        return false;
+    }
+
+    PooledQuery query = ConnectionPool::instance().prepare(db, R"(
+        INSERT INTO jobsheet_movements (job_no, material, direction, type, size, pcs, weight, ts, user)
+        VALUES (:jobNo, :material, :direction, :type, :size, :pcs, :weight, :ts, :user)
+    )");
+    query->bindValue(":jobNo", movement.jobNo);
+    query->bindValue(":material", movement.material);
+    query->bindValue(":direction", movement.direction);
+    query->bindValue(":type", movement.type);
+    query->bindValue(":size", movement.size);
+    query->bindValue(":pcs", movement.pcs);
+    query->bindValue(":weight", movement.weight);
+    query->bindValue(":ts", movement.ts.isEmpty()
+                                ? QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")
+                                : movement.ts);
+    query->bindValue(":user", movement.user);
+
+    if (!query->exec()) {
+        qWarning() << "[ERROR] Failed to insert job sheet movement:" << query->lastError().text();
+        return false;
+    }
+    return true;
+}
+
+QList<JobSheetMovement> DatabaseUtils::fetchJobSheetMovements(const QString &jobNo, const QString &material,
+                                                              const QString &direction)
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in fetchJobSheetMovements:" << db.lastError().text();
+        return {};
+    }
+
+    PooledQuery query = ConnectionPool::instance().prepare(db, R"(
+        SELECT job_no, material, direction, type, size, pcs, weight, ts, user
+        FROM jobsheet_movements
+        WHERE job_no = :jobNo AND material = :material AND direction = :direction
+        ORDER BY id
+    )");
+    query->bindValue(":jobNo", jobNo);
+    query->bindValue(":material", material);
+    query->bindValue(":direction", direction);
+
+    if (!query->exec()) {
+        qWarning() << "[ERROR] fetchJobSheetMovements failed:" << query->lastError().text();
+        return {};
+    }
+    return RowMapper::readAll<JobSheetMovement>(query.query());
+}
+
+QList<JobSheetMovementTotal> DatabaseUtils::fetchJobSheetMovementTotals(const QString &jobNo)
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in fetchJobSheetMovementTotals:" << db.lastError().text();
+        return {};
+    }
+
+    PooledQuery query = ConnectionPool::instance().prepare(db, R"(
+        SELECT material, direction, SUM(pcs), SUM(weight),
+               SUM(CASE WHEN type = 'Product' THEN weight ELSE 0 END)
+        FROM jobsheet_movements
+        WHERE job_no = :jobNo
+        GROUP BY material, direction
+    )");
+    query->bindValue(":jobNo", jobNo);
+
+    if (!query->exec()) {
+        qWarning() << "[ERROR] fetchJobSheetMovementTotals failed:" << query->lastError().text();
+        return {};
+    }
+    return RowMapper::readAll<JobSheetMovementTotal>(query.query());
+}
+
+bool DatabaseUtils::importLegacyJobSheetMovements(QSqlDatabase &db)
+{
+    // Legacy JSON column -> ledger (material, direction). Files created before the broken
+    // columns were added lack some of them, so only the columns present are imported.
+    struct LegacyColumn { QString column; QString material; QString direction; };
+    static const QList<LegacyColumn> legacyColumns = {
+        {"filling_issue",  "gold",    "issue"},
+        {"filling_return", "gold",    "return"},
+        {"filling_dust",   "gold",    "dust"},
+        {"diamond_issue",  "diamond", "issue"},
+        {"diamond_return", "diamond", "return"},
+        {"diamond_broken", "diamond", "broken"},
+        {"stone_issue",    "stone",   "issue"},
+        {"stone_return",   "stone",   "return"},
+        {"stone_broken",   "stone",   "broken"},
+        {"other_issue",    "other",   "issue"},
+        {"other_return",   "other",   "return"},
+        {"other_broken",   "other",   "broken"},
+    };
+
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA table_info(jobsheet_detail)")) {
+        qWarning() << "[ERROR] Cannot read jobsheet_detail columns:" << query.lastError().text();
+        return false;
+    }
+    QSet<QString> existingColumns;
+    while (query.next())
+        existingColumns.insert(query.value(1).toString().toLower());
+
+    for (const LegacyColumn &legacy : legacyColumns) {
+        if (!existingColumns.contains(legacy.column))
+            continue;
+
+        // Gold entries are {type, weight, date_time "dd-MM-yyyy HH:mm:ss"},
+        // diamond/stone/other entries are {type, size, category, pcs, wt}
+        const QString weightKey = legacy.material == "gold" ? "weight" : "wt";
+        const QString sql = QString(R"(
+            INSERT INTO jobsheet_movements (job_no, material, direction, type, size, pcs, weight, ts)
+            SELECT d.job_no, :material, :direction,
+                   COALESCE(json_extract(j.value, '$.type'), ''),
+                   COALESCE(json_extract(j.value, '$.size'), ''),
+                   COALESCE(CAST(json_extract(j.value, '$.pcs') AS INTEGER), 0),
+                   COALESCE(CAST(json_extract(j.value, '$.%2') AS REAL), 0),
+                   CASE WHEN json_extract(j.value, '$.date_time') GLOB '[0-9][0-9]-[0-9][0-9]-[0-9][0-9][0-9][0-9]*'
+                        THEN substr(json_extract(j.value, '$.date_time'), 7, 4) || '-'
+                             || substr(json_extract(j.value, '$.date_time'), 4, 2) || '-'
+                             || substr(json_extract(j.value, '$.date_time'), 1, 2)
+                             || substr(json_extract(j.value, '$.date_time'), 11)
+                        ELSE COALESCE(json_extract(j.value, '$.date_time'), '') END
+            FROM jobsheet_detail d,
+                 json_each(CASE WHEN json_valid(d."%1")
+                                THEN CASE WHEN json_type(d."%1") = 'array' THEN d."%1" END END) j
+            WHERE d.job_no IS NOT NULL AND j.type = 'object'
+            ORDER BY d.rowid, CAST(j.key AS INTEGER)
+        )").arg(legacy.column, weightKey);
+
+        query.prepare(sql);
+        query.bindValue(":material", legacy.material);
+        query.bindValue(":direction", legacy.direction);
+        if (!query.exec()) {
+            qWarning() << "[ERROR] Failed to import" << legacy.column << ":" << query.lastError().text();
+            return false;
+        }
+    }
+
+    // Early builds stored the dust weight as a plain number instead of an array
+    if (existingColumns.contains("filling_dust")) {
+        if (!query.exec(R"(
+            INSERT INTO jobsheet_movements (job_no, material, direction, type, weight)
+            SELECT job_no, 'gold', 'dust', 'Dust', CAST(filling_dust AS REAL)
+            FROM jobsheet_detail
+            WHERE job_no IS NOT NULL
+              AND CASE WHEN json_valid(filling_dust) THEN json_type(filling_dust) IN ('integer', 'real') ELSE 0 END
+        )")) {
+            qWarning() << "[ERROR] Failed to import plain filling_dust values:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//Diagnostics
+void DatabaseUtils::logQueryPlans()
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (!db.isOpen()) {
+        qDebug() << "[ERROR] Failed to open DB in logQueryPlans:" << db.lastError().text();
+        return;
+    }
+
+    const QList<QPair<QString, const char *>> hotQueries = {
+        {"fetchOrderListDetails", OrderListSql},
+        {"fetchJobSheetRequests", JobSheetRequestsSql},
+    };
+
+    // Without the lookup indexes the joined tables show "SCAN" or "AUTOMATIC ... INDEX"
+    // (a temporary index built from a full scan on every run); after migration 0001
+    // they should read "SEARCH ... USING INDEX idx_..."
+    for (const auto &hot : hotQueries) {
+        const QStringList plan = SchemaMigrations::explainQueryPlan(db, hot.second);
+
+        QElapsedTimer timer;
+        timer.start();
+        int rows = 0;
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (query.exec(hot.second)) {
+            while (query.next())
+                ++rows;
+        }
+        const double ms = timer.nsecsElapsed() / 1e6;
+
+        qDebug() << "[PLAN]" << hot.first << rows << "rows in" << ms << "ms";
+        for (const QString &step : plan)
+            qDebug() << "    " << step;
+    }
+}
@@ -1,6 +1,7 @@
 #ifndef DATABASEUTILS_H
 #define DATABASEUTILS_H
 
+#include <QHash>
 #include <QJsonArray>
 #include <QMap>
 #include <QPixmap>
@@ -23,7 +24,7 @@ public:
         //Jewellry Menu
         static bool deleteJewelryMenuItem(int id);
         static bool insertJewelryMenuItem(int parentId, const QString &name, const QString &displayText);
-        static QList<QVariantList> fetchJewelryMenuItems();
+        static QList<JewelryMenuItem> fetchJewelryMenuItems();
 
         //Gold
         static QMap<QString, QString> fetchGoldPrices();
@@ -39,7 +40,7 @@ public:
         static QStringList fetchRoles();
         static QStringList fetchImagePaths();
         static bool deleteUser(const QString &userId);
-        static QList<QVariantList> fetchUserDetailsForAdmin();
+        static QList<UserSummary> fetchUserDetailsForAdmin();
         static QList<PdfRecord> getUserPdfs(const QString &userId); // Updated to return PdfRecord
         static bool checkAdminCredentials(const QString &username, const QString &password, QString &role);
         static bool createOrderBookUser(const QString &userId, const QString &userName,
@@ -65,22 +66,28 @@ public:
         static bool saveUserCart(const QString &userId, const QList<SelectionData> &selections);
 
         // Item / Image operations
-        static QList<ImageRecord> getAllItems();
-        static QPixmap fetchImagePixmap(int imageId);
+        // Catalog browsing: keyset pages of headers, full record only for the one on screen
+        static CatalogPage fetchCatalogPage(int afterImageId, int limit);
+        static std::optional<ImageRecord> fetchCatalogRecord(int imageId);
+        static QPixmap fetchImagePixmap(int imageId); // cart-sized thumbnail
+        static QList<CatalogHeader> fetchCatalogHeaders(const QList<int> &imageIds);
         static QString fetchJsonData(int imageId, const QString &column);
 
         // Details (Diamond, Stone, Gold)
         static QPair<QString, QString> fetchDiamondDetails(int imageId);
         static QPair<QString, QString> fetchStoneDetails(int imageId);
-        static double calculateTotalGoldWeight(const QList<SelectionData> &selections);
+        static QPair<QString, QString> fetchPieceDetails(int imageId, const QString &type); // type: "diamond" or "stone"
+
+        // Batch lookups for a whole cart or catalog page
+        // Child rows of the catalog_gold / catalog_diamond / catalog_stone tables, in JSON order
+        static QList<CatalogPiece> fetchCatalogPieces(const QList<int> &imageIds, const QString &type);
+        static QList<CatalogGold> fetchCatalogGold(const QList<int> &imageIds);
+        static QList<double> resolveWeights(const QList<WeightKey> &keys);
         static QJsonObject parseGoldJson(const QString &goldJson);
 
         // JSON utilities
         static QJsonArray parseJsonArray(const QString &json);
 
-        // UI / Summary Helpers
-        static void updateSummaryTable(QTableWidget *table, const QList<SelectionData> &selections, const QString &type);
-
 
     //Add Catalog Connection
         //All operation
@@ -94,7 +101,6 @@ public:
         static QJsonArray buildDiamondArray(const QList<QVariantMap> &diamondRows, const QString &designNo) ;
 
         static QJsonArray buildStoneArray(const QList<QVariantMap> &stoneRows, const QString &designNo);
-        static bool excelBulkInsertCatalog(const QString &filePath);
 
 
     // Login Window
@@ -135,7 +141,7 @@ public:
                                         const QString &note);
 
         // Order List
-        static QList<QVariantList> fetchOrderListDetails();
+        static QList<OrderListRow> fetchOrderListDetails();
 
     // JobSheet Connections
         // Image / Design
@@ -145,6 +151,18 @@ public:
         // Stone Details
         static void fillStoneTable(QTableWidget *table, const QString &designNo);
 
+        // Material Movements (jobsheet_movements ledger)
+        static bool insertJobSheetMovement(const JobSheetMovement &movement);
+        static QList<JobSheetMovement> fetchJobSheetMovements(const QString &jobNo, const QString &material,
+                                                              const QString &direction);
+        static QList<JobSheetMovementTotal> fetchJobSheetMovementTotals(const QString &jobNo);
+        // Data step of orderbook migration 0002: copies the legacy jobsheet_detail JSON columns
+        static bool importLegacyJobSheetMovements(QSqlDatabase &db);
+
+
+    // Diagnostics
+        // Logs the query plan and run time of the OrderList / JobSheet list queries
+        static void logQueryPlans();
 
 };
 
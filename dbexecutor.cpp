@@ -0,0 +1,48 @@
+#include "dbexecutor.h"
+
+namespace {
+thread_local const std::atomic_bool *currentCancelFlag = nullptr;
+}
+
+DbExecutor &DbExecutor::instance()
+{
+    static DbExecutor executor;
+    return executor;
+}
+
+DbExecutor::DbExecutor()
+    : workers(new QThreadPool)
+{
+    workers->setMaxThreadCount(WorkerCount);
+    // Keep idle workers alive; an expired thread would close its connections and
+    // throw away the prepared statements cached on them
+    workers->setExpiryTimeout(-1);
+}
+
+bool DbExecutor::isCancelled()
+{
+    return currentCancelFlag && currentCancelFlag->load();
+}
+
+void DbExecutor::shutdown()
+{
+    if (!workers)
+        return;
+
+    workers->clear();
+    workers->waitForDone();
+
+    // Deleting the pool joins its threads; each one releases its pooled connections as it finishes
+    delete workers;
+    workers = nullptr;
+}
+
+DbExecutor::CancelScope::CancelScope(const std::atomic_bool *flag)
+{
+    currentCancelFlag = flag;
+}
+
+DbExecutor::CancelScope::~CancelScope()
+{
+    currentCancelFlag = nullptr;
+}
@@ -0,0 +1,100 @@
+#ifndef DBEXECUTOR_H
+#define DBEXECUTOR_H
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+// Handle to a request submitted with a receiver. cancel() drops the result, and skips the
+// task entirely if a worker has not picked it up yet. Destroying the receiver cancels too.
+class DbRequest
+{
+public:
+    void cancel() { if (cancelled) cancelled->store(true); }
+    bool isCancelled() const { return cancelled && cancelled->load(); }
+
+private:
+    friend class DbExecutor;
+    std::shared_ptr<std::atomic_bool> cancelled = std::make_shared<std::atomic_bool>(false);
+};
+
+// Runs DatabaseUtils reads off the GUI thread.
+// A small set of long-lived workers owns its own pooled connections (and their statement
+// caches), so tasks may call any DatabaseUtils function that does not touch widgets.
+class DbExecutor
+{
+public:
+    static DbExecutor &instance();
+
+    // Queues task on a database worker
+    template <typename Task>
+    QFuture<std::invoke_result_t<Task>> submit(Task task);
+
+    // Queues task and calls onDone(result) on receiver's thread when it finishes.
+    // Nothing is delivered once the request is cancelled or receiver is destroyed.
+    template <typename Task, typename Done>
+    DbRequest submit(QObject *receiver, Task task, Done onDone);
+
+    // True inside a task whose request was cancelled; long loops should stop early
+    static bool isCancelled();
+
+    // Waits for running tasks and stops the workers, closing their connections.
+    // Call once on shutdown before ConnectionPool::closeAll().
+    void shutdown();
+
+private:
+    DbExecutor();
+    Q_DISABLE_COPY(DbExecutor)
+
+    static constexpr int WorkerCount = 2;
+
+    // Publishes the running task's cancel flag to isCancelled()
+    struct CancelScope {
+        explicit CancelScope(const std::atomic_bool *flag);
+        ~CancelScope();
+    };
+
+    QThreadPool *workers;
+};
+
+template <typename Task>
+QFuture<std::invoke_result_t<Task>> DbExecutor::submit(Task task)
+{
+    return QtConcurrent::run(workers, std::move(task));
+}
+
+template <typename Task, typename Done>
+DbRequest DbExecutor::submit(QObject *receiver, Task task, Done onDone)
+{
+    using Result = std::invoke_result_t<Task>;
+
+    DbRequest request;
+    const auto cancelled = request.cancelled;
+
+    // The watcher lives on the receiver, so closing a dialog deletes it and cancels the request
+    auto *watcher = new QFutureWatcher<Result>(receiver);
+    QObject::connect(watcher, &QObject::destroyed, [cancelled]() { cancelled->store(true); });
+    QObject::connect(watcher, &QFutureWatcherBase::finished, receiver, [watcher, cancelled, onDone]() {
+        QObject::disconnect(watcher, &QObject::destroyed, nullptr, nullptr);
+        if (!cancelled->load())
+            onDone(watcher->result());
+        watcher->deleteLater();
+    });
+
+    watcher->setFuture(submit([cancelled, task = std::move(task)]() -> Result {
+        if (cancelled->load())
+            return Result();
+        CancelScope scope(cancelled.get());
+        return task();
+    }));
+
+    return request;
+}
+
+#endif // DBEXECUTOR_H
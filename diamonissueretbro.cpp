@@ -1,7 +1,9 @@
 #include "diamonissueretbro.h"
 #include "ui_diamonissueretbro.h"
 #include <QMessageBox>
-#include <QSqlError>
+
+#include "databaseutils.h"
+#include "referencedatacache.h"
 
 DiamonIssueRetBro::DiamonIssueRetBro(QWidget *parent)
     : QDialog(parent)
@@ -103,36 +105,21 @@ void DiamonIssueRetBro::onRadioChanged()
 //
 void DiamonIssueRetBro::loadTypeOptions()
 {
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "diamond_popup_conn");
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) {
-        QMessageBox::warning(this, "DB Error", db.lastError().text());
-        return;
-    }
-
-    QSqlQuery query(db);
     QStringList types;
 
     if (ui->diamondRadioButton->isChecked()) {
-        // Fetch distinct shapes from Fancy_diamond and add "Round"
-        query.exec("SELECT DISTINCT shape FROM Fancy_diamond");
-        types << "Round";
-        while (query.next())
-            types << query.value(0).toString();
+        // "Round" first, then the fancy shapes
+        QStringList fancyShapes = ReferenceDataCache::instance().diamondShapes();
+        fancyShapes.removeAll("Round");
+        types << "Round" << fancyShapes;
     } else if (ui->stoneRadioButton->isChecked()) {
-        query.exec("SELECT DISTINCT shape FROM stones");
-        while (query.next())
-            types << query.value(0).toString();
+        types << ReferenceDataCache::instance().stoneShapes();
     } else {
         // Other: editable text
         ui->typeComboBox->setEditable(true);
     }
 
     ui->typeComboBox->addItems(types);
-    db.close();
-    QSqlDatabase::removeDatabase("diamond_popup_conn");
 }
 
 //
@@ -146,35 +133,15 @@ void DiamonIssueRetBro::onTypeChanged()
     if (type.isEmpty())
         return;
 
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "diamond_popup_conn2");
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_image.db");
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) return;
-
-    QSqlQuery query(db);
+    ReferenceDataCache &refData = ReferenceDataCache::instance();
 
     if (ui->diamondRadioButton->isChecked()) {
-        if (type == "Round") {
-            query.prepare("SELECT sizeMM FROM Round_diamond ORDER BY sizeMM ASC");
-        } else {
-            query.prepare("SELECT DISTINCT sizeMM FROM Fancy_diamond WHERE shape = ? ORDER BY sizeMM ASC");
-            query.addBindValue(type);
-        }
+        ui->sizeComboBox->addItems(type == "Round" ? refData.roundSizes() : refData.fancySizes(type));
     } else if (ui->stoneRadioButton->isChecked()) {
-        query.prepare("SELECT DISTINCT sizeMM FROM stones WHERE shape = ? ORDER BY sizeMM ASC");
-        query.addBindValue(type);
+        ui->sizeComboBox->addItems(refData.stoneSizes(type));
     } else {
         ui->sizeComboBox->setEnabled(false);
     }
-
-    if (query.exec()) {
-        while (query.next())
-            ui->sizeComboBox->addItem(query.value(0).toString());
-    }
-
-    db.close();
-    QSqlDatabase::removeDatabase("diamond_popup_conn2");
 }
 
 //
@@ -208,22 +175,9 @@ void DiamonIssueRetBro::onSaveClicked()
     // Round/format weight
     QString formattedWt = QString::number(wt, 'f', 3); // always 3 decimals
 
-    // Determine category
-    QString category;
-    if (ui->diamondRadioButton->isChecked()) category = "diamond";
-    else if (ui->stoneRadioButton->isChecked()) category = "stone";
-    else category = "other";
-
-    // Build JSON entry
-    QJsonObject entry;
-    entry["type"] = type;
-    entry["size"] = size;
-    entry["category"] = category;
-    entry["pcs"] = qty;
-    entry["wt"] = formattedWt;
-
-    // Save JSON into database
-    saveToDatabase(entry);
+    // Save one ledger entry
+    if (!saveToDatabase(type, size, qty, formattedWt.toDouble()))
+        return;
 
     // Emit signal to update main table
     QVariantMap vals;
@@ -237,79 +191,45 @@ void DiamonIssueRetBro::onSaveClicked()
 
 
 //
-// 🧭 Step 5: Save JSON Entry to DB
+// 🧭 Step 5: Append the entry to the jobsheet_movements ledger
 //
-void DiamonIssueRetBro::saveToDatabase(const QJsonObject &entry)
+QString DiamonIssueRetBro::selectedMaterial() const
 {
-    // QString colName;
-
-    QString baseName;
-
-    // 🧭 Decide base column using radio button, not row
+    // 🧭 Material comes from the radio buttons, not the row
     if (ui->diamondRadioButton->isChecked())
-        baseName = "diamond";
-    else if (ui->stoneRadioButton->isChecked())
-        baseName = "stone";
-    else if (ui->otherRadioButton->isChecked())
-        baseName = "other";
-    else
-        return; // no valid selection
-
-    // 🧭 Decide suffix based on mode (issue / return / broken)
-    QString colName;
-    if (currentMode == "issue")
-        colName = baseName + "_issue";
-    else if (currentMode == "return")
-        colName = baseName + "_return";
-    else if (currentMode == "broken")
-        colName = baseName + "_broken";  // optional, if you add broken later
-    else
-        return;
-
-
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "diamond_save_conn");
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) {
-        qDebug() << "❌ DB open failed:" << db.lastError().text();
-        return;
-    }
-
-    // // Ensure row exists
-    // QSqlQuery ensure(db);
-    // ensure.prepare("INSERT OR IGNORE INTO jobsheet_detail (job_no) VALUES (?)");
-    // ensure.addBindValue(currentJobNo);
-    // ensure.exec();
-
-    // Fetch existing JSON
-    QSqlQuery q(db);
-    q.prepare(QString("SELECT \"%1\" FROM jobsheet_detail WHERE job_no = ?").arg(colName));
-    q.addBindValue(currentJobNo);
-    QString existing;
-    if (q.exec() && q.next())
-        existing = q.value(0).toString();
-
-    QJsonArray arr;
-    if (!existing.isEmpty()) {
-        QJsonDocument doc = QJsonDocument::fromJson(existing.toUtf8());
-        if (doc.isArray()) arr = doc.array();
-    }
-
-    arr.append(entry);
-    QString jsonStr = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+        return "diamond";
+    if (ui->stoneRadioButton->isChecked())
+        return "stone";
+    if (ui->otherRadioButton->isChecked())
+        return "other";
+    return {};
+}
 
-    q.prepare(QString("UPDATE jobsheet_detail SET \"%1\" = ? WHERE job_no = ?").arg(colName));
-    q.addBindValue(jsonStr);
-    q.addBindValue(currentJobNo);
-    if (!q.exec()) {
-        qDebug() << "❌ Update failed:" << q.lastError().text();
-    } else {
-        qDebug() << "✅ Updated" << colName;
+bool DiamonIssueRetBro::saveToDatabase(const QString &type, const QString &size, int pcs, double weight)
+{
+    const QString material = selectedMaterial();
+    if (material.isEmpty())
+        return false; // no valid selection
+
+    // 🧭 Direction is the mode (issue / return / broken)
+    if (currentMode != "issue" && currentMode != "return" && currentMode != "broken")
+        return false;
+
+    JobSheetMovement movement;
+    movement.jobNo = currentJobNo;
+    movement.material = material;
+    movement.direction = currentMode;
+    movement.type = type;
+    movement.size = size;
+    movement.pcs = pcs;
+    movement.weight = weight;
+    movement.user = currentUser;
+
+    if (!DatabaseUtils::insertJobSheetMovement(movement)) {
+        QMessageBox::critical(this, "DB Error", "Failed to save the entry.");
+        return false;
     }
-
-    db.close();
-    QSqlDatabase::removeDatabase("diamond_save_conn");
+    return true;
 }
 
 // void DiamonIssueRetBro::onCancelClicked()
@@ -318,6 +238,11 @@ void DiamonIssueRetBro::saveToDatabase(const QJsonObject &entry)
 //     close();
 // }
 
+void DiamonIssueRetBro::setUser(const QString &user)
+{
+    currentUser = user;
+}
+
 void DiamonIssueRetBro::on_pushButton_clicked()
 {
     ui->stackedWidget->setCurrentIndex(1);
@@ -328,74 +253,20 @@ void DiamonIssueRetBro::loadHistoryForCurrentContext()
 {
     if (currentJobNo.isEmpty()) return;
 
-    // 🧭 Step 1: Determine base column from radio buttons
-    QString baseName;
-    if (ui->diamondRadioButton->isChecked())
-        baseName = "diamond";
-    else if (ui->stoneRadioButton->isChecked())
-        baseName = "stone";
-    else if (ui->otherRadioButton->isChecked())
-        baseName = "other";
-    else
-        return;
-
-    // 🧭 Step 2: Determine suffix based on mode
-    QString colName;
-    if (currentMode == "issue")
-        colName = baseName + "_issue";
-    else if (currentMode == "return")
-        colName = baseName + "_return";
-    else if (currentMode == "broken")
-        colName = baseName + "_broken";
-    else
-        return;
-
-    // 🧭 Step 3: Open DB connection
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "diamond_history_conn");
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) {
-        qDebug() << "❌ DB Open Failed:" << db.lastError().text();
+    const QString material = selectedMaterial();
+    if (material.isEmpty())
         return;
-    }
-
-    QSqlQuery q(db);
-    q.prepare(QString("SELECT \"%1\" FROM jobsheet_detail WHERE job_no = ?").arg(colName));
-    q.addBindValue(currentJobNo);
 
-    QString jsonStr;
-    if (q.exec() && q.next())
-        jsonStr = q.value(0).toString();
-
-    db.close();
-    QSqlDatabase::removeDatabase("diamond_history_conn");
-
-    // 🧭 Step 4: Clear and show history
     ui->historyTableWidget->setRowCount(0);
-    if (jsonStr.isEmpty()) return;
-
-    QJsonDocument doc = QJsonDocument::fromJson(jsonStr.toUtf8());
-    if (!doc.isArray()) return;
-
-    QJsonArray arr = doc.array();
-    int row = 0;
-    for (const QJsonValue &val : arr) {
-        if (!val.isObject()) continue;
-        QJsonObject obj = val.toObject();
-
-        ui->historyTableWidget->insertRow(row);
-        ui->historyTableWidget->setItem(row, 0, new QTableWidgetItem(obj["type"].toString()));
-        ui->historyTableWidget->setItem(row, 1, new QTableWidgetItem(obj["size"].toString()));
-
-        QString pcsStr = obj["pcs"].isString() ? obj["pcs"].toString() :
-                             QString::number(obj["pcs"].toInt());
-        QString wtStr  = obj["wt"].isString() ? obj["wt"].toString() :
-                            QString::number(obj["wt"].toDouble(), 'f', 3);
 
-        ui->historyTableWidget->setItem(row, 2, new QTableWidgetItem(pcsStr));
-        ui->historyTableWidget->setItem(row, 3, new QTableWidgetItem(wtStr));
-        row++;
+    const QList<JobSheetMovement> movements = DatabaseUtils::fetchJobSheetMovements(currentJobNo, material, currentMode);
+    ui->historyTableWidget->setRowCount(movements.size());
+    for (int row = 0; row < movements.size(); ++row) {
+        const JobSheetMovement &movement = movements[row];
+        ui->historyTableWidget->setItem(row, 0, new QTableWidgetItem(movement.type));
+        ui->historyTableWidget->setItem(row, 1, new QTableWidgetItem(movement.size));
+        ui->historyTableWidget->setItem(row, 2, new QTableWidgetItem(QString::number(movement.pcs)));
+        ui->historyTableWidget->setItem(row, 3, new QTableWidgetItem(QString::number(movement.weight, 'f', 3)));
     }
 }
 
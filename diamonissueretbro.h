@@ -15,6 +15,7 @@ public:
     explicit DiamonIssueRetBro(QWidget *parent = nullptr);
     ~DiamonIssueRetBro();
     void setContext(int row, int col, const QString &jobNo); // from JobSheet
+    void setUser(const QString &user); // recorded on every ledger entry
 
 signals:
     void menuHidden();
@@ -36,12 +37,14 @@ private:
     int currentRow;
     int currentCol;
     QString currentJobNo;
-    QString currentMode;  // "issue" or "return"
+    QString currentMode;  // "issue", "return" or "broken"
+    QString currentUser;
 
 
     void loadTypeOptions();
     void loadSizeOptions(const QString &type);
-    void saveToDatabase(const QJsonObject &entry);
+    QString selectedMaterial() const;
+    bool saveToDatabase(const QString &type, const QString &size, int pcs, double weight);
     void loadHistoryForCurrentContext();
 };
 #endif // DIAMONISSUERETBRO_H
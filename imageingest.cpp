@@ -0,0 +1,138 @@
+#include <QBuffer>
+#include <QDebug>
+#include <QFileInfo>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "dbexecutor.h"
+#include "imageingest.h"
+#include "imagestore.h"
+
+namespace {
+// Decoding is CPU bound; one thread per core, separate from the database workers
+QThreadPool &ingestPool()
+{
+    static QThreadPool pool;
+    return pool;
+}
+}
+
+ImageIngest::Options ImageIngest::options()
+{
+    return Options();
+}
+
+ImageIngest::Prepared ImageIngest::prepare(const QString &sourcePath)
+{
+    const Options opts = options();
+
+    Prepared prepared;
+    prepared.sourcePath = sourcePath;
+
+    QImageReader reader(sourcePath);
+    reader.setAutoTransform(true);
+    const QSize stored = reader.size();
+    const QByteArray format = reader.format().toLower();
+    if (!stored.isValid() || format.isEmpty()) {
+        qWarning() << "[WARNING] Not a readable image, storing as is:" << sourcePath << reader.errorString();
+        return prepared;
+    }
+    prepared.readable = true;
+
+    const bool upright = reader.transformation() == QImageIOHandler::TransformationNone;
+    const bool fits = qMax(stored.width(), stored.height()) <= opts.maxEdge;
+    const bool plainFormat = format == "jpeg" || format == "jpg" || format == "png";
+    if (upright && fits && plainFormat) {
+        prepared.size = stored;
+        return prepared;
+    }
+
+    // Scaled decode: the reader never materializes the full-resolution bitmap for JPEG
+    if (!fits)
+        reader.setScaledSize(stored.scaled(opts.maxEdge, opts.maxEdge, Qt::KeepAspectRatio));
+
+    const QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "[WARNING] Failed to decode image, storing as is:" << sourcePath << reader.errorString();
+        return prepared;
+    }
+
+    const bool alpha = image.hasAlphaChannel();
+    prepared.extension = alpha ? "png" : "jpg";
+    prepared.size = image.size();
+
+    QBuffer buffer(&prepared.data);
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, alpha ? "png" : "jpeg");
+    if (!alpha) {
+        writer.setQuality(opts.quality);
+        writer.setOptimizedWrite(true);
+        writer.setProgressiveScanWrite(true);
+    }
+    if (!writer.write(image)) {
+        qWarning() << "[WARNING] Failed to encode image, storing as is:" << sourcePath << writer.errorString();
+        prepared.data.clear();
+        prepared.extension.clear();
+    }
+    return prepared;
+}
+
+QList<ImageIngest::Prepared> ImageIngest::prepareAll(const QStringList &sourcePaths)
+{
+    QList<QFuture<Prepared>> futures;
+    futures.reserve(sourcePaths.size());
+    for (const QString &path : sourcePaths)
+        futures.append(QtConcurrent::run(&ingestPool(), [path]() { return prepare(path); }));
+
+    QList<Prepared> results;
+    results.reserve(futures.size());
+    for (QFuture<Prepared> &future : futures)
+        results.append(future.result());
+    return results;
+}
+
+QString ImageIngest::store(const Prepared &prepared)
+{
+    if (prepared.data.isEmpty())
+        return ImageStore::ingest(prepared.sourcePath);
+
+    QString originalHash;
+    if (options().keepOriginal) {
+        const QString original = ImageStore::ingest(prepared.sourcePath);
+        if (!original.isEmpty())
+            originalHash = QFileInfo(original).completeBaseName();
+    }
+
+    const QString storePath = ImageStore::ingestData(prepared.data, prepared.extension, prepared.size, originalHash);
+    if (!storePath.isEmpty()) {
+        qDebug() << "Image normalized:" << prepared.sourcePath << QFileInfo(prepared.sourcePath).size() << "->"
+                 << prepared.data.size() << "bytes," << prepared.size;
+    }
+    return storePath;
+}
+
+QString ImageIngest::ingest(const QString &sourcePath)
+{
+    if (!QFileInfo::exists(sourcePath)) {
+        qWarning() << "[WARNING] Source image does not exist:" << sourcePath;
+        return {};
+    }
+    return store(prepare(sourcePath));
+}
+
+void ImageIngest::ingestAsync(QObject *receiver, const QString &sourcePath,
+                              std::function<void(const QString &)> onDone)
+{
+    // The watcher lives on the receiver, so a closed dialog never sees the result
+    auto *watcher = new QFutureWatcher<Prepared>(receiver);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, receiver, [receiver, watcher, onDone]() {
+        const Prepared prepared = watcher->result();
+        watcher->deleteLater();
+        DbExecutor::instance().submit(receiver, [prepared]() { return store(prepared); }, onDone);
+    });
+    watcher->setFuture(QtConcurrent::run(&ingestPool(), [sourcePath]() { return prepare(sourcePath); }));
+}
@@ -0,0 +1,59 @@
+#ifndef IMAGEINGEST_H
+#define IMAGEINGEST_H
+
+#include <QByteArray>
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+class QObject;
+
+// Normalizes photos before they enter the image store.
+// Camera and phone pictures are turned upright from their EXIF orientation, scaled down to
+// maxEdge and re-encoded (JPEG at quality, PNG when the picture has transparency), so no
+// viewer has to decode a multi-megapixel original again. Pictures that are already upright,
+// small enough and JPEG/PNG are stored byte for byte.
+class ImageIngest
+{
+public:
+    // Built-in ingest settings; not user configurable
+    struct Options {
+        int maxEdge = 2048;         // longest side in pixels after ingest
+        int quality = 85;           // JPEG quality, 0-100
+        bool keepOriginal = false;  // also store the untouched file, linked from the normalized blob
+    };
+
+    // A decoded and re-encoded picture, ready for ImageStore::ingestData()
+    struct Prepared {
+        QString sourcePath;
+        QByteArray data;            // empty when the source is stored unchanged
+        QString extension;
+        QSize size;
+        bool readable = false;
+    };
+
+    static Options options();
+
+    // Decodes, orients, scales and encodes sourcePath. Pure CPU work; safe on any thread.
+    static Prepared prepare(const QString &sourcePath);
+
+    // prepare() for many files at once on the ingest worker pool, results in input order
+    static QList<Prepared> prepareAll(const QStringList &sourcePaths);
+
+    // Writes a prepared picture to the image store on the calling thread and returns its
+    // store path, empty on failure. Unreadable files are stored as they are.
+    static QString store(const Prepared &prepared);
+
+    // prepare() + store()
+    static QString ingest(const QString &sourcePath);
+
+    // ingest() off the GUI thread: prepare() on the ingest pool, store() on a database
+    // worker, then onDone(storePath) on receiver's thread. Dropped if receiver is destroyed.
+    static void ingestAsync(QObject *receiver, const QString &sourcePath,
+                            std::function<void(const QString &storePath)> onDone);
+};
+
+#endif // IMAGEINGEST_H
@@ -0,0 +1,135 @@
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "imageprefetcher.h"
+#include "thumbnailcache.h"
+
+ImagePrefetcher::ImagePrefetcher(QObject *parent)
+    : QObject(parent)
+{
+    // Two decoders: the requested image and its nearest neighbour in parallel
+    workers.setMaxThreadCount(2);
+}
+
+ImagePrefetcher::~ImagePrefetcher()
+{
+    generation->fetch_add(1);
+    workers.clear();
+    workers.waitForDone();
+}
+
+void ImagePrefetcher::setPaths(const QStringList &newPaths)
+{
+    paths = newPaths;
+    generation->fetch_add(1);
+    decoded.clear();
+    pending.clear();
+    current = -1;
+    currentIndex->store(-1);
+}
+
+void ImagePrefetcher::appendPaths(const QStringList &morePaths)
+{
+    paths += morePaths;
+
+    // Neighbours past the old end can be scheduled now
+    if (current >= 0) {
+        for (int step = 1; step <= radius; ++step)
+            schedule(current + step);
+    }
+}
+
+void ImagePrefetcher::setRadius(int newRadius)
+{
+    radius = qMax(0, newRadius);
+}
+
+QImage ImagePrefetcher::request(int index, const QSize &newBox)
+{
+    if (index < 0 || index >= paths.size() || newBox.isEmpty())
+        return {};
+
+    if (newBox != box) {
+        box = newBox;
+        generation->fetch_add(1);
+        decoded.clear();
+        pending.clear();
+    }
+
+    current = index;
+    currentIndex->store(index);
+
+    // Keep only the window around the current image
+    for (auto it = decoded.begin(); it != decoded.end();) {
+        if (inWindow(it.key()))
+            ++it;
+        else
+            it = decoded.erase(it);
+    }
+
+    // Current image first, then neighbours outward, next before previous
+    schedule(index);
+    for (int step = 1; step <= radius; ++step) {
+        schedule(index + step);
+        schedule(index - step);
+    }
+
+    return decoded.value(index);
+}
+
+bool ImagePrefetcher::inWindow(int index) const
+{
+    return current >= 0 && qAbs(index - current) <= radius;
+}
+
+void ImagePrefetcher::schedule(int index)
+{
+    if (index < 0 || index >= paths.size() || decoded.contains(index) || pending.contains(index))
+        return;
+
+    pending.insert(index);
+
+    const QString path = paths[index];
+    const QSize size = box;
+    const int requestGeneration = generation->load();
+    const int windowRadius = radius;
+    const auto generationFlag = generation;
+    const auto currentFlag = currentIndex;
+    const auto skipped = std::make_shared<std::atomic_bool>(false);
+
+    auto *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, index, requestGeneration, skipped]() {
+        watcher->deleteLater();
+        if (requestGeneration != generation->load())
+            return; // paths or view size changed meanwhile
+
+        pending.remove(index);
+        if (!inWindow(index))
+            return;
+
+        // Skipped while out of the window, but the user has come back to it
+        if (skipped->load()) {
+            schedule(index);
+            return;
+        }
+
+        const QImage image = watcher->result();
+        if (image.isNull()) {
+            emit imageFailed(index);
+            return;
+        }
+
+        decoded.insert(index, image);
+        emit imageReady(index, image);
+    });
+
+    watcher->setFuture(QtConcurrent::run(&workers, [=]() -> QImage {
+        // Skip work the user has already scrolled past
+        if (requestGeneration != generationFlag->load()
+            || qAbs(index - currentFlag->load()) > windowRadius) {
+            skipped->store(true);
+            return QImage();
+        }
+        return ThumbnailCache::instance().image(path, size);
+    }));
+}
@@ -0,0 +1,65 @@
+#ifndef IMAGEPREFETCHER_H
+#define IMAGEPREFETCHER_H
+
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QSize>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+
+// Decodes the images around the one being viewed on worker threads, so next/previous in a
+// catalog shows an already decoded image instead of reading the file on the GUI thread.
+// Images are decoded at the view size through ThumbnailCache (QImageReader scaled decode)
+// and handed back to the owner's thread with imageReady(), or imageFailed() when a file
+// cannot be decoded.
+class ImagePrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImagePrefetcher(QObject *parent = nullptr);
+    ~ImagePrefetcher() override;
+
+    // Image paths in navigation order; drops everything decoded for the previous list
+    void setPaths(const QStringList &paths);
+
+    // Adds paths after the existing ones; decoded images stay valid
+    void appendPaths(const QStringList &morePaths);
+
+    // How many images ahead of and behind the current one are kept decoded
+    void setRadius(int radius);
+
+    // Makes index the current image and schedules it and its neighbours at box size.
+    // Returns the image right away when it is already decoded; otherwise imageReady() or
+    // imageFailed() follows.
+    QImage request(int index, const QSize &box);
+
+signals:
+    void imageReady(int index, const QImage &image);
+    void imageFailed(int index);
+
+private:
+    void schedule(int index);
+    bool inWindow(int index) const;
+
+    QThreadPool workers;
+    QStringList paths;
+    QSize box;
+    int radius = 3;
+    int current = -1;
+
+    // Bumped whenever paths or box change; results of an older generation are dropped
+    std::shared_ptr<std::atomic_int> generation = std::make_shared<std::atomic_int>(0);
+    // Read by workers to skip neighbours the user has already moved away from
+    std::shared_ptr<std::atomic_int> currentIndex = std::make_shared<std::atomic_int>(-1);
+
+    QHash<int, QImage> decoded;
+    QSet<int> pending;
+};
+
+#endif // IMAGEPREFETCHER_H
@@ -0,0 +1,329 @@
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QSet>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "connectionpool.h"
+#include "imagestore.h"
+
+namespace {
+const char *const StoreRelativeDir = "images/store";
+
+QString timestamp(const QDateTime &time)
+{
+    return time.toUTC().toString("yyyy-MM-dd HH:mm:ss");
+}
+}
+
+QString ImageStore::storeDirectory()
+{
+    return QDir(QCoreApplication::applicationDirPath()).filePath(StoreRelativeDir);
+}
+
+QString ImageStore::absolutePath(const QString &storePath)
+{
+    return QDir(QCoreApplication::applicationDirPath()).filePath(storePath);
+}
+
+bool ImageStore::isStorePath(const QString &path)
+{
+    const QString normalized = QDir::fromNativeSeparators(path);
+    return normalized.startsWith(QString(StoreRelativeDir) + '/')
+           || normalized.startsWith(storeDirectory() + '/');
+}
+
+QString ImageStore::referenceName(const QString &path)
+{
+    // Backslashes are not separators on every platform, but order paths may come from Windows
+    QString normalized = path.trimmed();
+    normalized.replace('\\', '/');
+    return normalized.mid(normalized.lastIndexOf('/') + 1);
+}
+
+QString ImageStore::hashFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[ERROR] Cannot read image for hashing:" << path << file.errorString();
+        return {};
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) {
+        qWarning() << "[ERROR] Failed to hash image:" << path;
+        return {};
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+bool ImageStore::copyInto(const QString &sourcePath, const QString &targetPath)
+{
+    QDir().mkpath(QFileInfo(targetPath).absolutePath());
+
+    // Copy under a temporary name and rename, so a crash never leaves a truncated blob
+    // under its final name
+    const QString partPath = targetPath + ".part";
+    QFile::remove(partPath);
+    if (!QFile::copy(sourcePath, partPath)) {
+        qWarning() << "[ERROR] Failed to copy image from" << sourcePath << "to" << partPath;
+        return false;
+    }
+    QFile::remove(targetPath);
+    if (!QFile::rename(partPath, targetPath)) {
+        qWarning() << "[ERROR] Failed to move image into store:" << targetPath;
+        QFile::remove(partPath);
+        return false;
+    }
+    return true;
+}
+
+QString ImageStore::recordBlob(const Blob &blob)
+{
+    const QString candidate = QString("%1/%2/%3%4").arg(StoreRelativeDir, blob.hash.left(2), blob.hash,
+                                                         blob.extension.isEmpty() ? QString() : "." + blob.extension);
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in ImageStore:" << db.lastError().text();
+        return {};
+    }
+
+    // The upsert takes the write lock, so it waits for a collection pass that is removing
+    // this blob and then sees the file gone; touching last_ingest_at keeps the next pass
+    // away from a blob that is about to be referenced again
+    {
+        PooledQuery upsert = ConnectionPool::instance().prepare(db, R"(
+            INSERT INTO image_blobs (hash, path, bytes, refcount, last_ingest_at, width, height, original_hash)
+            VALUES (:hash, :path, :bytes, 0, :now, :width, :height, :originalHash)
+            ON CONFLICT(hash) DO UPDATE SET
+                last_ingest_at = excluded.last_ingest_at,
+                width = COALESCE(image_blobs.width, excluded.width),
+                height = COALESCE(image_blobs.height, excluded.height),
+                original_hash = COALESCE(image_blobs.original_hash, excluded.original_hash)
+        )");
+        upsert->bindValue(":hash", blob.hash);
+        upsert->bindValue(":path", candidate);
+        upsert->bindValue(":bytes", blob.bytes);
+        upsert->bindValue(":now", timestamp(QDateTime::currentDateTimeUtc()));
+        upsert->bindValue(":width", blob.size.isValid() ? QVariant(blob.size.width()) : QVariant());
+        upsert->bindValue(":height", blob.size.isValid() ? QVariant(blob.size.height()) : QVariant());
+        upsert->bindValue(":originalHash", blob.originalHash.isEmpty() ? QVariant() : QVariant(blob.originalHash));
+        if (!upsert->exec()) {
+            qWarning() << "[ERROR] Failed to record image blob:" << upsert->lastError().text();
+            return {};
+        }
+    }
+
+    // Identical bytes ingested earlier under another extension keep their first name
+    PooledQuery lookup = ConnectionPool::instance().prepare(db, "SELECT path FROM image_blobs WHERE hash = :hash");
+    lookup->bindValue(":hash", blob.hash);
+    if (lookup->exec() && lookup->next())
+        return lookup->value(0).toString();
+    return candidate;
+}
+
+QString ImageStore::ingest(const QString &sourcePath)
+{
+    const QFileInfo sourceInfo(sourcePath);
+    if (!sourceInfo.exists()) {
+        qWarning() << "[WARNING] Source image does not exist:" << sourcePath;
+        return {};
+    }
+
+    Blob blob;
+    blob.hash = hashFile(sourcePath);
+    if (blob.hash.isEmpty())
+        return {};
+    blob.extension = sourceInfo.suffix().toLower();
+    blob.bytes = sourceInfo.size();
+    blob.size = QImageReader(sourcePath).size();   // header only
+
+    const QString storePath = recordBlob(blob);
+    if (storePath.isEmpty())
+        return {};
+
+    const QString target = absolutePath(storePath);
+    const QFileInfo targetInfo(target);
+    if (targetInfo.exists() && targetInfo.size() == sourceInfo.size()) {
+        qDebug() << "Image already in store, reusing:" << storePath;
+        return storePath;
+    }
+
+    return copyInto(sourcePath, target) ? storePath : QString();
+}
+
+QString ImageStore::ingestData(const QByteArray &data, const QString &extension, const QSize &size,
+                               const QString &originalHash)
+{
+    Blob blob;
+    blob.hash = QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+    blob.extension = extension.toLower();
+    blob.bytes = data.size();
+    blob.size = size;
+    blob.originalHash = originalHash;
+
+    const QString storePath = recordBlob(blob);
+    if (storePath.isEmpty())
+        return {};
+
+    const QString target = absolutePath(storePath);
+    const QFileInfo targetInfo(target);
+    if (targetInfo.exists() && targetInfo.size() == data.size()) {
+        qDebug() << "Image already in store, reusing:" << storePath;
+        return storePath;
+    }
+
+    QDir().mkpath(targetInfo.absolutePath());
+    QSaveFile file(target);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "[ERROR] Failed to write image into store:" << target << file.errorString();
+        return {};
+    }
+    return storePath;
+}
+
+ImageStore::GcResult ImageStore::collectGarbage(int graceHours)
+{
+    GcResult result;
+
+    // Order images are stored as absolute paths in the order book, possibly written by an
+    // install in another folder or on another machine, so no prefix is required: any path
+    // whose file name is a blob's keeps that blob
+    QSet<QString> orderReferences;
+    {
+        QSqlDatabase orderDb = ConnectionPool::instance().acquire(DbFile::OrderBook);
+        if (!orderDb.isOpen()) {
+            qWarning() << "[ERROR] Image store collection skipped; order book unavailable:" << orderDb.lastError().text();
+            return result;
+        }
+        QSqlQuery orders(orderDb);
+        if (!orders.exec(R"(SELECT image1Path, image2Path FROM "OrderBook-Detail")")) {
+            qWarning() << "[ERROR] Image store collection skipped:" << orders.lastError().text();
+            return result;
+        }
+        while (orders.next()) {
+            for (int column = 0; column < 2; ++column) {
+                const QString name = referenceName(orders.value(column).toString());
+                if (!name.isEmpty())
+                    orderReferences.insert(name);
+            }
+        }
+    }
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Failed to open DB in ImageStore::collectGarbage:" << db.lastError().text();
+        return result;
+    }
+
+    if (!db.transaction()) {
+        qWarning() << "[ERROR] Image store collection could not start a transaction:" << db.lastError().text();
+        return result;
+    }
+
+    struct Candidate {
+        QString hash;
+        QString path;
+        qint64 bytes = 0;
+    };
+    QList<Candidate> deleted;
+    {
+        QSqlQuery candidates(db);
+        const QString cutoff = timestamp(QDateTime::currentDateTimeUtc().addSecs(-3600LL * qMax(0, graceHours)));
+        // Originals kept by the ingest pipeline live as long as their normalized copy
+        candidates.prepare(R"(
+            SELECT hash, path, bytes FROM image_blobs
+            WHERE refcount <= 0 AND last_ingest_at <= :cutoff
+              AND hash NOT IN (SELECT original_hash FROM image_blobs WHERE original_hash IS NOT NULL)
+        )");
+        candidates.bindValue(":cutoff", cutoff);
+        if (!candidates.exec()) {
+            qWarning() << "[ERROR] Image store collection query failed:" << candidates.lastError().text();
+            db.rollback();
+            return result;
+        }
+
+        QList<Candidate> unreferenced;
+        while (candidates.next()) {
+            const QString path = candidates.value(1).toString();
+            if (!orderReferences.contains(referenceName(path)))
+                unreferenced.append({candidates.value(0).toString(), path, candidates.value(2).toLongLong()});
+        }
+        candidates.finish();
+
+        QSqlQuery remove(db);
+        // Re-checked per row: an ingest may have touched the blob since the scan
+        remove.prepare("DELETE FROM image_blobs WHERE hash = :hash AND refcount <= 0 AND last_ingest_at <= :cutoff");
+        remove.bindValue(":cutoff", cutoff);
+
+        for (const Candidate &blob : std::as_const(unreferenced)) {
+            remove.bindValue(":hash", blob.hash);
+            if (remove.exec() && remove.numRowsAffected() == 1)
+                deleted.append(blob);
+        }
+    }
+
+    if (!db.commit()) {
+        qWarning() << "[ERROR] Image store collection commit failed:" << db.lastError().text();
+        db.rollback();
+        return result;
+    }
+
+    // Files go only once their rows are gone for good. Identical bytes ingested since the
+    // commit record the blob again and reuse a file they find, so each file is re-checked
+    // under the write lock, which recordBlob() waits for; see ingest().
+    if (!deleted.isEmpty()) {
+        QSqlQuery lock(db);
+        if (!lock.exec("BEGIN IMMEDIATE")) {
+            qWarning() << "[WARNING] Image store collection left" << deleted.size()
+                       << "unreferenced files in place:" << lock.lastError().text();
+            return result;
+        }
+
+        QSqlQuery recorded(db);
+        recorded.prepare("SELECT 1 FROM image_blobs WHERE hash = :hash");
+        for (const Candidate &blob : std::as_const(deleted)) {
+            recorded.bindValue(":hash", blob.hash);
+            if (!recorded.exec() || recorded.next())
+                continue;
+            recorded.finish();
+
+            const QString file = absolutePath(blob.path);
+            if (!QFile::exists(file)) {
+                ++result.missing;
+            } else if (QFile::remove(file)) {
+                ++result.removed;
+                result.freedBytes += blob.bytes;
+            } else {
+                qWarning() << "[WARNING] Could not delete unreferenced image:" << file;
+            }
+        }
+        recorded.finish();
+        lock.exec("COMMIT");
+    }
+
+    // Referenced blobs whose file disappeared are worth knowing about
+    QSqlQuery referenced(db);
+    if (referenced.exec("SELECT path FROM image_blobs WHERE refcount > 0")) {
+        while (referenced.next()) {
+            const QString path = referenced.value(0).toString();
+            if (!QFile::exists(absolutePath(path))) {
+                ++result.missing;
+                qWarning() << "[WARNING] Image store file missing:" << path;
+            }
+        }
+    }
+
+    if (result.removed > 0 || result.missing > 0)
+        qDebug() << "Image store collection removed" << result.removed << "files," << result.freedBytes
+                 << "bytes;" << result.missing << "missing";
+    return result;
+}
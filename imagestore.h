@@ -0,0 +1,61 @@
+#ifndef IMAGESTORE_H
+#define IMAGESTORE_H
+
+#include <QByteArray>
+#include <QSize>
+#include <QString>
+
+// Content-addressed store for catalog and order images.
+// Files are copied once to images/store/<xx>/<sha256>.<ext> and recorded in image_blobs, so
+// importing the same photo again (re-imports, bulk sheets, the same picture on several
+// orders) reuses the existing file. Catalog references are counted by triggers on
+// image_data; collectGarbage() removes blobs nothing points at any more.
+class ImageStore
+{
+public:
+    struct GcResult {
+        int removed = 0;
+        qint64 freedBytes = 0;
+        int missing = 0;    // recorded blobs whose file is gone
+    };
+
+    // Blobs ingested more recently than this are never collected, so a file picked in a
+    // dialog that has not been saved yet survives a collection pass
+    static constexpr int DefaultGraceHours = 24;
+
+    // Adds sourcePath's bytes to the store unless they are already there.
+    // Returns the blob's path relative to the application directory, empty on failure.
+    static QString ingest(const QString &sourcePath);
+
+    // Same for an already encoded image (see ImageIngest). size is recorded as the blob's
+    // dimensions; originalHash names the blob of the unprocessed file when it was kept.
+    static QString ingestData(const QByteArray &data, const QString &extension, const QSize &size,
+                              const QString &originalHash = QString());
+
+    static QString absolutePath(const QString &storePath);
+    static bool isStorePath(const QString &path);
+
+    // Lowercase hex SHA-256 of the file, empty if it cannot be read
+    static QString hashFile(const QString &path);
+
+    // Deletes unreferenced blobs older than graceHours; files only once their rows are committed gone
+    static GcResult collectGarbage(int graceHours = DefaultGraceHours);
+
+private:
+    struct Blob {
+        QString hash;
+        QString extension;
+        qint64 bytes = 0;
+        QSize size;
+        QString originalHash;
+    };
+
+    // Upserts blob's row and returns its store path
+    static QString recordBlob(const Blob &blob);
+    static QString storeDirectory();
+    static bool copyInto(const QString &sourcePath, const QString &targetPath);
+    // Name an order path is matched on; blob file names are unique across the store
+    static QString referenceName(const QString &path);
+};
+
+#endif // IMAGESTORE_H
@@ -51,29 +51,25 @@ JewelryMenu::~JewelryMenu()
 
 void JewelryMenu::populateMenu()
 {
-    QList<QVariantList> menuItems = DatabaseUtils::fetchJewelryMenuItems();
+    const QList<JewelryMenuItem> menuItems = DatabaseUtils::fetchJewelryMenuItems();
 
     QMap<int, QMenu*> menuMap;
     menuMap[-1] = menu; // Root menu for top-level categories
 
     // First pass: Create all top-level categories
-    for (const QVariantList &item : menuItems) {
-        int id = item[0].toInt();
-        int parentId = item[1].isNull() ? -1 : item[1].toInt();
-        QString name = item[2].toString();
-
-        if (parentId == -1) {
-            QMenu *subMenu = menu->addMenu(name);
-            menuMap[id] = subMenu;
+    for (const JewelryMenuItem &item : menuItems) {
+        if (item.parentId == -1) {
+            QMenu *subMenu = menu->addMenu(item.name);
+            menuMap[item.id] = subMenu;
         }
     }
 
     // Second pass: Add sub-items to their parent menus
-    for (const QVariantList &item : menuItems) {
-        int id = item[0].toInt();
-        int parentId = item[1].isNull() ? -1 : item[1].toInt();
-        QString name = item[2].toString();
-        QString displayText = item[3].toString();
+    for (const JewelryMenuItem &item : menuItems) {
+        const int id = item.id;
+        const int parentId = item.parentId;
+        const QString &name = item.name;
+        const QString displayText = item.displayText;
 
         if (parentId != -1) {
             QMenu *parentMenu = menuMap.value(parentId, nullptr);
@@ -9,6 +9,7 @@
 #include <QLabel>
 #include <QInputDialog>
 
+#include "connectionpool.h"
 #include "databaseutils.h"
 
 JobSheet::JobSheet(QWidget *parent, const QString &jobNo, const QString &role)
@@ -435,6 +436,7 @@ void JobSheet::onGoldDetailCellClicked(QTableWidgetItem *item)
             newManageGold = new ManageGold(this);
             newManageGold->setWindowFlags(Qt::FramelessWindowHint | Qt::Popup);
             newManageGold->setAttribute(Qt::WA_DeleteOnClose, false);
+            newManageGold->setUser(userRole);
 
             connect(newManageGold, &ManageGold::menuHidden, this, [this]() {
                 qApp->removeEventFilter(this);
@@ -495,74 +497,45 @@ void JobSheet::updateGoldTotalWeight()
     double settingReturn = 0.0;
     double finalPolishReturn = 0.0;
 
-    // --- Open DB ---
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "weight_fetch_conn");
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-    db.setDatabaseName(dbPath);
+    // --- Ledger totals (issue / dust / return) ---
+    double productWeight = 0.0;
+    bool hasDust = false;
+    for (const JobSheetMovementTotal &total : DatabaseUtils::fetchJobSheetMovementTotals(jobNo)) {
+        if (total.material != "gold")
+            continue;
+        if (total.direction == "issue") {
+            totalIssueWeight = total.weight;
+        } else if (total.direction == "return") {
+            totalReturnWeight = total.weight;
+            productWeight = total.productWeight;
+        } else if (total.direction == "dust") {
+            dustWeight = total.weight;
+            hasDust = true;
+        }
+    }
 
-    QString returnJson;
+    if (hasDust) {
+        int row = 0, col = 2;
+        QTableWidgetItem *dustItem = ui->goldDetailTableWidget->item(row, col);
+        if (!dustItem) dustItem = new QTableWidgetItem();
+        ui->goldDetailTableWidget->setItem(row, col, dustItem);
+        dustItem->setText(QString::number(dustWeight, 'f', 3));
+    }
 
-    if (db.open()) {
-        QSqlQuery query(db);
-        query.prepare(R"(
-            SELECT filling_issue, filling_dust, filling_return,
-                   buffing_return, free_polish_return, setting_return, final_polish_return
+    // --- Stage returns ---
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::OrderBook);
+    if (db.isOpen()) {
+        PooledQuery query = ConnectionPool::instance().prepare(db, R"(
+            SELECT buffing_return, free_polish_return, setting_return, final_polish_return
             FROM jobsheet_detail WHERE job_no = ?
         )");
-        query.addBindValue(jobNo);
-
-        if (query.exec() && query.next()) {
-            // --- Issue JSON ---
-            QString issueJson = query.value(0).toString();
-            if (!issueJson.isEmpty()) {
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(issueJson.toUtf8(), &parseError);
-                if (parseError.error == QJsonParseError::NoError && doc.isArray()) {
-                    for (const QJsonValue &val : doc.array())
-                        if (val.isObject())
-                            totalIssueWeight += val.toObject()["weight"].toString().toDouble();
-                }
-            }
+        query->bindValue(0, jobNo);
 
-            // --- Dust JSON ---
-            QString dustJson = query.value(1).toString();
-            if (!dustJson.isEmpty()) {
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(dustJson.toUtf8(), &parseError);
-                if (parseError.error == QJsonParseError::NoError && doc.isArray()) {
-                    for (const QJsonValue &val : doc.array())
-                        if (val.isObject())
-                            dustWeight += val.toObject()["weight"].toString().toDouble();
-                } else {
-                    bool ok = false;
-                    double plainDust = dustJson.toDouble(&ok);
-                    if (ok) dustWeight = plainDust;
-                }
-
-                int row = 0, col = 2;
-                QTableWidgetItem *dustItem = ui->goldDetailTableWidget->item(row, col);
-                if (!dustItem) dustItem = new QTableWidgetItem();
-                ui->goldDetailTableWidget->setItem(row, col, dustItem);
-                dustItem->setText(QString::number(dustWeight, 'f', 3));
-            }
-
-            // --- Return JSON ---
-            returnJson = query.value(2).toString();
-            if (!returnJson.isEmpty()) {
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(returnJson.toUtf8(), &parseError);
-                if (parseError.error == QJsonParseError::NoError && doc.isArray()) {
-                    for (const QJsonValue &val : doc.array())
-                        if (val.isObject())
-                            totalReturnWeight += val.toObject()["weight"].toString().toDouble();
-                }
-            }
-
-            // --- Stage returns ---
-            buffingReturn     = query.value(3).toDouble();
-            freePolishReturn  = query.value(4).toDouble();
-            settingReturn     = query.value(5).toDouble();
-            finalPolishReturn = query.value(6).toDouble();
+        if (query->exec() && query->next()) {
+            buffingReturn     = query->value(0).toDouble();
+            freePolishReturn  = query->value(1).toDouble();
+            settingReturn     = query->value(2).toDouble();
+            finalPolishReturn = query->value(3).toDouble();
 
             auto setCell = [this](int row, int col, double val) {
                 QTableWidgetItem *it = ui->goldDetailTableWidget->item(row, col);
@@ -578,22 +551,7 @@ void JobSheet::updateGoldTotalWeight()
             setCell(3, 4, settingReturn);
             setCell(4, 4, finalPolishReturn);
         }
-        db.close();
     }
-    QSqlDatabase::removeDatabase("weight_fetch_conn");
-
-    // --- Helper: product weight ---
-    auto getProductWeight = [](const QString &returnJson) -> double {
-        if (returnJson.isEmpty()) return 0.0;
-        QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson(returnJson.toUtf8(), &parseError);
-        if (parseError.error != QJsonParseError::NoError || !doc.isArray()) return 0.0;
-        double productWeight = 0.0;
-        for (const QJsonValue &val : doc.array())
-            if (val.isObject() && val.toObject()["type"].toString() == "Product")
-                productWeight += val.toObject()["weight"].toString().toDouble();
-        return productWeight;
-    };
 
     // --- Fill base table values ---
     auto setItemVal = [this](int row, int col, double val) {
@@ -605,7 +563,6 @@ void JobSheet::updateGoldTotalWeight()
     setItemVal(0, 1, totalIssueWeight);
     setItemVal(0, 4, totalReturnWeight);
 
-    double productWeight = getProductWeight(returnJson);
     setItemVal(1, 1, productWeight);
 
     auto copyCell = [this](int fromRow, int fromCol, int toRow, int toCol) {
@@ -749,68 +706,33 @@ void JobSheet::updateDiamondTotals()
     if (jobNo.isEmpty())
         return;
 
-    // ✅ Open DB
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "diamond_total_conn");
-    QString dbPath = QDir(QCoreApplication::applicationDirPath())
-                         .filePath("database/mega_mine_orderbook.db");
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) {
-        QMessageBox::warning(this, "DB Error", db.lastError().text());
-        return;
-    }
-
-    // ✅ Helper lambda: read total pcs & wt from a given column name
-    auto getTotals = [&](const QString &column) -> QPair<int, double> {
-        int totalPcs = 0;
-        double totalWt = 0.0;
-
-        QSqlQuery q(db);
-        q.prepare(QString("SELECT \"%1\" FROM jobsheet_detail WHERE job_no = ?").arg(column));
-        q.addBindValue(jobNo);
+    // ✅ One GROUP BY over the ledger for every material and direction
+    QHash<QPair<QString, QString>, QPair<int, double>> totals;
+    for (const JobSheetMovementTotal &total : DatabaseUtils::fetchJobSheetMovementTotals(jobNo))
+        totals.insert({total.material, total.direction}, {total.pcs, total.weight});
 
-        if (q.exec() && q.next()) {
-            QString json = q.value(0).toString();
-            if (!json.isEmpty()) {
-                QJsonParseError err;
-                QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8(), &err);
-                if (err.error == QJsonParseError::NoError && doc.isArray()) {
-                    QJsonArray arr = doc.array();
-                    for (const QJsonValue &v : arr) {
-                        if (!v.isObject()) continue;
-                        QJsonObject obj = v.toObject();
-                        totalPcs += obj["pcs"].toInt();
-                        totalWt += obj["wt"].toString().toDouble();
-                    }
-                }
-            }
-        }
-
-        return { totalPcs, totalWt };
-    };
-
-    // ✅ List of all columns with mapping to row & col
-    struct Entry { QString col; int row; int pcsCol; int wtCol; };
+    // ✅ Ledger (material, direction) for each pcs/wt cell pair
+    struct Entry { QString material; QString direction; int row; int pcsCol; int wtCol; };
     QList<Entry> entries = {
                             // Diamond
-                            { "diamond_issue",  0, 1, 2 },
-                            { "diamond_return", 0, 3, 4 },
-                            { "diamond_broken", 0, 5, 6 },
+                            { "diamond", "issue",  0, 1, 2 },
+                            { "diamond", "return", 0, 3, 4 },
+                            { "diamond", "broken", 0, 5, 6 },
 
                             // Stone
-                            { "stone_issue",  1, 1, 2 },
-                            { "stone_return", 1, 3, 4 },
-                            { "stone_broken", 1, 5, 6 },
+                            { "stone", "issue",  1, 1, 2 },
+                            { "stone", "return", 1, 3, 4 },
+                            { "stone", "broken", 1, 5, 6 },
 
                             // Other
-                            { "other_issue",  2, 1, 2 },
-                            { "other_return", 2, 3, 4 },
-                            { "other_broken", 2, 5, 6 },
+                            { "other", "issue",  2, 1, 2 },
+                            { "other", "return", 2, 3, 4 },
+                            { "other", "broken", 2, 5, 6 },
                             };
 
     // ✅ Loop and fill
     for (const auto &e : entries) {
-        auto [pcs, wt] = getTotals(e.col);
+        auto [pcs, wt] = totals.value({e.material, e.direction});
 
         QTableWidgetItem *pcsItem = ui->diamondAndStoneDetailTableWidget->item(e.row, e.pcsCol);
         if (!pcsItem) {
@@ -827,9 +749,6 @@ void JobSheet::updateDiamondTotals()
         wtItem->setText(QString::number(wt, 'f', 3));
     }
 
-    db.close();
-    QSqlDatabase::removeDatabase("diamond_total_conn");
-
 
     // ✅ --- Calculate net weights (col2 - col4 - col6) ---
     auto getNetWeight = [this](int row) -> double {
@@ -890,6 +809,7 @@ void JobSheet::setupDiamondIssueClicks()
                     newDiamonIssueRetBro = new DiamonIssueRetBro(this);
                     newDiamonIssueRetBro->setWindowFlags(Qt::FramelessWindowHint | Qt::Popup);
                     newDiamonIssueRetBro->setAttribute(Qt::WA_DeleteOnClose, false);
+                    newDiamonIssueRetBro->setUser(userRole);
 
                     // hide handling
                     connect(newDiamonIssueRetBro, &DiamonIssueRetBro::menuHidden, this, [this]() {
@@ -3,7 +3,13 @@
 #include <QPalette>
 #include <QStyleFactory>
 
+#include "connectionpool.h"
+#include "databasebootstrap.h"
+#include "databaseutils.h"
+#include "dbexecutor.h"
+#include "imagestore.h"
 #include "mainwindow.h"
+#include "thumbnailcache.h"
 
 int main(int argc, char *argv[])
 {
@@ -29,6 +35,18 @@ int main(int argc, char *argv[])
     lightPalette.setColor(QPalette::HighlightedText, Qt::white);
     a.setPalette(lightPalette);
 
+    // WAL, pragmas and schema migrations before any window touches the databases
+    DatabaseBootstrap::run();
+    // Query plans of the order list queries, on request only: mega_mine_clone --log-query-plans
+    if (a.arguments().contains("--log-query-plans"))
+        DbExecutor::instance().submit([]() { DatabaseUtils::logQueryPlans(); });
+    // Image files no catalog entry or order refers to any more, and thumbnails not used for a
+    // while; runs on a database worker
+    DbExecutor::instance().submit([]() {
+        ThumbnailCache::pruneDisk();
+        return ImageStore::collectGarbage();
+    });
+
     MainWindow w;
 
     // Get screen size
@@ -40,5 +58,11 @@ int main(int argc, char *argv[])
     w.resize(screenWidth * 0.8, screenHeight * 0.8);
 
     w.show();
-    return a.exec();
+    const int exitCode = a.exec();
+
+    // Pooled SQLite handles must be closed while QCoreApplication still exists;
+    // database workers release their own handles as they stop
+    DbExecutor::instance().shutdown();
+    ConnectionPool::instance().closeAll();
+    return exitCode;
 }
@@ -2,16 +2,13 @@
 #include "ui_managegold.h"
 
 #include <QDoubleValidator>
-#include <QSqlError>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
 #include <QMessageBox>
-#include <QDir>
 #include <QDateTime>
 #include <QLineEdit>
 #include <QHeaderView>
 
+#include "databaseutils.h"
+
 ManageGold::ManageGold(QWidget *parent)
     : QDialog(parent)
     , ui(new Ui::ManageGold)
@@ -104,13 +101,6 @@ void ManageGold::on_issueAddPushButton_clicked()
     }
 
     QString type = ui->typeComboBox->currentText().trimmed();
-    QString dateTime = QDateTime::currentDateTime().toString("dd-MM-yyyy HH:mm:ss");
-
-    // Build JSON object
-    QJsonObject newEntry;
-    newEntry["type"] = type;
-    newEntry["weight"] = weight;
-    newEntry["date_time"] = dateTime;
 
     QString jobNo;
     if (parentWidget()) {
@@ -124,58 +114,38 @@ void ManageGold::on_issueAddPushButton_clicked()
         return;
     }
 
-    QString columnName;
-    if (currentMode == Filling)
-        columnName = "Filling_Issue";
-    else if (currentMode == Returning)
-        columnName = "Filling_Return";
-    else
-        columnName = "filling_dust";   // ✅ new column
-
-
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "gold_mode");
-    QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-    db.setDatabaseName(dbPath);
-    if (!db.open()) {
-        QMessageBox::critical(this, "DB Error", db.lastError().text());
+    // One ledger row per entry; nothing already recorded is rewritten
+    JobSheetMovement movement;
+    movement.jobNo = jobNo;
+    movement.material = "gold";
+    movement.direction = directionForMode();
+    movement.type = type;
+    movement.weight = weight.toDouble();
+    movement.user = currentUser;
+
+    if (!DatabaseUtils::insertJobSheetMovement(movement)) {
+        QMessageBox::critical(this, "Update Error", "Failed to save the entry.");
         return;
     }
 
-    QJsonArray arr;
-
-    // Fetch existing JSON
-    QSqlQuery selectQuery(db);
-    selectQuery.prepare(QString("SELECT %1 FROM jobsheet_detail WHERE job_no = ?").arg(columnName));
-    selectQuery.addBindValue(jobNo);
-    if (selectQuery.exec() && selectQuery.next()) {
-        QString existingJson = selectQuery.value(0).toString();
-        if (!existingJson.isEmpty()) {
-            QJsonParseError err;
-            QJsonDocument doc = QJsonDocument::fromJson(existingJson.toUtf8(), &err);
-            if (err.error == QJsonParseError::NoError && doc.isArray())
-                arr = doc.array();
-        }
-    }
-
-    // Append new entry
-    arr.append(newEntry);
-    QString updatedJson = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
-
-    QSqlQuery updateQuery(db);
-    updateQuery.prepare(QString("UPDATE jobsheet_detail SET %1 = ? WHERE job_no = ?").arg(columnName));
-    updateQuery.addBindValue(updatedJson);
-    updateQuery.addBindValue(jobNo);
-    if (!updateQuery.exec()) {
-        QMessageBox::critical(this, "Update Error", updateQuery.lastError().text());
-    }
-
-    db.close();
-    QSqlDatabase::removeDatabase("gold_mode");
-
     QMessageBox::information(this, "Success", "Data saved successfully.");
     loadHistory();
 }
 
+void ManageGold::setUser(const QString &user)
+{
+    currentUser = user;
+}
+
+QString ManageGold::directionForMode() const
+{
+    if (currentMode == Filling)
+        return "issue";
+    if (currentMode == Returning)
+        return "return";
+    return "dust";
+}
+
 void ManageGold::loadHistory()
 {
     QString jobNo;
@@ -185,14 +155,6 @@ void ManageGold::loadHistory()
             jobNo = jobNoLineEdit->text().trimmed();
     }
 
-    QString columnName;
-    if (currentMode == Filling)
-        columnName = "Filling_Issue";
-    else if (currentMode == Returning)
-        columnName = "Filling_Return";
-    else
-        columnName = "filling_dust";
-
     double totalWeight = 0.0;
 
     ui->fillingIssueTableWidget->clear();
@@ -201,35 +163,20 @@ void ManageGold::loadHistory()
     ui->fillingIssueTableWidget->setHorizontalHeaderLabels({"Type", "Weight", "Date Time"});
 
     if (!jobNo.isEmpty()) {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "gold_read");
-        QString dbPath = QDir(QCoreApplication::applicationDirPath()).filePath("database/mega_mine_orderbook.db");
-        db.setDatabaseName(dbPath);
-
-        if (db.open()) {
-            QSqlQuery query(db);
-            query.prepare(QString("SELECT %1 FROM jobsheet_detail WHERE job_no = ?").arg(columnName));
-            query.addBindValue(jobNo);
-            if (query.exec() && query.next()) {
-                QString jsonStr = query.value(0).toString();
-                if (!jsonStr.isEmpty()) {
-                    QJsonParseError parseError;
-                    QJsonDocument doc = QJsonDocument::fromJson(jsonStr.toUtf8(), &parseError);
-                    if (parseError.error == QJsonParseError::NoError && doc.isArray()) {
-                        QJsonArray arr = doc.array();
-                        ui->fillingIssueTableWidget->setRowCount(arr.size());
-                        for (int i = 0; i < arr.size(); ++i) {
-                            QJsonObject obj = arr[i].toObject();
-                            ui->fillingIssueTableWidget->setItem(i, 0, new QTableWidgetItem(obj["type"].toString()));
-                            ui->fillingIssueTableWidget->setItem(i, 1, new QTableWidgetItem(obj["weight"].toString()));
-                            ui->fillingIssueTableWidget->setItem(i, 2, new QTableWidgetItem(obj["date_time"].toString()));
-                            totalWeight += obj["weight"].toString().toDouble();
-                        }
-                    }
-                }
-            }
+        const QList<JobSheetMovement> movements = DatabaseUtils::fetchJobSheetMovements(jobNo, "gold", directionForMode());
+        ui->fillingIssueTableWidget->setRowCount(movements.size());
+        for (int i = 0; i < movements.size(); ++i) {
+            const JobSheetMovement &movement = movements[i];
+
+            // Stored as yyyy-MM-dd for ordering, shown the way it was always entered
+            const QDateTime ts = QDateTime::fromString(movement.ts, "yyyy-MM-dd HH:mm:ss");
+            const QString dateTime = ts.isValid() ? ts.toString("dd-MM-yyyy HH:mm:ss") : movement.ts;
+
+            ui->fillingIssueTableWidget->setItem(i, 0, new QTableWidgetItem(movement.type));
+            ui->fillingIssueTableWidget->setItem(i, 1, new QTableWidgetItem(QString::number(movement.weight, 'f', 3)));
+            ui->fillingIssueTableWidget->setItem(i, 2, new QTableWidgetItem(dateTime));
+            totalWeight += movement.weight;
         }
-        db.close();
-        QSqlDatabase::removeDatabase("gold_read");
     }
 
     if (ui->fillingIssueTableWidget->rowCount() == 0) {
@@ -22,6 +22,7 @@ public:
     ~ManageGold();
 
     void setMode(Mode mode);
+    void setUser(const QString &user); // recorded on every ledger entry
     Mode currentMode;  // new
 
 protected:
@@ -39,9 +40,11 @@ private slots:
 private:
     void hideEvent(QHideEvent *event);
     void loadHistory();  // renamed generic version
+    QString directionForMode() const;
 
 private:
     Ui::ManageGold *ui;
+    QString currentUser;
 
 };
 
@@ -1,4 +1,4 @@
-QT       += core gui sql printsupport
+QT       += core gui sql printsupport concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -17,10 +17,20 @@ SOURCES += \
     admin.cpp \
     adminmenubuttons.cpp \
     cartitemwidget.cpp \
+    cartsummary.cpp \
+    catalogimport.cpp \
+    catalogmodel.cpp \
+    catalogsearch.cpp \
     commontypes.cpp \
+    connectionpool.cpp \
+    databasebootstrap.cpp \
     databaseutils.cpp \
+    dbexecutor.cpp \
     diamonissueretbro.cpp \
     imageclicklabel.cpp \
+    imageingest.cpp \
+    imageprefetcher.cpp \
+    imagestore.cpp \
     jewelrymenu.cpp \
     jobsheet.cpp \
     loginwindow.cpp \
@@ -28,11 +38,15 @@ SOURCES += \
     mainwindow.cpp \
     managegold.cpp \
     orderlist.cpp \
+    orderlistmodel.cpp \
     ordermenu.cpp \
     pch.cpp \
     pdflistdialog.cpp \
-    pdfutils.cpp \
+    pdfrenderer.cpp \
     readonlydelegate.cpp \
+    referencedatacache.cpp \
+    schemamigrations.cpp \
+    thumbnailcache.cpp \
     user.cpp \
     utils.cpp
 
@@ -41,21 +55,36 @@ HEADERS += \
     admin.h \
     adminmenubuttons.h \
     cartitemwidget.h \
+    cartsummary.h \
+    catalogimport.h \
+    catalogmodel.h \
+    catalogsearch.h \
     commontypes.h \
+    connectionpool.h \
+    databasebootstrap.h \
     databaseutils.h \
+    dbexecutor.h \
     diamonissueretbro.h \
     imageclicklabel.h \
+    imageingest.h \
+    imageprefetcher.h \
+    imagestore.h \
     jewelrymenu.h \
     jobsheet.h \
     loginwindow.h \
     mainwindow.h \
     managegold.h \
     orderlist.h \
+    orderlistmodel.h \
     ordermenu.h \
     pch.h \
     pdflistdialog.h \
-    pdfutils.h \
+    pdfrenderer.h \
     readonlydelegate.h \
+    referencedatacache.h \
+    rowmapper.h \
+    schemamigrations.h \
+    thumbnailcache.h \
     user.h \
     utils.h
 
@@ -0,0 +1,2 @@
+-- Party list for the logged-in seller
+CREATE INDEX IF NOT EXISTS idx_partys_user_id ON Partys(userId);
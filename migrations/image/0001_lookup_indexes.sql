@@ -0,0 +1,7 @@
+-- Catalog lookups by design number (cart, job sheet, bulk import)
+CREATE INDEX IF NOT EXISTS idx_image_data_design_no ON image_data(design_no);
+
+-- Weight/price lookups resolved per diamond and stone entry
+CREATE INDEX IF NOT EXISTS idx_round_diamond_size ON Round_diamond(sizeMM);
+CREATE INDEX IF NOT EXISTS idx_fancy_diamond_shape_size ON Fancy_diamond(shape, sizeMM);
+CREATE INDEX IF NOT EXISTS idx_stones_shape_size ON stones(shape, sizeMM);
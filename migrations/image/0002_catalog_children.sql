@@ -0,0 +1,143 @@
+-- Normalized copies of the image_data JSON columns, one row per array entry.
+-- seq is the entry's position in the original array so the JSON can be re-emitted in order.
+CREATE TABLE IF NOT EXISTS catalog_gold (
+    image_id INTEGER NOT NULL,
+    seq      INTEGER NOT NULL,
+    karat    TEXT    NOT NULL DEFAULT '',
+    weight   REAL    NOT NULL DEFAULT 0,
+    PRIMARY KEY (image_id, seq)
+);
+CREATE INDEX IF NOT EXISTS idx_catalog_gold_karat ON catalog_gold(karat, image_id);
+
+CREATE TABLE IF NOT EXISTS catalog_diamond (
+    image_id INTEGER NOT NULL,
+    seq      INTEGER NOT NULL,
+    type     TEXT    NOT NULL DEFAULT '',
+    size_mm  TEXT    NOT NULL DEFAULT '',
+    quantity INTEGER NOT NULL DEFAULT 0,
+    PRIMARY KEY (image_id, seq)
+);
+CREATE INDEX IF NOT EXISTS idx_catalog_diamond_type_size ON catalog_diamond(type, size_mm);
+
+CREATE TABLE IF NOT EXISTS catalog_stone (
+    image_id INTEGER NOT NULL,
+    seq      INTEGER NOT NULL,
+    type     TEXT    NOT NULL DEFAULT '',
+    size_mm  TEXT    NOT NULL DEFAULT '',
+    quantity INTEGER NOT NULL DEFAULT 0,
+    PRIMARY KEY (image_id, seq)
+);
+CREATE INDEX IF NOT EXISTS idx_catalog_stone_type_size ON catalog_stone(type, size_mm);
+
+-- Backfill from the existing JSON; malformed or non-array values contribute no rows
+INSERT OR REPLACE INTO catalog_gold (image_id, seq, karat, weight)
+SELECT d.image_id, CAST(j.key AS INTEGER),
+       COALESCE(json_extract(j.value, '$.karat'), ''),
+       COALESCE(CAST(json_extract(j.value, '$."weight(g)"') AS REAL), 0)
+FROM image_data d,
+     json_each(CASE WHEN json_valid(d.gold_weight) THEN CASE WHEN json_type(d.gold_weight) = 'array' THEN d.gold_weight END END) j
+WHERE j.type = 'object';
+
+INSERT OR REPLACE INTO catalog_diamond (image_id, seq, type, size_mm, quantity)
+SELECT d.image_id, CAST(j.key AS INTEGER),
+       COALESCE(json_extract(j.value, '$.type'), ''),
+       COALESCE(json_extract(j.value, '$.sizeMM'), ''),
+       COALESCE(CAST(json_extract(j.value, '$.quantity') AS INTEGER), 0)
+FROM image_data d,
+     json_each(CASE WHEN json_valid(d.diamond) THEN CASE WHEN json_type(d.diamond) = 'array' THEN d.diamond END END) j
+WHERE j.type = 'object';
+
+INSERT OR REPLACE INTO catalog_stone (image_id, seq, type, size_mm, quantity)
+SELECT d.image_id, CAST(j.key AS INTEGER),
+       COALESCE(json_extract(j.value, '$.type'), ''),
+       COALESCE(json_extract(j.value, '$.sizeMM'), ''),
+       COALESCE(CAST(json_extract(j.value, '$.quantity') AS INTEGER), 0)
+FROM image_data d,
+     json_each(CASE WHEN json_valid(d.stone) THEN CASE WHEN json_type(d.stone) = 'array' THEN d.stone END END) j
+WHERE j.type = 'object';
+
+-- Keep the child tables in step with every writer of the JSON columns
+CREATE TRIGGER IF NOT EXISTS trg_image_data_children_delete
+AFTER DELETE ON image_data
+BEGIN
+    DELETE FROM catalog_gold WHERE image_id = OLD.image_id;
+    DELETE FROM catalog_diamond WHERE image_id = OLD.image_id;
+    DELETE FROM catalog_stone WHERE image_id = OLD.image_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_gold_sync
+AFTER UPDATE OF gold_weight ON image_data
+BEGIN
+    DELETE FROM catalog_gold WHERE image_id = OLD.image_id;
+    INSERT OR REPLACE INTO catalog_gold (image_id, seq, karat, weight)
+    SELECT NEW.image_id, CAST(j.key AS INTEGER),
+           COALESCE(json_extract(j.value, '$.karat'), ''),
+           COALESCE(CAST(json_extract(j.value, '$."weight(g)"') AS REAL), 0)
+    FROM json_each(CASE WHEN json_valid(NEW.gold_weight) THEN CASE WHEN json_type(NEW.gold_weight) = 'array' THEN NEW.gold_weight END END) j
+    WHERE j.type = 'object';
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_diamond_sync
+AFTER UPDATE OF diamond ON image_data
+BEGIN
+    DELETE FROM catalog_diamond WHERE image_id = OLD.image_id;
+    INSERT OR REPLACE INTO catalog_diamond (image_id, seq, type, size_mm, quantity)
+    SELECT NEW.image_id, CAST(j.key AS INTEGER),
+           COALESCE(json_extract(j.value, '$.type'), ''),
+           COALESCE(json_extract(j.value, '$.sizeMM'), ''),
+           COALESCE(CAST(json_extract(j.value, '$.quantity') AS INTEGER), 0)
+    FROM json_each(CASE WHEN json_valid(NEW.diamond) THEN CASE WHEN json_type(NEW.diamond) = 'array' THEN NEW.diamond END END) j
+    WHERE j.type = 'object';
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_stone_sync
+AFTER UPDATE OF stone ON image_data
+BEGIN
+    DELETE FROM catalog_stone WHERE image_id = OLD.image_id;
+    INSERT OR REPLACE INTO catalog_stone (image_id, seq, type, size_mm, quantity)
+    SELECT NEW.image_id, CAST(j.key AS INTEGER),
+           COALESCE(json_extract(j.value, '$.type'), ''),
+           COALESCE(json_extract(j.value, '$.sizeMM'), ''),
+           COALESCE(CAST(json_extract(j.value, '$.quantity') AS INTEGER), 0)
+    FROM json_each(CASE WHEN json_valid(NEW.stone) THEN CASE WHEN json_type(NEW.stone) = 'array' THEN NEW.stone END END) j
+    WHERE j.type = 'object';
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_children_insert
+AFTER INSERT ON image_data
+BEGIN
+    INSERT OR REPLACE INTO catalog_gold (image_id, seq, karat, weight)
+    SELECT NEW.image_id, CAST(j.key AS INTEGER),
+           COALESCE(json_extract(j.value, '$.karat'), ''),
+           COALESCE(CAST(json_extract(j.value, '$."weight(g)"') AS REAL), 0)
+    FROM json_each(CASE WHEN json_valid(NEW.gold_weight) THEN CASE WHEN json_type(NEW.gold_weight) = 'array' THEN NEW.gold_weight END END) j
+    WHERE j.type = 'object';
+
+    INSERT OR REPLACE INTO catalog_diamond (image_id, seq, type, size_mm, quantity)
+    SELECT NEW.image_id, CAST(j.key AS INTEGER),
+           COALESCE(json_extract(j.value, '$.type'), ''),
+           COALESCE(json_extract(j.value, '$.sizeMM'), ''),
+           COALESCE(CAST(json_extract(j.value, '$.quantity') AS INTEGER), 0)
+    FROM json_each(CASE WHEN json_valid(NEW.diamond) THEN CASE WHEN json_type(NEW.diamond) = 'array' THEN NEW.diamond END END) j
+    WHERE j.type = 'object';
+
+    INSERT OR REPLACE INTO catalog_stone (image_id, seq, type, size_mm, quantity)
+    SELECT NEW.image_id, CAST(j.key AS INTEGER),
+           COALESCE(json_extract(j.value, '$.type'), ''),
+           COALESCE(json_extract(j.value, '$.sizeMM'), ''),
+           COALESCE(CAST(json_extract(j.value, '$.quantity') AS INTEGER), 0)
+    FROM json_each(CASE WHEN json_valid(NEW.stone) THEN CASE WHEN json_type(NEW.stone) = 'array' THEN NEW.stone END END) j
+    WHERE j.type = 'object';
+END;
+
+-- JSON re-emitted from the child tables, in the shape the catalog code has always written
+CREATE VIEW IF NOT EXISTS catalog_json AS
+SELECT d.image_id,
+       d.design_no,
+       (SELECT json_group_array(json_object('karat', g.karat, 'weight(g)', printf('%.3f', g.weight)))
+          FROM (SELECT karat, weight FROM catalog_gold WHERE image_id = d.image_id ORDER BY seq) g) AS gold_weight,
+       (SELECT json_group_array(json_object('type', c.type, 'sizeMM', c.size_mm, 'quantity', CAST(c.quantity AS TEXT)))
+          FROM (SELECT type, size_mm, quantity FROM catalog_diamond WHERE image_id = d.image_id ORDER BY seq) c) AS diamond,
+       (SELECT json_group_array(json_object('type', s.type, 'sizeMM', s.size_mm, 'quantity', CAST(s.quantity AS TEXT)))
+          FROM (SELECT type, size_mm, quantity FROM catalog_stone WHERE image_id = d.image_id ORDER BY seq) s) AS stone
+FROM image_data d;
@@ -0,0 +1,39 @@
+-- Full-text index over the searchable catalog text. External content: the text stays in
+-- image_data and the index stores only tokens, keyed by image_id.
+CREATE VIRTUAL TABLE IF NOT EXISTS catalog_fts USING fts5(
+    design_no, company_name, image_type, note,
+    content='image_data', content_rowid='image_id',
+    tokenize='unicode61 remove_diacritics 2',
+    prefix='1 2 3'
+);
+
+INSERT INTO catalog_fts(catalog_fts) VALUES('rebuild');
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_fts_insert
+AFTER INSERT ON image_data
+BEGIN
+    INSERT INTO catalog_fts(rowid, design_no, company_name, image_type, note)
+    VALUES (NEW.image_id, NEW.design_no, NEW.company_name, NEW.image_type, NEW.note);
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_fts_delete
+AFTER DELETE ON image_data
+BEGIN
+    INSERT INTO catalog_fts(catalog_fts, rowid, design_no, company_name, image_type, note)
+    VALUES ('delete', OLD.image_id, OLD.design_no, OLD.company_name, OLD.image_type, OLD.note);
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_fts_update
+AFTER UPDATE OF design_no, company_name, image_type, note ON image_data
+BEGIN
+    INSERT INTO catalog_fts(catalog_fts, rowid, design_no, company_name, image_type, note)
+    VALUES ('delete', OLD.image_id, OLD.design_no, OLD.company_name, OLD.image_type, OLD.note);
+    INSERT INTO catalog_fts(rowid, design_no, company_name, image_type, note)
+    VALUES (NEW.image_id, NEW.design_no, NEW.company_name, NEW.image_type, NEW.note);
+END;
+
+-- Facet filters resolve to image_id sets straight from these indexes
+DROP INDEX IF EXISTS idx_catalog_diamond_type_size;
+DROP INDEX IF EXISTS idx_catalog_stone_type_size;
+CREATE INDEX IF NOT EXISTS idx_catalog_diamond_facet ON catalog_diamond(type, size_mm, image_id);
+CREATE INDEX IF NOT EXISTS idx_catalog_stone_facet ON catalog_stone(type, size_mm, image_id);
@@ -0,0 +1,35 @@
+-- Content-addressed image store.
+-- Every imported image file is kept once under images/store/, named by the SHA-256 of its
+-- bytes. refcount counts the image_data rows (live or soft-deleted) that point at the blob
+-- and is maintained by the triggers below. Order images live in the order book database, so
+-- the garbage-collection pass checks those references itself before removing a blob.
+CREATE TABLE IF NOT EXISTS image_blobs (
+    hash TEXT PRIMARY KEY,
+    path TEXT NOT NULL UNIQUE,
+    bytes INTEGER NOT NULL,
+    refcount INTEGER NOT NULL DEFAULT 0,
+    last_ingest_at TEXT NOT NULL
+);
+
+-- Candidates for garbage collection
+CREATE INDEX IF NOT EXISTS idx_image_blobs_unreferenced ON image_blobs(last_ingest_at) WHERE refcount <= 0;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_blob_insert
+AFTER INSERT ON image_data
+BEGIN
+    UPDATE image_blobs SET refcount = refcount + 1 WHERE path = NEW.image_path;
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_blob_delete
+AFTER DELETE ON image_data
+BEGIN
+    UPDATE image_blobs SET refcount = refcount - 1 WHERE path = OLD.image_path;
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_image_data_blob_update
+AFTER UPDATE OF image_path ON image_data
+WHEN OLD.image_path IS NOT NEW.image_path
+BEGIN
+    UPDATE image_blobs SET refcount = refcount - 1 WHERE path = OLD.image_path;
+    UPDATE image_blobs SET refcount = refcount + 1 WHERE path = NEW.image_path;
+END;
@@ -0,0 +1,7 @@
+-- Pixel size of each stored image, and for images normalized on ingest, the blob holding
+-- the untouched original (only when keeping originals is enabled)
+ALTER TABLE image_blobs ADD COLUMN width INTEGER;
+ALTER TABLE image_blobs ADD COLUMN height INTEGER;
+ALTER TABLE image_blobs ADD COLUMN original_hash TEXT;
+
+CREATE INDEX IF NOT EXISTS idx_image_blobs_original ON image_blobs(original_hash) WHERE original_hash IS NOT NULL;
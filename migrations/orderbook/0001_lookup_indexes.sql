@@ -0,0 +1,10 @@
+-- OrderList and JobSheet joins on job number
+CREATE INDEX IF NOT EXISTS idx_orderbook_detail_job_no ON "OrderBook-Detail"(jobNo);
+CREATE INDEX IF NOT EXISTS idx_orderbook_detail_order_no ON "OrderBook-Detail"(orderNo);
+CREATE INDEX IF NOT EXISTS idx_orderbook_detail_seller_id ON "OrderBook-Detail"(sellerId);
+CREATE INDEX IF NOT EXISTS idx_order_status_job_no ON "Order-Status"(jobNo);
+CREATE INDEX IF NOT EXISTS idx_jobsheet_detail_job_no ON jobsheet_detail(job_no);
+
+-- Latest pending request per job (fetchJobSheetRequests)
+CREATE INDEX IF NOT EXISTS idx_status_change_requests_job_status_time
+    ON StatusChangeRequests(jobNo, status, requestTime);
@@ -0,0 +1,17 @@
+-- Append-only ledger of job-sheet material movements, one row per issue/return/broken/dust entry.
+-- Replaces the JSON arrays in the jobsheet_detail filling_* / diamond_* / stone_* / other_* columns;
+-- their existing entries are imported by the C++ data step registered for this version.
+CREATE TABLE IF NOT EXISTS jobsheet_movements (
+    id        INTEGER PRIMARY KEY AUTOINCREMENT,
+    job_no    TEXT    NOT NULL,
+    material  TEXT    NOT NULL,
+    direction TEXT    NOT NULL,
+    type      TEXT    NOT NULL DEFAULT '',
+    size      TEXT    NOT NULL DEFAULT '',
+    pcs       INTEGER NOT NULL DEFAULT 0,
+    weight    REAL    NOT NULL DEFAULT 0,
+    ts        TEXT    NOT NULL DEFAULT '',
+    user      TEXT    NOT NULL DEFAULT ''
+);
+
+CREATE INDEX IF NOT EXISTS idx_jobsheet_movements_job ON jobsheet_movements(job_no, material, direction);
@@ -3,8 +3,16 @@
 
 #include <QDialog>
 
+#include "commontypes.h"
+#include "dbexecutor.h"
 #include "loginwindow.h"
 
+class OrderListModel;
+class OrderStatusDelegate;
+class PdfRenderer;
+class QProgressDialog;
+class QSortFilterProxyModel;
+
 namespace Ui {
 class OrderList;
 }
@@ -29,24 +37,32 @@ private slots:
 
     void printJobSheet(const QString &jobNo);
 
+    void exportJobSheets();
+
+    void onButtonClicked(const QModelIndex &index);
+
+    void onStatusChangeRequested(const QString &jobNo, const QString &oldStatus, const QString &newStatus);
+
 private:
     void show_order_list_with_role(const QString &role, int editableStatusCol);
-    void populateCommonOrderRow(int row, const QVariantList &order);
+    void populateOrderList(const QString &role, int editableStatusCol, const QList<OrderListRow> &orderList);
+    void showOrderImage(const QString &jobNo, const QString &storedPath);
     void hideIrrelevantColumns(const QString &role);
-    QStringList getStatusOptions(const QString &role);
-    bool shouldShowRow(const QString &role, const QVariantList &order);
-    void setupStatusCombo(int row, int col, const QString &role, const QString &currentStatus,
-                          const QString &jobNo, const QVariantList &order, const int &editableStatusCol);
+    JobSheetPdfData jobSheetData(const OrderListRow &order, const QString &pdfDir) const;
 
     Ui::OrderList *ui;
     LoginWindow *loginWindow = nullptr;
+    DbRequest orderListRequest;
+    PdfRenderer *pdfRenderer = nullptr;
+    PdfRenderer *batchRenderer = nullptr;
+    QProgressDialog *batchProgress = nullptr;
+    OrderListModel *orderModel = nullptr;
+    QSortFilterProxyModel *orderProxy = nullptr;
+    OrderStatusDelegate *statusDelegate = nullptr;
 
 
     QString userId;
     QString userName;
-
-    void drawRow(QPainter &painter, int x, int y, const QVector<int> &widths, int height);
-    void drawTextRow(QPainter &painter, int x, int y, const QVector<QString> &texts, const QVector<int> &widths = {});
 };
 
 #endif // ORDERLIST_H
@@ -0,0 +1,368 @@
+#include <QApplication>
+#include <QComboBox>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QStyle>
+#include <QStyleOption>
+#include <QTimer>
+
+#include "orderlistmodel.h"
+
+OrderListModel::OrderListModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int OrderListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(rows.size());
+}
+
+int OrderListModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant OrderListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size())
+        return QVariant();
+
+    const OrderListRow &order = rows[index.row()];
+    const int column = index.column();
+
+    if (role == Qt::DisplayRole || role == Qt::EditRole) {
+        switch (column) {
+        case SrNoColumn:               return index.row() + 1;
+        case UserIdColumn:             return order.sellerId;
+        case PartyIdColumn:            return order.partyId;
+        case JobNoColumn:              return order.jobNo;
+        case ManagerStatusColumn:
+        case DesignerStatusColumn:
+        case ManufacturerStatusColumn:
+        case AccountantStatusColumn:   return status(order, column);
+        case OrderDateColumn:          return order.orderDate;
+        case DeliveryDateColumn:       return order.deliveryDate;
+        case JobSheetColumn:           return "Job Sheet";
+        case PrintColumn:              return "Print";
+        case ImageColumn:              return "Show Img";
+        case OrderApprovalColumn:      return order.orderApprove;
+        case DesignApprovalColumn:     return order.designApprove;
+        case QualityApprovalColumn:    return order.qualityApprove;
+        case OrderNoteColumn:          return order.orderNote;
+        case DesignNoteColumn:         return order.designNote;
+        case QualityNoteColumn:        return order.qualityNote;
+        default:                       return QVariant();
+        }
+    }
+
+    if (column != editableStatusColumn)
+        return QVariant();
+
+    if (role == Qt::ToolTipRole && !canEdit(order))
+        return lockedReason();
+    if (role == AllowedStatesRole)
+        return allowedStates(order);
+
+    return QVariant();
+}
+
+QVariant OrderListModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    static const QStringList headers = {
+        "Sr No", "User ID", "Party ID", "Job No",
+        "Manager Status", "Designer Status", "Manufacturer Status", "Accountant Status",
+        "Order Date", "Delivery Date",
+        "Job Sheet", "Print", "Image",
+        "Order Approval", "Design Approval", "Quality Approval",
+        "Order Note", "Design Note", "Quality Note"
+    };
+    return headers.value(section);
+}
+
+Qt::ItemFlags OrderListModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+
+    Qt::ItemFlags itemFlags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    if (index.column() == editableStatusColumn && canEdit(rows[index.row()]))
+        itemFlags |= Qt::ItemIsEditable;
+    return itemFlags;
+}
+
+bool OrderListModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole || index.column() != editableStatusColumn)
+        return false;
+
+    const OrderListRow &order = rows[index.row()];
+    const QString oldStatus = status(order, index.column());
+    const QString newStatus = value.toString();
+    if (newStatus != oldStatus)
+        emit statusChangeRequested(order.jobNo, oldStatus, newStatus);
+    return false;
+}
+
+void OrderListModel::setOrders(const QString &role, int editableColumn, const QList<OrderListRow> &orders)
+{
+    beginResetModel();
+    userRole = role;
+    editableStatusColumn = (editableColumn >= ManagerStatusColumn && editableColumn <= AccountantStatusColumn)
+                               ? editableColumn : -1;
+
+    rows.clear();
+    rowByJobNo.clear();
+    for (const OrderListRow &order : orders) {
+        if (!shouldShowRow(role, order))
+            continue;
+        rowByJobNo.insert(order.jobNo, int(rows.size()));
+        rows.append(order);
+    }
+    endResetModel();
+}
+
+void OrderListModel::setStatus(const QString &jobNo, const QString &newStatus)
+{
+    const int row = rowOfJob(jobNo);
+    if (row < 0 || editableStatusColumn < 0)
+        return;
+
+    if (QString *field = statusField(rows[row], editableStatusColumn)) {
+        *field = newStatus;
+        // The manager's stage decides what the other columns of the row allow
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+    }
+}
+
+bool OrderListModel::shouldShowRow(const QString &role, const OrderListRow &order)
+{
+    const QString &managerStatus = order.manager;
+
+    if (role == "designer" && managerStatus == "Order Checked")
+        return true;
+
+    if (role == "manufacturer" && managerStatus == "Bagging")
+        return true;
+
+    if (role == "accountant" && managerStatus == "QC Done")
+        return true;
+
+    if (role == "manager")
+        return true;
+
+    if (role == "seller")
+        return true;
+
+    return false;
+}
+
+QStringList OrderListModel::statusOptions(const QString &role)
+{
+    if (role == "manager") {
+        return { "Pending", "Order Checked", "Design Checked", "RPD", "Casting", "Bagging", "QC Done" };
+    } else {
+        return { "Pending", "Working", "Completed" };
+    }
+}
+
+QString OrderListModel::statusColor(const QString &status)
+{
+    if      (status == "Pending")        return "#ffcccc";   // Light red
+    else if (status == "Working")        return "#fff5ba";   // Light yellow
+    else if (status == "Completed")      return "#ccffcc";   // Light green
+    else if (status == "Order Checked")  return "#ffd8a8";   // Light orange
+    else if (status == "Design Checked") return "#fff5ba";   // Light yellow
+    else if (status == "RPD")            return "#cce5ff";   // Light blue
+    else if (status == "Casting")        return "#d1c4e9";   // Light purple
+    else if (status == "Bagging")        return "#e6ee9c";   // Light lime
+    else if (status == "QC Done")        return "#ccffcc";   // Light green
+    return QString();
+}
+
+QString *OrderListModel::statusField(OrderListRow &order, int column)
+{
+    switch (column) {
+    case ManagerStatusColumn:      return &order.manager;
+    case DesignerStatusColumn:     return &order.designer;
+    case ManufacturerStatusColumn: return &order.manufacturer;
+    case AccountantStatusColumn:   return &order.accountant;
+    default:                       return nullptr;
+    }
+}
+
+QString OrderListModel::status(const OrderListRow &order, int column)
+{
+    const QString *field = statusField(const_cast<OrderListRow &>(order), column);
+    return field ? *field : QString();
+}
+
+bool OrderListModel::canEdit(const OrderListRow &order) const
+{
+    const QString &managerStatus = order.manager;
+    return (userRole == "manager") ||
+           (userRole == "designer" && managerStatus == "Order Checked") ||
+           (userRole == "manufacturer" && managerStatus == "Bagging") ||
+           (userRole == "accountant" && managerStatus == "QC Done");
+}
+
+QString OrderListModel::lockedReason() const
+{
+    if (userRole == "designer")          return "Manager has not yet Order Checked this design.";
+    else if (userRole == "manufacturer") return "Designer must complete their work first.";
+    else if (userRole == "accountant")   return "Manufacturer must complete the job first.";
+    else if (userRole == "manager")      return "This is not manager’s current stage.";
+    return QString();
+}
+
+QStringList OrderListModel::allowedStates(const OrderListRow &order) const
+{
+    const QString currentStatus = status(order, editableStatusColumn);
+    const QStringList possibleStates = statusOptions(userRole);
+    QStringList states;
+
+    if (userRole != "manager") {
+        states = possibleStates;  // Other roles → full states
+    } else {
+        // ✅ Always show all previous states
+        const int currentIndex = possibleStates.indexOf(currentStatus);
+        for (int i = 0; i <= currentIndex && i < possibleStates.size(); ++i)
+            states << possibleStates[i];
+
+        // ✅ Add valid forward states
+        if (currentStatus == "Pending") {
+            states << "Order Checked";
+        } else if (currentStatus == "Order Checked" && order.designer == "Completed") {
+            states << "Design Checked";
+        } else if (currentStatus == "Design Checked") {
+            states << "RPD";
+        } else if (currentStatus == "RPD") {
+            states << "Casting";
+        } else if (currentStatus == "Casting") {
+            states << "Bagging";
+        } else if (currentStatus == "Bagging" && order.manufacturer == "Completed") {
+            states << "QC Done";
+        }
+    }
+
+    states.removeDuplicates();
+    return states;
+}
+
+
+// OrderButtonDelegate
+void OrderButtonDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &option, painter, option.widget);
+
+    QStyleOptionButton button;
+    button.rect = option.rect.adjusted(2, 2, -2, -2);
+    button.text = index.data().toString();
+    button.state = QStyle::State_Enabled | QStyle::State_Raised;
+    if (pressed == index)
+        button.state |= QStyle::State_Sunken;
+    button.palette = option.palette;
+    button.fontMetrics = option.fontMetrics;
+    style->drawControl(QStyle::CE_PushButton, &button, painter, option.widget);
+}
+
+QSize OrderButtonDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+    QStyleOptionButton button;
+    button.text = index.data().toString();
+    button.fontMetrics = option.fontMetrics;
+    const QSize text = option.fontMetrics.size(Qt::TextShowMnemonic, button.text);
+    return style->sizeFromContents(QStyle::CT_PushButton, &button, text, option.widget) + QSize(4, 4);
+}
+
+bool OrderButtonDelegate::editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+                                      const QModelIndex &index)
+{
+    Q_UNUSED(model)
+
+    if (event->type() != QEvent::MouseButtonPress && event->type() != QEvent::MouseButtonRelease)
+        return false;
+
+    auto *mouse = static_cast<QMouseEvent *>(event);
+    if (mouse->button() != Qt::LeftButton)
+        return false;
+
+    QWidget *viewport = const_cast<QWidget *>(option.widget);
+    if (event->type() == QEvent::MouseButtonPress) {
+        pressed = index;
+        if (viewport)
+            viewport->update(option.rect);
+        return true;
+    }
+
+    const bool clickedHere = pressed == index && option.rect.contains(mouse->pos());
+    pressed = QPersistentModelIndex();
+    if (viewport)
+        viewport->update(option.rect);
+    if (clickedHere)
+        emit clicked(index);
+    return true;
+}
+
+
+// OrderStatusDelegate
+void OrderStatusDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &option, painter, option.widget);
+
+    QStyleOptionComboBox combo;
+    combo.rect = option.rect.adjusted(1, 1, -1, -1);
+    combo.currentText = index.data().toString();
+    combo.palette = option.palette;
+    combo.fontMetrics = option.fontMetrics;
+    combo.frame = true;
+    combo.editable = false;
+    if (index.flags() & Qt::ItemIsEditable)
+        combo.state |= QStyle::State_Enabled;
+
+    const QString color = OrderListModel::statusColor(combo.currentText);
+    if (!color.isEmpty())
+        combo.palette.setColor(QPalette::Button, QColor(color));
+
+    style->drawComplexControl(QStyle::CC_ComboBox, &combo, painter, option.widget);
+    style->drawControl(QStyle::CE_ComboBoxLabel, &combo, painter, option.widget);
+}
+
+QWidget *OrderStatusDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(option)
+
+    auto *combo = new QComboBox(parent);
+    combo->addItems(index.data(OrderListModel::AllowedStatesRole).toStringList());
+
+    const QString color = OrderListModel::statusColor(index.data().toString());
+    if (!color.isEmpty())
+        combo->setStyleSheet("QComboBox { background-color: " + color + "; }");
+
+    // A pick commits straight away, as the per-row combo boxes used to
+    auto *self = const_cast<OrderStatusDelegate *>(this);
+    connect(combo, QOverload<int>::of(&QComboBox::activated), self, [self, combo]() {
+        emit self->commitData(combo);
+        emit self->closeEditor(combo);
+    });
+    QTimer::singleShot(0, combo, &QComboBox::showPopup);
+    return combo;
+}
+
+void OrderStatusDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    if (auto *combo = qobject_cast<QComboBox *>(editor))
+        combo->setCurrentText(index.data(Qt::EditRole).toString());
+}
+
+void OrderStatusDelegate::setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const
+{
+    if (auto *combo = qobject_cast<QComboBox *>(editor))
+        model->setData(index, combo->currentText(), Qt::EditRole);
+}
@@ -0,0 +1,125 @@
+#ifndef ORDERLISTMODEL_H
+#define ORDERLISTMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QStyledItemDelegate>
+
+#include "commontypes.h"
+
+// Orders shown in the OrderList dialog, one row per job.
+// Only the orders the current role may see are kept; the others are dropped when the list
+// is set instead of becoming hidden rows. Nothing per cell is a widget: button columns and
+// the role's status column are painted by OrderButtonDelegate / OrderStatusDelegate, and a
+// status combo box exists only while a cell is being edited, so the list costs the same
+// per row whether it holds a hundred orders or a hundred thousand.
+class OrderListModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        SrNoColumn,
+        UserIdColumn,
+        PartyIdColumn,
+        JobNoColumn,
+        ManagerStatusColumn,
+        DesignerStatusColumn,
+        ManufacturerStatusColumn,
+        AccountantStatusColumn,
+        OrderDateColumn,
+        DeliveryDateColumn,
+        JobSheetColumn,
+        PrintColumn,
+        ImageColumn,
+        OrderApprovalColumn,
+        DesignApprovalColumn,
+        QualityApprovalColumn,
+        OrderNoteColumn,
+        DesignNoteColumn,
+        QualityNoteColumn,
+        ColumnCount
+    };
+
+    enum Roles {
+        AllowedStatesRole = Qt::UserRole,   // QStringList the status editor offers
+    };
+
+    explicit OrderListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    // A status picked in the editor is not stored here; it is handed to
+    // statusChangeRequested() so the dialog can run approvals first
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+    // Replaces the rows with the orders role may see; editableColumn is the status column
+    // that role edits (other values leave every status read-only)
+    void setOrders(const QString &role, int editableColumn, const QList<OrderListRow> &orders);
+    void setStatus(const QString &jobNo, const QString &status);
+
+    const OrderListRow &order(int row) const { return rows[row]; }
+    int rowOfJob(const QString &jobNo) const { return rowByJobNo.value(jobNo, -1); }
+    const QString &role() const { return userRole; }
+    int editableColumn() const { return editableStatusColumn; }
+
+    static bool shouldShowRow(const QString &role, const OrderListRow &order);
+    static QStringList statusOptions(const QString &role);
+    static QString statusColor(const QString &status);
+
+signals:
+    void statusChangeRequested(const QString &jobNo, const QString &oldStatus, const QString &newStatus);
+
+private:
+    static QString *statusField(OrderListRow &order, int column);
+    static QString status(const OrderListRow &order, int column);
+    bool canEdit(const OrderListRow &order) const;
+    QString lockedReason() const;
+    QStringList allowedStates(const OrderListRow &order) const;
+
+    QList<OrderListRow> rows;
+    QHash<QString, int> rowByJobNo;
+    QString userRole;
+    int editableStatusColumn = -1;
+};
+
+// Paints a push button in the cell and emits clicked() when it is released over it
+class OrderButtonDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+                     const QModelIndex &index) override;
+
+signals:
+    void clicked(const QModelIndex &index);
+
+private:
+    QPersistentModelIndex pressed;
+};
+
+// Paints the role's status cell as a coloured combo box; the real QComboBox is created only
+// when the cell is edited and offers the index's AllowedStatesRole
+class OrderStatusDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const override;
+};
+
+#endif // ORDERLISTMODEL_H
@@ -15,6 +15,9 @@
 #include <QDir>
 #include <QPixmap>
 
+#include "imageingest.h"
+#include "imagestore.h"
+
 
 OrderMenu::OrderMenu(QWidget *parent)
     : QDialog(parent)
@@ -167,19 +170,11 @@ void OrderMenu::setupPolishOptions() {
 
 void OrderMenu::setupImageUploadHandlers() {
     connect(ui->imageLabel1, &ImageClickLabel::rightClicked, this, [=]() {
-        QString path = selectAndSaveImage("image1");
-        if (!path.isEmpty()) {
-            ui->imageLabel1->setPixmap(QPixmap(path).scaled(ui->imageLabel1->size(), Qt::KeepAspectRatio));
-            imagePath1 = path;
-        }
+        selectAndSaveImage(ui->imageLabel1, &imagePath1);
     });
 
     connect(ui->imageLabel2, &ImageClickLabel::rightClicked, this, [=]() {
-        QString path = selectAndSaveImage("image2");
-        if (!path.isEmpty()) {
-            ui->imageLabel2->setPixmap(QPixmap(path).scaled(ui->imageLabel2->size(), Qt::KeepAspectRatio));
-            imagePath2 = path;
-        }
+        selectAndSaveImage(ui->imageLabel2, &imagePath2);
     });
 }
 
@@ -248,32 +243,25 @@ void OrderMenu::insertDummyOrder()
              << ", JobNo:" << finalJobNo << ", OrderNo:" << finalOrderNo;
 }
 
-QString OrderMenu::selectAndSaveImage(const QString &prefix) {
+void OrderMenu::selectAndSaveImage(QLabel *label, QString *imagePath) {
     QString filePath = QFileDialog::getOpenFileName(this, "Select Image", QDir::homePath(), "Images (*.png *.jpg *.jpeg)");
-    if (filePath.isEmpty()) return "";
-
-    QDir appDir(QCoreApplication::applicationDirPath());
-    QString imageDirPath = appDir.filePath("OrderBookImages");
-
-    QDir().mkpath(imageDirPath);  // ensure OrderBookImages/ exists
-
-    QString fileName = prefix + "_" + QFileInfo(filePath).fileName();
-    QString destPath = QDir(imageDirPath).filePath(fileName);
-
-    // ✅ If already exists, skip copying
-    if (QFile::exists(destPath)) {
-        qDebug() << "⚠️ Image already exists, using existing file:" << destPath;
-        return destPath;
-    }
+    if (filePath.isEmpty()) return;
+
+    // Normalized and stored once per content off the GUI thread; orders keep the absolute
+    // path as before. The label takes no other pick until this one is stored.
+    label->setEnabled(false);
+    ImageIngest::ingestAsync(this, filePath, [this, label, imagePath, filePath](const QString &storePath) {
+        label->setEnabled(true);
+        if (storePath.isEmpty()) {
+            QMessageBox::warning(this, "Image Copy Failed", "Could not copy image into the image store:\n" + filePath);
+            return;
+        }
 
-    // Try to copy
-    if (QFile::copy(filePath, destPath)) {
-        qDebug() << "✅ Image copied to:" << destPath;
-        return destPath;
-    } else {
-        QMessageBox::warning(this, "Image Copy Failed", "Could not copy image to:\n" + destPath);
-        return "";
-    }
+        const QString destPath = ImageStore::absolutePath(storePath);
+        qDebug() << "Image stored at:" << destPath;
+        label->setPixmap(QPixmap(destPath).scaled(label->size(), Qt::KeepAspectRatio));
+        *imagePath = destPath;
+    });
 }
 
 void OrderMenu::closeEvent(QCloseEvent *event)
@@ -9,6 +9,7 @@
 class QFileDialog;
 class QPixmap;
 class QDir;
+class QLabel;
 
 
 namespace Ui {
@@ -38,7 +39,8 @@ private slots:
     // int getNextOrderNumberForSeller(const QString& sellerId);
 
 private:
-    QString selectAndSaveImage(const QString &prefix);
+    // Lets the user pick a photo and, once it is in the image store, shows it on label and sets imagePath
+    void selectAndSaveImage(QLabel *label, QString *imagePath);
     Ui::OrderMenu *ui;
     QString imagePath1, imagePath2;
 
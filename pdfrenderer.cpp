@@ -0,0 +1,875 @@
+#include <QDate>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPdfWriter>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "pdfrenderer.h"
+
+namespace {
+std::atomic_int embedDpi{150};
+
+// Parallel parts of a render (batch job sheets, image preparation); one thread per core
+QThreadPool &renderPool()
+{
+    static QThreadPool pool;
+    return pool;
+}
+
+// Prepares path for a fresh file: its folder exists and an older file is gone
+void prepareOutput(const QString &path)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile::remove(path);
+}
+
+void stepProgress(PdfRenderer::Progress *progress)
+{
+    if (progress)
+        progress->done.fetch_add(1);
+}
+
+bool isCancelled(const PdfRenderer::Progress *progress)
+{
+    return progress && progress->cancelled.load();
+}
+
+// Ends painting and drops the unfinished file of a cancelled render
+PdfRenderResult cancelledResult(QPainter &painter, const QString &path)
+{
+    painter.end();
+    QFile::remove(path);
+
+    PdfRenderResult result;
+    result.pdfPath = path;
+    result.cancelled = true;
+    return result;
+}
+
+// Pixels needed to print deviceSize (in units of a deviceDpi paint device) at dpi
+QSize printedPixels(const QSize &deviceSize, int deviceDpi, int dpi)
+{
+    return QSize(qRound(deviceSize.width() * qreal(dpi) / deviceDpi),
+                 qRound(deviceSize.height() * qreal(dpi) / deviceDpi));
+}
+
+// Crops image to target's aspect ratio around its centre, then scales it down to target.
+// A source smaller than target is cropped only; upscaling would just add bytes.
+QImage coverImage(const QImage &image, const QSize &target)
+{
+    const QSize crop = target.scaled(image.size(), Qt::KeepAspectRatio);
+    QImage cropped = image.copy((image.width() - crop.width()) / 2, (image.height() - crop.height()) / 2,
+                                crop.width(), crop.height());
+    if (cropped.width() > target.width())
+        cropped = cropped.scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    return cropped;
+}
+
+// path decoded straight to the smallest size that still covers target, cropped to it and
+// flattened onto white. The PDF engine stores opaque images as DCT (JPEG) streams; one with
+// an alpha channel would be stored losslessly at several times the size.
+QImage embeddableImage(const QString &path, const QSize &target)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    // The scaled decode happens before orientation is applied
+    const QSize stored = reader.size();
+    if (stored.isValid()) {
+        const bool turned = reader.transformation() & QImageIOHandler::TransformationRotate90;
+        const QSize oriented = turned ? stored.transposed() : stored;
+        const QSize cover = oriented.scaled(target, Qt::KeepAspectRatioByExpanding);
+        if (cover.width() < oriented.width())
+            reader.setScaledSize(turned ? cover.transposed() : cover);
+    }
+
+    const QImage image = reader.read();
+    if (image.isNull())
+        return QImage();
+
+    const QImage fitted = coverImage(image, target);
+    if (!fitted.hasAlphaChannel())
+        return fitted.convertToFormat(QImage::Format_RGB32);
+
+    QImage flat(fitted.size(), QImage::Format_RGB32);
+    flat.fill(Qt::white);
+    QPainter painter(&flat);
+    painter.drawImage(0, 0, fitted);
+    painter.end();
+    return flat;
+}
+
+// Every distinct path prepared once, in parallel. The PDF engine writes one image object per
+// QImage (by cacheKey), so a design that is in the cart in several karats, or the placeholder
+// standing in for every missing file, is embedded a single time.
+QHash<QString, QImage> embeddableImages(const QList<CartPdfItem> &items, const QSize &target)
+{
+    QStringList paths;
+    for (const CartPdfItem &item : items) {
+        if (!item.imagePath.isEmpty() && !paths.contains(item.imagePath))
+            paths.append(item.imagePath);
+    }
+
+    QList<QFuture<QImage>> futures;
+    futures.reserve(paths.size());
+    for (const QString &path : paths)
+        futures.append(QtConcurrent::run(&renderPool(), [path, target]() { return embeddableImage(path, target); }));
+
+    const QImage placeholder = embeddableImage(":/icon/no_image_1.png", target);
+    QHash<QString, QImage> images;
+    for (int i = 0; i < paths.size(); ++i) {
+        const QImage image = futures[i].result();
+        images.insert(paths[i], image.isNull() ? placeholder : image);
+    }
+    images.insert(QString(), placeholder);
+    return images;
+}
+
+// Gold-header summary table of a cart PDF; returns the y of its last row
+int drawPieceTable(QPainter &painter, int tableX, int tableY, int colWidth, int rowHeight,
+                   const QStringList &headers, const QList<CartPdfPieceRow> &rows)
+{
+    // Header
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor("#d4af37"));
+    for (int col = 0; col < headers.size(); ++col)
+        painter.drawRect(tableX + col * colWidth, tableY, colWidth, rowHeight);
+    painter.setPen(Qt::white);
+    for (int col = 0; col < headers.size(); ++col)
+        painter.drawText(QRect(tableX + col * colWidth + 10, tableY, colWidth, rowHeight), Qt::AlignLeft | Qt::AlignVCenter, headers[col]);
+    painter.setPen(QPen(Qt::black, 1));
+    painter.setBrush(Qt::NoBrush);
+    for (int col = 0; col < headers.size(); ++col)
+        painter.drawRect(tableX + col * colWidth, tableY, colWidth, rowHeight);
+
+    // Rows: carat per piece, type, size, count; then the Total row of the cart table
+    QList<QStringList> texts;
+    int totalQuantity = 0;
+    for (const CartPdfPieceRow &row : rows) {
+        texts.append({QString::number(row.weight, 'f', 3) + "ct", row.type, row.sizeMM, QString::number(row.quantity)});
+        totalQuantity += row.quantity;
+    }
+    if (!rows.isEmpty())
+        texts.append({QString(), "Total", QString(), QString::number(totalQuantity)});
+
+    for (const QStringList &cells : texts) {
+        tableY += rowHeight;
+        painter.setPen(QColor("#333"));
+        for (int col = 0; col < cells.size(); ++col)
+            painter.drawText(QRect(tableX + col * colWidth + 10, tableY, colWidth, rowHeight), Qt::AlignLeft | Qt::AlignVCenter, cells[col]);
+        for (int col = 0; col < cells.size(); ++col)
+            painter.drawRect(tableX + col * colWidth, tableY, colWidth, rowHeight);
+    }
+
+    return tableY;
+}
+
+// Static part of a job sheet (grid, black rules and labels), laid out once and replayed
+// for every job. Kept as vector primitives rather than a raster so pages stay sharp and small.
+struct JobSheetTemplate {
+    struct Text {
+        QFont font;
+        QPoint position;
+        QString text;
+    };
+    struct WrappedText {
+        QFont font;
+        QRect rect;
+        QString text;
+    };
+
+    QVector<QRect> filled;      // solid black rules
+    QVector<QRect> outlines;    // cell borders
+    QVector<Text> texts;
+    QVector<WrappedText> wrapped;
+};
+
+void addRow(QVector<QRect> &cells, int x, int y, const QVector<int> &widths, int height)
+{
+    for (int w : widths) {
+        cells.append(QRect(x, y, w, height));
+        x += w; // move to next column
+    }
+}
+
+void addTextRow(JobSheetTemplate &sheet, const QFont &font, int x, int y, const QVector<QString> &texts,
+                const QVector<int> &widths = {})
+{
+    int curX = x;
+    for (int i = 0; i < texts.size(); ++i) {
+        sheet.texts.append({font, QPoint(curX, y), texts[i]});
+        if (!widths.isEmpty() && i < widths.size()) {
+            curX += widths[i];
+        } else {
+            curX += 150; // default spacing if widths not given
+        }
+    }
+}
+
+JobSheetTemplate buildJobSheetTemplate()
+{
+    JobSheetTemplate sheet;
+    QFont font;
+
+    // Black lines
+    sheet.filled.append(QRect(2125, 320, 8, 1545));
+    sheet.filled.append(QRect(100, 645, 2025, 8));
+    sheet.filled.append(QRect(100, 1240, 2025, 8));
+    sheet.filled.append(QRect(100, 1670, 2025, 8));
+
+    // Right Side default Rectangle
+    sheet.outlines.append(QRect(2133, 320, 700, 350));
+    sheet.outlines.append(QRect(2833, 320, 442, 65));
+    sheet.outlines.append(QRect(2833, 385, 442, 285));
+    sheet.outlines.append(QRect(2133, 670, 1142, 1130));
+
+    // Left Side Rectangles
+    int y_rect = 320 - 65; //this is -65 because of we are adding 65 in for loop
+
+    // First rows
+    // y_rect += 65;
+    // addRow(sheet.outlines, 100, y_rect, {275, 1200, 275, 275}, 65);
+
+    // Next 2 rows
+    for (int i = 0; i < 3; i++) {
+        y_rect += 65;
+        addRow(sheet.outlines, 100, y_rect, {275, 750, 250, 250, 250, 250}, 65);
+    }
+    // Next 2 rows
+    for (int i = 0; i < 2; i++) {
+        y_rect += 65;
+        addRow(sheet.outlines, 100, y_rect, {275, 250, 250, 250, 250, 250, 250, 250}, 65);
+    }
+
+    y_rect -= 20;
+    // Gold issue table (7 rows)
+    for (int i = 0; i < 7; i++) {
+        // if(i==0){painter.setBrush(QColor("#60e6eb"));} else {painter.setBrush(Qt::NoBrush);}
+        y_rect += 85;
+        addRow(sheet.outlines, 100, y_rect, {400, 325, 325, 325, 325, 325}, 85);
+    }
+    // Next section
+    y_rect += 85;  // consistent height step
+    addRow(sheet.outlines, 100, y_rect, {275, 275, 925, 275, 275}, 90);
+
+    y_rect += 5;
+    // 4 rows of equal-height cells
+    for (int i = 0; i < 4; i++) {
+        y_rect += 85;
+        addRow(sheet.outlines, 100, y_rect, {375, 275, 275, 275, 275, 275, 275}, 85);
+    }
+
+    // Final block (3-row merged cells)
+    y_rect += 85; // move down before block
+    addRow(sheet.outlines, 100, y_rect, {460, 275, 275, 555, 460}, 65 * 3);
+
+    // Sub-rows inside merged block
+    int y_sub = y_rect;  // start at same top as merged block
+    for (int i = 0; i < 2; i++) {
+        y_sub += 65;
+        addRow(sheet.outlines, 100 + 460, y_sub, {275, 275, 280, 275}, 65);
+    }
+
+    // Last section (right side small cols)
+    y_rect += 65 * 2; // move below merged block
+    addRow(sheet.outlines, 2133, y_rect, {190, 190, 190, 190, 190, 190}, 65);
+
+    // Define font for header
+    // Company header
+    font = QFont("Arial", 7, QFont::Bold);
+    addTextRow(sheet, font, 800, 300, {"SHREE LAXMINARAYAN EXPORT"});
+    addTextRow(sheet, font, 2500, 300, {"GST - 24AEXFS9858P1ZI"});
+
+    // Labels font
+    font = QFont("Arial", 7);
+
+    int y_text = 370;
+
+    // Row 1
+    addTextRow(sheet, font, 110, y_text, {"Job Issue", "Order Date", "Delivery Date", "Note"},
+               {1025, 500, 1208, 700});
+
+    // Row 2
+    y_text += 68;
+    addTextRow(sheet, font, 110, y_text, {"Party Name", "Party Code", "Order No."},
+               {1025, 500, 500});
+
+    // Row 3
+    y_text += 63;
+    addTextRow(sheet, font, 110, y_text, {"Item Design", "Design No.", "Job No."},
+               {1025, 500, 500});
+
+    // Metal info row
+    y_text += 67;
+    addTextRow(sheet, font, 110, y_text,
+               {"Metal Name", "Met. Purity", "Met. Color", "Size No.", "MM", "Length", "Width", "Height"},
+               {275, 250, 250, 250, 250, 250, 250, 250});
+
+    // Gold Issue Table header (bold)
+    y_text += 143;
+    font = QFont("Arial", 9, QFont::Bold);
+    addTextRow(sheet, font, 510, y_text, {"Issue Wt.", "Ret. Dust Wt.", "Loss Wt.", "Return Wt.", "Loss %"},
+               {325, 325, 325, 325, 325});
+
+    // Left side job process rows
+    // painter.setFont(QFont("Arial", 7));
+    y_text += 87;
+    addTextRow(sheet, font, 110, y_text, {"Filing"});
+
+    y_text += 87;
+    addTextRow(sheet, font, 110, y_text, {"Buffing"});
+
+    y_text += 87;
+    addTextRow(sheet, font, 110, y_text, {"Free Polich"});
+
+    y_text += 85;
+    addTextRow(sheet, font, 110, y_text, {"Setting"});
+
+    y_text += 85;
+    addTextRow(sheet, font, 110, y_text, {"Final Poliching"});
+
+    y_text += 83;
+    addTextRow(sheet, font, 110, y_text, {"Total"});
+
+    // Diamond & Stone Issue header
+    y_text += 90;
+    addTextRow(sheet, font, 110 + 275 + 275 + 180, y_text, {"Diamond & Stone Issue"});
+
+    font = QFont("Arial", 8.5, QFont::Bold);
+    y_text += 85;
+    addTextRow(sheet, font, 110 + 375, y_text,
+               {"Issue Pcs.", "Issue Wt.", "Return Pcs.", "Return Wt.", "Broken Pcs.", "Broken Wt."},
+               {275, 275, 275, 275, 275, 275});
+
+    // Diamond / Stone / Other labels
+    // painter.setFont(QFont("Arial", 7));
+    y_text += 85;
+    addTextRow(sheet, font, 110, y_text, {"Diamond"});
+
+    y_text += 85;
+    addTextRow(sheet, font, 110, y_text, {"Stone"});
+
+    y_text += 85;
+    addTextRow(sheet, font, 110, y_text, {"Other"});
+
+    // Small footer text
+    y_text += 53;
+    font = QFont("Arial", 5.5);
+    addTextRow(sheet, font, 110, y_text, {"For. Shree Laxminarayan Export"});
+
+    // Overleaf text with word wrap
+    sheet.wrapped.append({font, QRect(110 + 460 + 275 + 275 + 555, y_text - 25, 460, 1000),
+                          "Received the above goods as per conditions overleaf."});
+
+    font = QFont("Arial", 7);
+    y_text += 20;
+
+    // Weight section
+    int x_text = 110 + 460;
+    addTextRow(sheet, font, x_text, y_text, {"Diamond Wt.", "Final Product Wt."}, {275+275+110, 660});
+
+    y_text += 62;
+    addTextRow(sheet, font, x_text, y_text, {"Stone Wt.", "Net. Wt."}, {275+275, 525});
+
+    y_text += 65;
+    addTextRow(sheet, font, x_text, y_text, {"Other Wt.", "Gross. Wt."}, {275+275, 525});
+
+    // Rightmost labels
+    addTextRow(sheet, font, x_text + 275 + 275 + 555 + 460 + 8, y_text, {"Diamond", "Stone", "Other"}, {190+190, 190+190, 190});
+
+    font = QFont("Arial", 5.5);
+    // Signatures
+    x_text -= 460;
+    addTextRow(sheet, font, x_text, y_text, {"Proprietor/ Authorised Signature"});
+    addTextRow(sheet, font, x_text + 460 + 275 + 275 + 555, y_text, {"Receiver's Signature"});
+
+    return sheet;
+}
+
+// Built on first use by whichever thread gets there; read-only afterwards
+const JobSheetTemplate &jobSheetTemplate()
+{
+    static const JobSheetTemplate sheet = buildJobSheetTemplate();
+    return sheet;
+}
+
+void setupJobSheetWriter(QPdfWriter &writer)
+{
+    // Set page size to 21 cm × 29.7 cm
+    QSizeF pageSize(612, 842); // Width × Height in points
+    QPageSize customPageSize(pageSize, QPageSize::Point, "CustomA4");
+    writer.setPageSize(customPageSize);
+
+    // Zero margins
+    QMarginsF margins(0, 0, 0, 0); // left, top, right, bottom
+    QPageLayout pageLayout(customPageSize, QPageLayout::Portrait, margins);
+    writer.setPageLayout(pageLayout);
+
+    writer.setResolution(400);  // High resolution for print quality
+}
+
+// One job sheet page: the shared template, then this job's own values in their cells
+void paintJobSheet(QPainter &painter, const JobSheetPdfData &job)
+{
+    const JobSheetTemplate &sheet = jobSheetTemplate();
+
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    QPen pen(Qt::black, 7);
+    pen.setJoinStyle(Qt::MiterJoin);
+    painter.setPen(pen);
+
+    painter.setBrush(Qt::black);
+    painter.drawRects(sheet.filled);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRects(sheet.outlines);
+
+    for (const JobSheetTemplate::Text &text : sheet.texts) {
+        painter.setFont(text.font);
+        painter.drawText(text.position, text.text);
+    }
+    for (const JobSheetTemplate::WrappedText &text : sheet.wrapped) {
+        painter.setFont(text.font);
+        painter.drawText(text.rect, Qt::TextWordWrap, text.text);
+    }
+
+    // Values sit in the cell right of their label (rows at y 370, 438, 501)
+    painter.setFont(QFont("Arial", 7));
+    painter.drawText(QPoint(1385, 370), job.orderDate);
+    painter.drawText(QPoint(1885, 370), job.deliveryDate);
+    painter.drawText(QPoint(1385, 438), job.partyId);
+    painter.drawText(QPoint(1885, 501), job.jobNo);
+}
+}
+
+PdfRenderer::PdfRenderer(QObject *parent)
+    : QObject(parent)
+    , progress(std::make_shared<Progress>())
+    , progressTimer(new QTimer(this))
+{
+    workers.setMaxThreadCount(1);
+
+    // Polled rather than signalled from the worker, so the worker never touches this object
+    progressTimer->setInterval(100);
+    connect(progressTimer, &QTimer::timeout, this, [this]() {
+        emit progressChanged(progress->done.load(), progress->total.load());
+    });
+}
+
+PdfRenderer::~PdfRenderer()
+{
+    progress->cancelled.store(true);
+    workers.clear();
+    workers.waitForDone();
+}
+
+template <typename Task>
+void PdfRenderer::start(Task task)
+{
+    running = true;
+    progress = std::make_shared<Progress>();
+    progressTimer->start();
+
+    const auto shared = progress;
+    auto *watcher = new QFutureWatcher<PdfRenderResult>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, shared]() {
+        watcher->deleteLater();
+        if (shared != progress || !running)
+            return; // cancelled; finished() was already emitted
+
+        running = false;
+        progressTimer->stop();
+        emit progressChanged(shared->done.load(), shared->total.load());
+        emit finished(watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run(&workers, [task, shared]() {
+        return task(shared.get());
+    }));
+}
+
+int PdfRenderer::imageDpi()
+{
+    return embedDpi.load();
+}
+
+void PdfRenderer::setImageDpi(int dpi)
+{
+    embedDpi.store(qBound(72, dpi, 600));
+}
+
+void PdfRenderer::renderCart(const CartPdfData &data)
+{
+    if (running)
+        return;
+
+    runningPath = data.pdfPath;
+    start([data](Progress *shared) { return cartPdf(data, shared); });
+}
+
+void PdfRenderer::renderJobSheet(const JobSheetPdfData &data)
+{
+    if (running)
+        return;
+
+    runningPath = data.pdfPath;
+    start([data](Progress *shared) { return jobSheetPdf(data, shared); });
+}
+
+void PdfRenderer::renderJobSheets(const QList<JobSheetPdfData> &jobs, const QString &mergedPath)
+{
+    if (running)
+        return;
+
+    runningPath = mergedPath;
+    start([jobs, mergedPath](Progress *shared) { return jobSheetPdfs(jobs, mergedPath, shared); });
+}
+
+void PdfRenderer::cancel()
+{
+    if (!running)
+        return;
+
+    // The worker stops at its next page and removes what it wrote
+    progress->cancelled.store(true);
+    running = false;
+    progressTimer->stop();
+
+    PdfRenderResult result;
+    result.pdfPath = runningPath;
+    result.cancelled = true;
+    emit finished(result);
+}
+
+PdfRenderResult PdfRenderer::cartPdf(const CartPdfData &data, Progress *progress)
+{
+    PdfRenderResult result;
+    result.pdfPath = data.pdfPath;
+
+    constexpr int ItemsPerPage = 3;
+    const int imagePages = (data.items.size() + ItemsPerPage - 1) / ItemsPerPage;
+    if (progress)
+        progress->total.store(imagePages + 2);   // cover and summary
+
+    prepareOutput(data.pdfPath);
+    QPdfWriter writer(data.pdfPath);
+    writer.setPageSize(QPageSize(QPageSize::A4));
+    writer.setPageMargins(QMarginsF(5, 5, 5, 5)); // 5mm margins
+    writer.setResolution(72);
+
+    QPainter painter(&writer);
+    if (!painter.isActive()) {
+        result.error = "Cannot write " + data.pdfPath;
+        return result;
+    }
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QSizeF contentSize = writer.pageLayout().paintRectPixels(writer.resolution()).size();
+    int pageWidth = contentSize.width();
+
+    // ========== 1. COVER PAGE ==========
+    painter.save();
+    painter.setFont(QFont("Georgia", 40));
+    painter.setPen(QColor("#d4af37"));
+    QString title1 = "Exquisite";
+    int yPos = 20 * 72 / 25.4; // 20mm from top
+    painter.drawText(QRect(0, yPos, pageWidth, 100), Qt::AlignCenter, title1);
+
+    painter.setFont(QFont("Georgia", 34));
+    QString title2 = "Jewelry Collection";
+    yPos += 50;
+    painter.drawText(QRect(0, yPos, pageWidth, 100), Qt::AlignCenter, title2);
+
+    painter.setFont(QFont("Georgia", 20));
+    painter.setPen(Qt::black);
+    yPos += 80;
+    painter.drawText(QRect(0, yPos, pageWidth, 100), Qt::AlignCenter, QString("Prepared for: %1").arg(data.userName));
+
+    painter.setFont(QFont("Georgia", 18));
+    yPos += 40;
+    painter.drawText(QRect(0, yPos, pageWidth, 100), Qt::AlignCenter, QString("Date: %1").arg(QDate::currentDate().toString("MMMM d, yyyy")));
+
+    painter.setFont(QFont("Georgia", 16));
+    yPos += 80;
+    painter.drawText(QRect(0, yPos, pageWidth, 100), Qt::AlignCenter, data.companyName);
+
+    painter.setFont(QFont("Georgia", 14));
+    painter.setPen(QColor("#555"));
+    yPos += 40;
+    painter.drawText(QRect(0, yPos, pageWidth, 100), Qt::AlignCenter, QString("Contact: %1 | %2").arg(data.mobileNo, "contact@megamine.com"));
+    painter.restore();
+    stepProgress(progress);
+
+    // ========== 2. IMAGE PAGES ==========
+    const QRect imageBox(0, 0, 250, 220);
+    const QHash<QString, QImage> images =
+        embeddableImages(data.items, printedPixels(imageBox.size(), writer.resolution(), imageDpi()));
+    for (int i = 0; i < data.items.size(); i += ItemsPerPage) {
+        if (isCancelled(progress))
+            return cancelledResult(painter, data.pdfPath);
+
+        writer.newPage();
+        painter.save();
+
+        int blockWidth = static_cast<int>(pageWidth * 0.9);
+        int blockX = (pageWidth - blockWidth) / 2;
+        int blockY = 20;
+
+        for (int j = 0; j < ItemsPerPage && (i + j) < data.items.size(); ++j) {
+            const CartPdfItem &item = data.items[i + j];
+
+            // Shadow effect
+            QRect blockRect(blockX, blockY, blockWidth, 240);
+            QRect shadowRect = blockRect.adjusted(5, 5, 5, 5);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(QColor(0, 0, 0, 80));
+            painter.drawRoundedRect(shadowRect, 10, 10);
+
+            // White block
+            painter.setPen(QPen(QColor("#ccc"), 1));
+            painter.setBrush(Qt::white);
+            painter.drawRoundedRect(blockRect, 10, 10);
+
+            // Image, already at its printed size; shared with other lines of the same design
+            const QImage image = images.value(item.imagePath);
+            if (!image.isNull()) {
+                QRect imgRect = imageBox.translated(blockX + 10, blockY + 10);
+
+                QPainterPath clipPath;
+                clipPath.addRoundedRect(imgRect, 10, 10);
+                painter.save();
+                painter.setClipPath(clipPath);
+                painter.drawImage(imgRect, image);
+                painter.restore();
+            }
+
+            // Text
+            painter.setFont(QFont("Georgia", 14));
+            painter.setPen(QColor("#333333"));
+            QRect textRect(blockX + 285, blockY, blockWidth - 285, 240);
+
+            QString diamondText = "None";
+            QJsonDocument doc = QJsonDocument::fromJson(item.diamondJson.toUtf8());
+            if (doc.isObject()) {
+                QJsonObject obj = doc.object();
+                QString shape = obj["shape"].toString();
+                double weight = obj["weight"].toDouble();
+                if (!shape.isEmpty() && weight > 0) {
+                    diamondText = QString("%1 ct, %2").arg(weight, 0, 'f', 2).arg(shape);
+                }
+            }
+
+            QString itemText = QString(
+                                   "Jewelry Item #%1\n"
+                                   "Type: %2\n"
+                                   "Diamond: %3\n"
+                                   "Gold: %4, %5g\n"
+                                   "Description: Elegant design with fine detailing."
+                                   ).arg(i + j + 1)
+                                   .arg(item.goldType)
+                                   .arg(diamondText)
+                                   .arg(item.goldType)
+                                   .arg(item.goldWeight, 0, 'f', 3);
+
+            painter.drawText(textRect, Qt::AlignLeft | Qt::AlignTop, itemText);
+
+            blockY += 260;
+        }
+
+        painter.restore();
+        stepProgress(progress);
+    }
+
+    if (isCancelled(progress))
+        return cancelledResult(painter, data.pdfPath);
+
+    // ========== 3. SUMMARY PAGE ==========
+    writer.newPage();
+    painter.save();
+
+    // Title
+    painter.setFont(QFont("Georgia", 24));
+    painter.setPen(QColor("#d4af37"));
+    painter.drawText(QRect(0, 20, pageWidth, 100), Qt::AlignCenter, "Order Summary");
+
+    // Gold Details Table
+    painter.setFont(QFont("Georgia", 16));
+    painter.setPen(QColor("#333"));
+    int tableY = 100;
+    painter.drawText(QRect(0, tableY, pageWidth, 50), Qt::AlignLeft, "Gold Details");
+
+    tableY += 30;
+    int tableX = 20;
+    int colWidth = pageWidth / 2 - 20;
+    int rowHeight = 40;
+
+    // Header
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor("#d4af37"));
+    painter.drawRect(tableX, tableY, colWidth, rowHeight);
+    painter.drawRect(tableX + colWidth, tableY, colWidth, rowHeight);
+    painter.setFont(QFont("Georgia", 12));
+    painter.setPen(Qt::white);
+    painter.drawText(QRect(tableX + 10, tableY, colWidth, rowHeight), Qt::AlignLeft | Qt::AlignVCenter, "Gold KT");
+    painter.drawText(QRect(tableX + colWidth + 10, tableY, colWidth, rowHeight), Qt::AlignLeft | Qt::AlignVCenter, "Total Weight (grams)");
+    painter.setPen(QPen(Qt::black, 1));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(tableX, tableY, colWidth, rowHeight);
+    painter.drawRect(tableX + colWidth, tableY, colWidth, rowHeight);
+
+    // Gold Rows
+    tableY += rowHeight;
+    painter.setPen(QColor("#333"));
+    for (auto it = data.goldByKarat.constBegin(); it != data.goldByKarat.constEnd(); ++it) {
+        painter.drawText(QRect(tableX + 10, tableY, colWidth, rowHeight), Qt::AlignLeft | Qt::AlignVCenter, it.key());
+        painter.drawText(QRect(tableX + colWidth + 10, tableY, colWidth, rowHeight), Qt::AlignLeft | Qt::AlignVCenter, QString::number(it.value(), 'f', 3));
+        painter.drawRect(tableX, tableY, colWidth, rowHeight);
+        painter.drawRect(tableX + colWidth, tableY, colWidth, rowHeight);
+        tableY += rowHeight;
+    }
+
+    // Diamond Details Table
+    tableY += 40;
+    painter.setFont(QFont("Georgia", 16));
+    painter.drawText(QRect(0, tableY, pageWidth, 50), Qt::AlignLeft, "Diamond Details");
+
+    tableY += 30;
+    colWidth = pageWidth / 4 - 10;
+    tableY = drawPieceTable(painter, tableX, tableY, colWidth, rowHeight, {"Carat", "Clarity", "Color", "Count"}, data.diamonds);
+
+    // Stone Details Table
+    tableY += 40;
+    painter.setFont(QFont("Georgia", 16));
+    painter.drawText(QRect(0, tableY, pageWidth, 50), Qt::AlignLeft, "Stone Details");
+
+    tableY += 30;
+    tableY = drawPieceTable(painter, tableX, tableY, colWidth, rowHeight, {"Carat", "Type", "Size", "Count"}, data.stones);
+
+    // Footer
+    painter.setFont(QFont("Georgia", 12));
+    painter.setPen(QColor("#555"));
+    painter.drawText(QRect(0, tableY + 80, pageWidth, 50), Qt::AlignCenter, "Thank you for your trust!");
+
+    painter.restore();
+    result.ok = painter.end();
+    stepProgress(progress);
+
+    result.pages = imagePages + 2;
+    if (!result.ok)
+        result.error = "Failed to finish " + data.pdfPath;
+    return result;
+}
+
+PdfRenderResult PdfRenderer::jobSheetPdf(const JobSheetPdfData &data, Progress *progress)
+{
+    PdfRenderResult result;
+    result.pdfPath = data.pdfPath;
+    if (progress)
+        progress->total.store(1);
+
+    writeJobSheet(data, result);
+    stepProgress(progress);
+    return result;
+}
+
+PdfRenderResult PdfRenderer::jobSheetPdfs(const QList<JobSheetPdfData> &jobs, const QString &mergedPath,
+                                          Progress *progress)
+{
+    PdfRenderResult result;
+    if (progress)
+        progress->total.store(jobs.size());
+
+    if (!mergedPath.isEmpty()) {
+        // One writer, one page per job; QPdfWriter cannot be shared between threads
+        result.pdfPath = mergedPath;
+        prepareOutput(mergedPath);
+        QPdfWriter writer(mergedPath);
+        setupJobSheetWriter(writer);
+
+        QPainter painter(&writer);
+        if (!painter.isActive()) {
+            result.error = "Cannot write " + mergedPath;
+            return result;
+        }
+
+        for (int i = 0; i < jobs.size(); ++i) {
+            if (isCancelled(progress))
+                return cancelledResult(painter, mergedPath);
+            if (i > 0)
+                writer.newPage();
+            paintJobSheet(painter, jobs[i]);
+            stepProgress(progress);
+        }
+
+        result.ok = painter.end();
+        result.pages = jobs.size();
+        if (!result.ok)
+            result.error = "Failed to create PDF file: " + mergedPath;
+        return result;
+    }
+
+    // Separate files are independent, so they render in parallel
+    QList<QFuture<PdfRenderResult>> futures;
+    futures.reserve(jobs.size());
+    for (const JobSheetPdfData &job : jobs) {
+        futures.append(QtConcurrent::run(&renderPool(), [job, progress]() {
+            PdfRenderResult jobResult;
+            jobResult.pdfPath = job.pdfPath;
+            if (isCancelled(progress)) {
+                jobResult.cancelled = true;
+                return jobResult;
+            }
+            writeJobSheet(job, jobResult);
+            stepProgress(progress);
+            return jobResult;
+        }));
+    }
+
+    QStringList failed;
+    for (QFuture<PdfRenderResult> &future : futures) {
+        const PdfRenderResult jobResult = future.result();
+        if (result.pdfPath.isEmpty())
+            result.pdfPath = QFileInfo(jobResult.pdfPath).absolutePath();
+        if (jobResult.ok)
+            ++result.pages;
+        else if (jobResult.cancelled)
+            result.cancelled = true;
+        else
+            failed << QFileInfo(jobResult.pdfPath).fileName();
+    }
+
+    result.ok = failed.isEmpty() && !result.cancelled;
+    if (!failed.isEmpty())
+        result.error = "Failed to create: " + failed.join(", ");
+    return result;
+}
+
+void PdfRenderer::paintJobSheetPage(QPainter &painter, const JobSheetPdfData &job)
+{
+    paintJobSheet(painter, job);
+}
+
+void PdfRenderer::writeJobSheet(const JobSheetPdfData &data, PdfRenderResult &result)
+{
+    prepareOutput(data.pdfPath);
+    QPdfWriter writer(data.pdfPath);
+    setupJobSheetWriter(writer);
+
+    QPainter painter(&writer);
+    if (!painter.isActive()) {
+        result.error = "Cannot write " + data.pdfPath;
+        return;
+    }
+
+    paintJobSheet(painter, data);
+
+    result.ok = painter.end();  // Finish painting
+    result.pages = 1;
+    if (!result.ok)
+        result.error = "Failed to create PDF file: " + data.pdfPath;
+}
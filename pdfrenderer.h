@@ -0,0 +1,78 @@
+#ifndef PDFRENDERER_H
+#define PDFRENDERER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <atomic>
+#include <memory>
+
+#include "commontypes.h"
+
+class QPainter;
+
+// Renders cart and job-sheet PDFs on a worker thread.
+// Callers hand over a plain snapshot (CartPdfData / JobSheetPdfData) and get progress and
+// the result back as signals on the owner's thread. Rendering paints with QImage only and
+// never reads widgets, so the GUI stays responsive and the output does not depend on what
+// the cart happens to show.
+class PdfRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Shared between the worker and the owner; the worker writes done/total, the owner
+    // sets cancelled
+    struct Progress {
+        std::atomic_int done{0};
+        std::atomic_int total{0};
+        std::atomic_bool cancelled{false};
+    };
+
+    // Print resolution of photos embedded in cart PDFs; each is decoded, cropped and scaled
+    // to exactly its printed size at this DPI before it reaches the PDF. Defaults to 150.
+    static int imageDpi();
+    static void setImageDpi(int dpi);
+
+    explicit PdfRenderer(QObject *parent = nullptr);
+    ~PdfRenderer() override;
+
+    void renderCart(const CartPdfData &data);
+    void renderJobSheet(const JobSheetPdfData &data);
+    // Every job to its own pdfPath in parallel, or all of them as pages of mergedPath when set
+    void renderJobSheets(const QList<JobSheetPdfData> &jobs, const QString &mergedPath = QString());
+    void cancel();
+    bool isRunning() const { return running; }
+
+    // The renderers themselves; any thread. progress may be null. A cancelled render
+    // stops at the next page and removes the partial file.
+    static PdfRenderResult cartPdf(const CartPdfData &data, Progress *progress = nullptr);
+    static PdfRenderResult jobSheetPdf(const JobSheetPdfData &data, Progress *progress = nullptr);
+    // pdfPath of the result is mergedPath, or the folder of the separate files
+    static PdfRenderResult jobSheetPdfs(const QList<JobSheetPdfData> &jobs, const QString &mergedPath,
+                                        Progress *progress = nullptr);
+
+    // One job sheet page painted onto painter in the 400 dpi page coordinates the PDF uses;
+    // what writeJobSheet() sends to QPdfWriter, for checking the layout without a PDF reader
+    static void paintJobSheetPage(QPainter &painter, const JobSheetPdfData &job);
+
+signals:
+    void progressChanged(int done, int total);
+    void finished(const PdfRenderResult &result);
+
+private:
+    template <typename Task>
+    void start(Task task);
+
+    static void writeJobSheet(const JobSheetPdfData &data, PdfRenderResult &result);
+
+    // QPdfWriter output is single-threaded per file; one job at a time keeps memory flat
+    QThreadPool workers;
+    std::shared_ptr<Progress> progress;
+    QTimer *progressTimer;
+    QString runningPath;
+    bool running = false;
+};
+
+#endif // PDFRENDERER_H
@@ -0,0 +1,271 @@
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include <algorithm>
+#include <cmath>
+
+#include "connectionpool.h"
+#include "referencedatacache.h"
+
+namespace {
+// sizeMM is a REAL column; values parsed from catalog JSON text must still compare equal
+constexpr double SizeEpsilon = 1e-6;
+
+QString shapeKeyFor(const QString &shape)
+{
+    return shape.trimmed().toCaseFolded();
+}
+}
+
+ReferenceDataCache &ReferenceDataCache::instance()
+{
+    static ReferenceDataCache cache;
+    return cache;
+}
+
+std::optional<double> ReferenceDataCache::roundWeight(double sizeMM)
+{
+    return find(snapshot()->round, QString(), sizeMM);
+}
+
+std::optional<double> ReferenceDataCache::fancyWeight(const QString &shape, const QString &sizeMM)
+{
+    return find(snapshot()->fancy, shapeKeyFor(shape), sizeMM);
+}
+
+std::optional<double> ReferenceDataCache::stoneWeight(const QString &shape, const QString &sizeMM)
+{
+    return find(snapshot()->stones, shapeKeyFor(shape), sizeMM);
+}
+
+std::optional<double> ReferenceDataCache::nearestRoundWeight(double sizeMM)
+{
+    const auto data = snapshot();
+    const std::vector<Entry> &round = data->round;
+    // Only numeric sizes have a distance; they come first
+    const auto first = round.begin();
+    const auto last = std::partition_point(round.begin(), round.end(), [](const Entry &e) { return e.numeric; });
+    if (first == last)
+        return std::nullopt;
+
+    auto it = std::lower_bound(first, last, sizeMM,
+                               [](const Entry &e, double size) { return e.sizeMM < size; });
+    if (it == last)
+        return std::prev(last)->weight;
+    if (it != first && sizeMM - std::prev(it)->sizeMM <= it->sizeMM - sizeMM)
+        --it; // ties go to the smaller size
+    return it->weight;
+}
+
+QList<double> ReferenceDataCache::weights(const QList<WeightKey> &keys)
+{
+    const auto data = snapshot();
+
+    QList<double> result;
+    result.reserve(keys.size());
+    for (const WeightKey &key : keys)
+        result.append(lookup(*data, key).value_or(0.0));
+    return result;
+}
+
+QList<bool> ReferenceDataCache::contains(const QList<WeightKey> &keys)
+{
+    const auto data = snapshot();
+
+    QList<bool> result;
+    result.reserve(keys.size());
+    for (const WeightKey &key : keys)
+        result.append(lookup(*data, key).has_value());
+    return result;
+}
+
+QMap<QString, QString> ReferenceDataCache::goldPrices()
+{
+    return snapshot()->goldPrices;
+}
+
+QStringList ReferenceDataCache::diamondShapes()
+{
+    QStringList result = shapes(snapshot()->fancy);
+    if (!result.contains("Round", Qt::CaseInsensitive))
+        result << "Round";
+    result.sort(Qt::CaseInsensitive);
+    return result;
+}
+
+QStringList ReferenceDataCache::stoneShapes()
+{
+    return shapes(snapshot()->stones);
+}
+
+QStringList ReferenceDataCache::roundSizes()
+{
+    return sizes(snapshot()->round, QString());
+}
+
+QStringList ReferenceDataCache::fancySizes(const QString &shape)
+{
+    return sizes(snapshot()->fancy, shapeKeyFor(shape));
+}
+
+QStringList ReferenceDataCache::stoneSizes(const QString &shape)
+{
+    return sizes(snapshot()->stones, shapeKeyFor(shape));
+}
+
+void ReferenceDataCache::invalidate()
+{
+    QMutexLocker locker(&mutex);
+    current.reset();
+    ++generation;
+}
+
+std::shared_ptr<const ReferenceDataCache::Snapshot> ReferenceDataCache::snapshot()
+{
+    quint64 loadGeneration;
+    {
+        QMutexLocker locker(&mutex);
+        if (current)
+            return current;
+        loadGeneration = generation;
+    }
+
+    // Loaded outside the lock on the caller's pooled connection; readers on other threads
+    // may load concurrently, and the first finished copy wins
+    bool complete = false;
+    std::shared_ptr<const Snapshot> loaded = load(&complete);
+
+    QMutexLocker locker(&mutex);
+    if (complete && !current && generation == loadGeneration)
+        current = loaded;
+    return current ? current : loaded;
+}
+
+std::shared_ptr<ReferenceDataCache::Snapshot> ReferenceDataCache::load(bool *ok)
+{
+    auto data = std::make_shared<Snapshot>();
+    *ok = false;
+
+    QSqlDatabase db = ConnectionPool::instance().acquire(DbFile::Image);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] ReferenceDataCache failed to open DB:" << db.lastError().text();
+        return data;
+    }
+
+    auto readTable = [&db](const QString &sql, std::vector<Entry> &out, bool hasShape) {
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.exec(sql)) {
+            qWarning() << "[ERROR] ReferenceDataCache query failed:" << query.lastError().text() << "| SQL:" << sql;
+            return false;
+        }
+        while (query.next()) {
+            Entry e;
+            e.shape = hasShape ? query.value(0).toString().trimmed() : QString();
+            e.shapeKey = shapeKeyFor(e.shape);
+            e.sizeText = query.value(1).toString().trimmed();
+            e.sizeMM = e.sizeText.toDouble(&e.numeric);
+            e.weight = query.value(2).toDouble();
+            out.push_back(std::move(e));
+        }
+
+        std::stable_sort(out.begin(), out.end(), &ReferenceDataCache::lessThan);
+        return true;
+    };
+
+    // rowid order is kept among duplicate keys, matching what the per-row queries returned first
+    bool complete = readTable("SELECT NULL, sizeMM, weight FROM Round_diamond ORDER BY rowid", data->round, false);
+    complete = readTable("SELECT shape, sizeMM, weight FROM Fancy_diamond ORDER BY rowid", data->fancy, true) && complete;
+    complete = readTable("SELECT shape, sizeMM, weight FROM stones ORDER BY rowid", data->stones, true) && complete;
+
+    QSqlQuery gold(db);
+    if (gold.exec("SELECT Kt, Price FROM Gold_Price")) {
+        while (gold.next())
+            data->goldPrices[gold.value(0).toString().trimmed()] = gold.value(1).toString();
+    } else {
+        qWarning() << "[ERROR] ReferenceDataCache gold query failed:" << gold.lastError().text();
+        complete = false;
+    }
+
+    *ok = complete;
+    return data;
+}
+
+std::optional<double> ReferenceDataCache::lookup(const Snapshot &data, const WeightKey &key)
+{
+    const bool isRound = key.isDiamond && key.shape.trimmed().compare("Round", Qt::CaseInsensitive) == 0;
+    if (!key.isDiamond)
+        return find(data.stones, shapeKeyFor(key.shape), key.sizeMM);
+    if (!isRound)
+        return find(data.fancy, shapeKeyFor(key.shape), key.sizeMM);
+
+    bool numeric = false;
+    const double size = key.sizeMM.trimmed().toDouble(&numeric);
+    return numeric ? find(data.round, QString(), size) : std::nullopt;
+}
+
+bool ReferenceDataCache::lessThan(const Entry &a, const Entry &b)
+{
+    // Numbers before text within a shape, like ORDER BY on a column holding both
+    if (a.shapeKey != b.shapeKey)
+        return a.shapeKey < b.shapeKey;
+    if (a.numeric != b.numeric)
+        return a.numeric;
+    return a.numeric ? a.sizeMM < b.sizeMM : a.sizeText < b.sizeText;
+}
+
+std::optional<double> ReferenceDataCache::find(const std::vector<Entry> &entries, const QString &shapeKey, double sizeMM)
+{
+    // First entry not below (shapeKey, numeric, sizeMM - epsilon)
+    Entry probe;
+    probe.shapeKey = shapeKey;
+    probe.numeric = true;
+    probe.sizeMM = sizeMM - SizeEpsilon;
+    const auto it = std::lower_bound(entries.begin(), entries.end(), probe, &ReferenceDataCache::lessThan);
+    if (it != entries.end() && it->shapeKey == shapeKey && it->numeric && std::abs(it->sizeMM - sizeMM) <= SizeEpsilon)
+        return it->weight;
+    return std::nullopt;
+}
+
+std::optional<double> ReferenceDataCache::find(const std::vector<Entry> &entries, const QString &shapeKey, const QString &sizeText)
+{
+    Entry probe;
+    probe.shapeKey = shapeKey;
+    probe.sizeText = sizeText.trimmed();
+    probe.sizeMM = probe.sizeText.toDouble(&probe.numeric);
+    if (probe.numeric)
+        return find(entries, shapeKey, probe.sizeMM);
+
+    const auto it = std::lower_bound(entries.begin(), entries.end(), probe, &ReferenceDataCache::lessThan);
+    if (it != entries.end() && it->shapeKey == shapeKey && !it->numeric && it->sizeText == probe.sizeText)
+        return it->weight;
+    return std::nullopt;
+}
+
+QStringList ReferenceDataCache::shapes(const std::vector<Entry> &entries)
+{
+    // Entries are grouped by shapeKey, so distinct shapes are the group heads
+    QStringList result;
+    const QString *lastKey = nullptr;
+    for (const Entry &e : entries) {
+        if (!lastKey || *lastKey != e.shapeKey)
+            result << e.shape;
+        lastKey = &e.shapeKey;
+    }
+    return result;
+}
+
+QStringList ReferenceDataCache::sizes(const std::vector<Entry> &entries, const QString &shapeKey)
+{
+    auto first = std::lower_bound(entries.begin(), entries.end(), shapeKey,
+                                  [](const Entry &e, const QString &key) { return e.shapeKey < key; });
+
+    QStringList result;
+    for (auto it = first; it != entries.end() && it->shapeKey == shapeKey; ++it) {
+        if (result.isEmpty() || result.last() != it->sizeText)
+            result << it->sizeText;
+    }
+    return result;
+}
@@ -0,0 +1,93 @@
+#ifndef REFERENCEDATACACHE_H
+#define REFERENCEDATACACHE_H
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "commontypes.h"
+
+// In-memory copy of the small, read-mostly price tables in the image database
+// (Round_diamond, Fancy_diamond, stones, Gold_Price).
+// Loaded on first use into sorted flat arrays keyed by (shape, sizeMM) so weight lookups are
+// a binary search instead of a query. Shape matching is case-insensitive. Fancy and stone
+// sizes are free text ("4x6"): they match on the text, or by value when both sides are
+// numbers, as the column comparison in SQL did. Every write to
+// these tables must call invalidate(); the next lookup reloads. A load that fails part way
+// serves only the call that made it, and the next lookup tries again.
+class ReferenceDataCache
+{
+public:
+    static ReferenceDataCache &instance();
+
+    // Per-piece weight for an exact size
+    std::optional<double> roundWeight(double sizeMM);
+    std::optional<double> fancyWeight(const QString &shape, const QString &sizeMM);
+    std::optional<double> stoneWeight(const QString &shape, const QString &sizeMM);
+
+    // Per-piece weight of the closest listed round size
+    std::optional<double> nearestRoundWeight(double sizeMM);
+
+    // Per-piece weights aligned to keys (0 where the table has no row), all resolved
+    // against one snapshot
+    QList<double> weights(const QList<WeightKey> &keys);
+    // Whether the reference table lists each key, whatever its weight
+    QList<bool> contains(const QList<WeightKey> &keys);
+
+    // Kt -> price, as stored in Gold_Price
+    QMap<QString, QString> goldPrices();
+
+    // Distinct shapes in sorted order; diamondShapes() includes "Round"
+    QStringList diamondShapes();
+    QStringList stoneShapes();
+
+    // Sizes as stored: numbers ascending, then text sizes in text order
+    QStringList roundSizes();
+    QStringList fancySizes(const QString &shape);
+    QStringList stoneSizes(const QString &shape);
+
+    void invalidate();
+
+private:
+    ReferenceDataCache() = default;
+    Q_DISABLE_COPY(ReferenceDataCache)
+
+    struct Entry {
+        QString shapeKey;   // case-folded, empty for round diamonds
+        QString shape;      // as stored
+        bool numeric = false;
+        double sizeMM = 0.0;  // when numeric
+        QString sizeText;   // as stored, trimmed
+        double weight = 0.0;
+    };
+
+    struct Snapshot {
+        // Each sorted by shapeKey, then numeric sizes by value, then text sizes by text
+        std::vector<Entry> round;
+        std::vector<Entry> fancy;
+        std::vector<Entry> stones;
+        QMap<QString, QString> goldPrices;
+    };
+
+    std::shared_ptr<const Snapshot> snapshot();
+    // ok is false when the database or any table could not be read; data is then partial
+    static std::shared_ptr<Snapshot> load(bool *ok);
+    static std::optional<double> lookup(const Snapshot &data, const WeightKey &key);
+    static bool lessThan(const Entry &a, const Entry &b);
+    static std::optional<double> find(const std::vector<Entry> &entries, const QString &shapeKey, double sizeMM);
+    static std::optional<double> find(const std::vector<Entry> &entries, const QString &shapeKey, const QString &sizeText);
+    static QStringList shapes(const std::vector<Entry> &entries);
+    static QStringList sizes(const std::vector<Entry> &entries, const QString &shape);
+
+    QMutex mutex;
+    std::shared_ptr<const Snapshot> current;
+    quint64 generation = 0;   // bumped by invalidate() so an in-flight load is not installed
+};
+
+#endif // REFERENCEDATACACHE_H
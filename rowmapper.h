@@ -0,0 +1,88 @@
+#ifndef ROWMAPPER_H
+#define ROWMAPPER_H
+
+#include <QDebug>
+#include <QList>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QString>
+#include <QVariant>
+
+#include <tuple>
+
+#include "dbexecutor.h"
+
+// Compile-time binding of result columns to struct members.
+// Specialize RowMapping<Row> with the member pointers in SELECT column order:
+//
+//   template <> struct RowMapping<PdfRecord> {
+//       static constexpr auto columns = std::make_tuple(&PdfRecord::pdf_path, &PdfRecord::time);
+//   };
+//
+// and read a whole result set with RowMapper::readAll<PdfRecord>(query).
+template <typename Row>
+struct RowMapping;
+
+namespace RowMapper {
+
+inline void assign(QString &out, const QVariant &value) { out = value.toString(); } // shares, no deep copy
+inline void assign(int &out, const QVariant &value) { out = value.toInt(); }
+inline void assign(double &out, const QVariant &value) { out = value.toDouble(); }
+inline void assign(bool &out, const QVariant &value) { out = value.toBool(); }
+
+template <typename Row>
+constexpr int columnCount()
+{
+    return int(std::tuple_size_v<std::decay_t<decltype(RowMapping<Row>::columns)>>);
+}
+
+// Fills row from the query's current record
+template <typename Row>
+void readRow(const QSqlQuery &query, Row &row)
+{
+    std::apply([&](auto... members) {
+        int column = 0;
+        (assign(row.*members, query.value(column++)), ...);
+    }, RowMapping<Row>::columns);
+}
+
+// Reads every remaining row of an executed query. reserveHint (e.g. from countRows())
+// sizes the result up front since QSQLITE cannot report the row count.
+template <typename Row>
+QList<Row> readAll(QSqlQuery &query, qsizetype reserveHint = 0)
+{
+    QList<Row> rows;
+    if (query.record().count() != columnCount<Row>()) {
+        qWarning() << "[ERROR] RowMapper column count mismatch:" << query.record().count()
+                   << "!=" << columnCount<Row>() << "| SQL:" << query.lastQuery();
+        return rows;
+    }
+
+    if (reserveHint > 0)
+        rows.reserve(reserveHint);
+
+    while (query.next()) {
+        if (DbExecutor::isCancelled())
+            return {};
+
+        Row row{};
+        readRow(query, row);
+        rows.append(std::move(row));
+    }
+
+    return rows;
+}
+
+// Row count of a table, for reserveHint
+inline qsizetype countRows(const QSqlDatabase &db, const QString &table)
+{
+    QSqlQuery query(db);
+    if (query.exec(QStringLiteral("SELECT COUNT(*) FROM \"%1\"").arg(table)) && query.next())
+        return query.value(0).toLongLong();
+    return 0;
+}
+
+} // namespace RowMapper
+
+#endif // ROWMAPPER_H
@@ -0,0 +1,196 @@
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "connectionpool.h"
+#include "schemamigrations.h"
+
+namespace {
+// Keyed by "<set>/<version>"; only written during startup, before any migrate() call
+QHash<QString, SchemaMigrations::DataStep> &dataSteps()
+{
+    static QHash<QString, SchemaMigrations::DataStep> steps;
+    return steps;
+}
+
+QString dataStepKey(const QString &scriptSet, int version)
+{
+    return scriptSet + '/' + QString::number(version);
+}
+}
+
+void SchemaMigrations::registerDataStep(const QString &scriptSet, int version, DataStep step)
+{
+    dataSteps().insert(dataStepKey(scriptSet, version), step);
+}
+
+bool SchemaMigrations::migrate(const QString &relativePath, const QString &scriptSet)
+{
+    QSqlDatabase db = ConnectionPool::instance().acquire(relativePath);
+    if (!db.isOpen()) {
+        qWarning() << "[ERROR] Cannot migrate" << relativePath << ":" << db.lastError().text();
+        return false;
+    }
+
+    if (!ensureVersionTable(db))
+        return false;
+
+    const int current = currentVersion(db);
+    const QString dirPath = QStringLiteral(":/migrations/%1").arg(scriptSet);
+    const QStringList scripts = QDir(dirPath).entryList({"*.sql"}, QDir::Files, QDir::Name);
+
+    // File names are NNNN_description.sql; the number is the schema version the script produces
+    static const QRegularExpression namePattern("^(\\d+)_(.+)\\.sql$");
+
+    for (const QString &fileName : scripts) {
+        const QRegularExpressionMatch match = namePattern.match(fileName);
+        if (!match.hasMatch()) {
+            qWarning() << "[WARNING] Ignoring migration with unexpected name:" << dirPath + "/" + fileName;
+            continue;
+        }
+
+        const int version = match.captured(1).toInt();
+        if (version <= current)
+            continue;
+
+        QFile file(dirPath + "/" + fileName);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qWarning() << "[ERROR] Cannot read migration" << file.fileName();
+            return false;
+        }
+
+        if (!apply(db, scriptSet, version, match.captured(2), QString::fromUtf8(file.readAll())))
+            return false; // later scripts may depend on this one
+
+        qDebug() << "Applied migration" << fileName << "to" << relativePath;
+    }
+
+    return true;
+}
+
+int SchemaMigrations::currentVersion(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (query.exec("SELECT COALESCE(MAX(version), 0) FROM schema_version") && query.next())
+        return query.value(0).toInt();
+    return 0;
+}
+
+QStringList SchemaMigrations::explainQueryPlan(QSqlDatabase &db, const QString &sql)
+{
+    QStringList plan;
+
+    QSqlQuery query(db);
+    if (!query.exec("EXPLAIN QUERY PLAN " + sql)) {
+        qWarning() << "[ERROR] EXPLAIN QUERY PLAN failed:" << query.lastError().text();
+        return plan;
+    }
+
+    // Columns are id, parent, notused, detail
+    while (query.next())
+        plan << query.value(3).toString();
+
+    return plan;
+}
+
+bool SchemaMigrations::ensureVersionTable(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (!query.exec(R"(
+        CREATE TABLE IF NOT EXISTS schema_version (
+            version    INTEGER PRIMARY KEY,
+            name       TEXT NOT NULL,
+            applied_at TEXT NOT NULL
+        )
+    )")) {
+        qWarning() << "[ERROR] Failed to create schema_version:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool SchemaMigrations::apply(QSqlDatabase &db, const QString &scriptSet, int version, const QString &name,
+                             const QString &script)
+{
+    if (!db.transaction()) {
+        qWarning() << "[ERROR] Failed to start migration transaction:" << db.lastError().text();
+        return false;
+    }
+
+    bool ok = true;
+    {
+        QSqlQuery query(db);
+        for (const QString &statement : splitStatements(script)) {
+            if (!query.exec(statement)) {
+                qWarning() << "[ERROR] Migration" << version << name << "failed:" << query.lastError().text()
+                           << "| SQL:" << statement;
+                ok = false;
+                break;
+            }
+        }
+
+        if (ok) {
+            if (const DataStep step = dataSteps().value(dataStepKey(scriptSet, version))) {
+                ok = step(db);
+                if (!ok)
+                    qWarning() << "[ERROR] Data step of migration" << version << name << "failed";
+            }
+        }
+
+        if (ok) {
+            query.prepare("INSERT INTO schema_version (version, name, applied_at) VALUES (?, ?, ?)");
+            query.bindValue(0, version);
+            query.bindValue(1, name);
+            query.bindValue(2, QDateTime::currentDateTime().toString(Qt::ISODate));
+            if (!query.exec()) {
+                qWarning() << "[ERROR] Failed to record migration" << version << ":" << query.lastError().text();
+                ok = false;
+            }
+        }
+    } // statement finished before commit
+
+    if (ok && db.commit())
+        return true;
+
+    db.rollback();
+    return false;
+}
+
+QStringList SchemaMigrations::splitStatements(const QString &script)
+{
+    // QSQLITE executes only the first statement of a string, so scripts are split on the
+    // terminating ';'. Trigger bodies contain their own ';' and only end at "END;".
+    QStringList statements;
+    QString current;
+    bool inTrigger = false;
+
+    const QStringList lines = script.split('\n');
+    for (const QString &rawLine : lines) {
+        const QString line = rawLine.trimmed();
+        if (line.isEmpty() || line.startsWith("--"))
+            continue;
+
+        if (current.isEmpty())
+            inTrigger = line.startsWith("CREATE TRIGGER", Qt::CaseInsensitive);
+
+        current += rawLine + '\n';
+
+        const bool ends = inTrigger ? line.compare("END;", Qt::CaseInsensitive) == 0
+                                    : line.endsWith(';');
+        if (ends) {
+            statements << current.trimmed();
+            current.clear();
+        }
+    }
+
+    if (!current.trimmed().isEmpty())
+        statements << current.trimmed();
+
+    return statements;
+}
@@ -0,0 +1,38 @@
+#ifndef SCHEMAMIGRATIONS_H
+#define SCHEMAMIGRATIONS_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Versioned schema changes for the application's SQLite files.
+// Scripts live in the resource tree as :/migrations/<set>/NNNN_description.sql and are
+// applied in number order; each one runs in its own transaction together with the
+// schema_version row that records it, so a failed script is retried on the next start.
+class SchemaMigrations
+{
+public:
+    // C++ part of a migration, for data changes plain SQL cannot express (e.g. columns that
+    // may not exist in every file). Runs inside the script's transaction, after its SQL.
+    using DataStep = bool (*)(QSqlDatabase &db);
+
+    // Call before migrate(); version is the NNNN of the script the step belongs to
+    static void registerDataStep(const QString &scriptSet, int version, DataStep step);
+
+    // Applies every script in the set newer than the file's recorded version
+    static bool migrate(const QString &relativePath, const QString &scriptSet);
+
+    // Highest applied migration number, 0 for a database that was never migrated
+    static int currentVersion(QSqlDatabase &db);
+
+    // EXPLAIN QUERY PLAN output for sql, one line per plan step
+    static QStringList explainQueryPlan(QSqlDatabase &db, const QString &sql);
+
+private:
+    static bool ensureVersionTable(QSqlDatabase &db);
+    static bool apply(QSqlDatabase &db, const QString &scriptSet, int version, const QString &name,
+                      const QString &script);
+    static QStringList splitStatements(const QString &script);
+};
+
+#endif // SCHEMAMIGRATIONS_H
@@ -0,0 +1,222 @@
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include "thumbnailcache.h"
+
+ThumbnailCache::ThumbnailCache()
+{
+    setMemoryLimit(64LL * 1024 * 1024);
+}
+
+ThumbnailCache &ThumbnailCache::instance()
+{
+    static ThumbnailCache cache;
+    return cache;
+}
+
+QString ThumbnailCache::diskDirectory()
+{
+    static const QString dir = []() {
+        const QString path = QDir(QCoreApplication::applicationDirPath()).filePath("cache/thumbnails");
+        if (!QDir().mkpath(path))
+            qWarning() << "[WARNING] Cannot create thumbnail directory" << path << "- using memory only";
+        return path;
+    }();
+    return dir;
+}
+
+QString ThumbnailCache::cacheKey(const QString &absolutePath, const QDateTime &modified, qint64 fileSize, int edge)
+{
+    return QStringLiteral("%1|%2|%3|%4")
+        .arg(absolutePath)
+        .arg(modified.toMSecsSinceEpoch())
+        .arg(fileSize)
+        .arg(edge);
+}
+
+QImage ThumbnailCache::decode(const QString &absolutePath, int edge)
+{
+    QImageReader reader(absolutePath);
+    reader.setAutoTransform(true);
+
+    // JPEG decodes straight to (about) the target size instead of the full resolution
+    const QSize original = reader.size();
+    if (original.isValid() && (original.width() > edge || original.height() > edge))
+        reader.setScaledSize(original.scaled(edge, edge, Qt::KeepAspectRatio));
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "[WARNING] Failed to decode image" << absolutePath << ":" << reader.errorString();
+        return {};
+    }
+
+    // Formats without scaled decoding come back at full size
+    if (image.width() > edge || image.height() > edge)
+        image = image.scaled(edge, edge, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    return image;
+}
+
+QImage ThumbnailCache::image(const QString &path, int edge)
+{
+    const QFileInfo info(path);
+    if (path.isEmpty() || !info.isFile())
+        return {};
+
+    const QString absolutePath = info.absoluteFilePath();
+    const QString key = cacheKey(absolutePath, info.lastModified(), info.size(), edge);
+
+    {
+        QMutexLocker locker(&mutex);
+        if (const QImage *cached = memory.object(key)) {
+            ++counters.memoryHits;
+            return *cached;
+        }
+    }
+
+    // Photos are stored as JPEG; images with transparency (cut-out renders) as PNG
+    const QDir dir(diskDirectory());
+    const QString baseName = QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+    for (const char *suffix : {".jpg", ".png"}) {
+        const QString diskPath = dir.filePath(baseName + suffix);
+        if (!QFile::exists(diskPath))
+            continue;
+
+        QImage stored(diskPath);
+        if (!stored.isNull()) {
+            {
+                QMutexLocker locker(&mutex);
+                ++counters.diskHits;
+            }
+            // Marks the file as used for pruneDisk(); at most one write per file and day
+            const QDateTime now = QDateTime::currentDateTime();
+            if (QFileInfo(diskPath).lastModified().addDays(1) < now) {
+                QFile touched(diskPath);
+                if (touched.open(QIODevice::ReadWrite))
+                    touched.setFileTime(now, QFileDevice::FileModificationTime);
+            }
+            remember(key, stored);
+            return stored;
+        }
+    }
+
+    QImage derivative = decode(absolutePath, edge);
+    if (derivative.isNull())
+        return {};
+
+    {
+        QMutexLocker locker(&mutex);
+        ++counters.decodes;
+    }
+
+    const bool hasAlpha = derivative.hasAlphaChannel();
+    QSaveFile file(dir.filePath(baseName + (hasAlpha ? ".png" : ".jpg")));
+    if (!file.open(QIODevice::WriteOnly)
+        || !derivative.save(&file, hasAlpha ? "PNG" : "JPG", hasAlpha ? -1 : 90)
+        || !file.commit()) {
+        qWarning() << "[WARNING] Failed to write thumbnail for" << absolutePath << ":" << file.errorString();
+    }
+
+    remember(key, derivative);
+    return derivative;
+}
+
+void ThumbnailCache::pruneDisk(qint64 maxBytes, int maxAgeDays)
+{
+    // Oldest first, so trimming to the size cap drops the least recently used derivatives
+    const QFileInfoList files = QDir(diskDirectory()).entryInfoList({"*.jpg", "*.png"}, QDir::Files,
+                                                                    QDir::Time | QDir::Reversed);
+    qint64 total = 0;
+    for (const QFileInfo &file : files)
+        total += file.size();
+
+    const QDateTime cutoff = QDateTime::currentDateTime().addDays(-qMax(0, maxAgeDays));
+    int removed = 0;
+    qint64 freedBytes = 0;
+    for (const QFileInfo &file : files) {
+        if (file.lastModified() >= cutoff && total <= maxBytes)
+            break;
+        if (QFile::remove(file.absoluteFilePath())) {
+            total -= file.size();
+            freedBytes += file.size();
+            ++removed;
+        }
+    }
+
+    if (removed > 0)
+        qDebug() << "Thumbnail cache pruned" << removed << "files," << freedBytes << "bytes;" << total << "bytes kept";
+}
+
+QImage ThumbnailCache::image(const QString &path, const QSize &box)
+{
+    if (box.isEmpty())
+        return {};
+
+    const int longest = qMax(box.width(), box.height());
+    const int edge = ((longest + ViewStep - 1) / ViewStep) * ViewStep;
+
+    const QImage derivative = image(path, edge);
+    if (derivative.isNull())
+        return {};
+
+    // Same fit as QPixmap::scaled(box, Qt::KeepAspectRatio), small originals included
+    const QSize fitted = derivative.size().scaled(box, Qt::KeepAspectRatio);
+    if (fitted == derivative.size())
+        return derivative;
+    return derivative.scaled(fitted, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+QPixmap ThumbnailCache::pixmap(const QString &path, int edge)
+{
+    return QPixmap::fromImage(image(path, edge));
+}
+
+QPixmap ThumbnailCache::pixmap(const QString &path, const QSize &box)
+{
+    return QPixmap::fromImage(image(path, box));
+}
+
+void ThumbnailCache::remember(const QString &key, const QImage &image)
+{
+    QMutexLocker locker(&mutex);
+    memory.insert(key, new QImage(image), int(image.sizeInBytes() / 1024) + 1);
+}
+
+void ThumbnailCache::setMemoryLimit(qint64 bytes)
+{
+    QMutexLocker locker(&mutex);
+    memory.setMaxCost(int(qMax<qint64>(bytes / 1024, 1)));
+}
+
+void ThumbnailCache::invalidate(const QString &path)
+{
+    const QString prefix = QFileInfo(path).absoluteFilePath() + '|';
+
+    QMutexLocker locker(&mutex);
+    const QList<QString> keys = memory.keys();
+    for (const QString &key : keys) {
+        if (key.startsWith(prefix))
+            memory.remove(key);
+    }
+}
+
+void ThumbnailCache::clearMemory()
+{
+    QMutexLocker locker(&mutex);
+    memory.clear();
+}
+
+ThumbnailCache::Stats ThumbnailCache::stats() const
+{
+    QMutexLocker locker(&mutex);
+    Stats result = counters;
+    result.memoryBytes = qint64(memory.totalCost()) * 1024;
+    return result;
+}
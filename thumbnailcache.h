@@ -0,0 +1,85 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QCache>
+#include <QDateTime>
+#include <QImage>
+#include <QMutex>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+// Downscaled copies of catalog images for grids, carts and viewers.
+// Each image is decoded once per size with QImageReader's scaled decode, written under
+// cache/thumbnails keyed by (path, mtime, file size, edge) and kept in a byte-bounded LRU,
+// so later requests neither touch the original file nor rescale it. Replacing the original
+// changes its mtime/size and therefore its key, so stale entries are never served; they
+// stay on disk until pruneDisk() ages them out or trims the folder to its size cap.
+class ThumbnailCache
+{
+public:
+    // Fixed derivative sizes: longest edge in pixels
+    enum Edge {
+        Small  = 80,   // list icons, cart rows
+        Medium = 160,  // catalog grid
+        Large  = 512,  // preview panes
+    };
+
+    struct Stats {
+        quint64 memoryHits = 0;
+        quint64 diskHits = 0;
+        quint64 decodes = 0;     // derivatives built from the original
+        qint64 memoryBytes = 0;
+    };
+
+    // Disk cache bounds applied by pruneDisk()
+    static constexpr qint64 DefaultDiskLimit = 512LL * 1024 * 1024;
+    static constexpr int DefaultDiskAgeDays = 30;
+
+    static ThumbnailCache &instance();
+
+    // path scaled to fit edge x edge (never upscaled). Null if the file cannot be read.
+    // Safe to call from any thread.
+    QImage image(const QString &path, int edge);
+
+    // path scaled to fit box, for views sized by the layout. Built from a derivative whose edge
+    // is box's longest side rounded up to a 256 px step, so resizing a window does not create
+    // a new file per pixel.
+    QImage image(const QString &path, const QSize &box);
+
+    // GUI-thread conveniences over image()
+    QPixmap pixmap(const QString &path, int edge);
+    QPixmap pixmap(const QString &path, const QSize &box);
+
+    // Upper bound of the in-memory LRU; defaults to 64 MiB
+    void setMemoryLimit(qint64 bytes);
+
+    // Drops path's in-memory entries; its disk entries are left to pruneDisk()
+    void invalidate(const QString &path);
+    void clearMemory();
+
+    // Deletes derivatives not used for maxAgeDays, then the least recently used ones until
+    // the folder holds at most maxBytes. Disk hits refresh a file's mtime, so it orders use.
+    // Any thread; run once at startup.
+    static void pruneDisk(qint64 maxBytes = DefaultDiskLimit, int maxAgeDays = DefaultDiskAgeDays);
+
+    Stats stats() const;
+
+private:
+    ThumbnailCache();
+    Q_DISABLE_COPY(ThumbnailCache)
+
+    static constexpr int ViewStep = 256;
+
+    static QString diskDirectory();
+    static QString cacheKey(const QString &absolutePath, const QDateTime &modified, qint64 fileSize, int edge);
+    static QImage decode(const QString &absolutePath, int edge);
+
+    void remember(const QString &key, const QImage &image);
+
+    mutable QMutex mutex;
+    QCache<QString, QImage> memory;   // cost in KiB
+    Stats counters;
+};
+
+#endif // THUMBNAILCACHE_H
@@ -7,11 +7,14 @@
 #include <QRegularExpression>
 #include <QDir>
 #include <QCompleter>
+#include <QProgressDialog>
 
 #include "databaseutils.h"
-#include "PdfUtils.h"
+#include "pdfrenderer.h"
 #include "utils.h"
 #include "cartitemwidget.h"
+#include "imageprefetcher.h"
+#include "catalogsearch.h"
 
 
 
@@ -48,12 +51,18 @@ User::User(QWidget *parent)
     , ui(new Ui::User)
     //, dbManager()
     , currentImageIndex(0)
+    , searchDebounce(nullptr)
     , diamondTable(nullptr)
     , stoneTable(nullptr)
     , cartItemsContainer(nullptr)
     , currentUserId("")
 {
     ui->setupUi(this);
+
+    imagePrefetcher = new ImagePrefetcher(this);
+    connect(imagePrefetcher, &ImagePrefetcher::imageReady, this, &User::onImagePrefetched);
+    connect(imagePrefetcher, &ImagePrefetcher::imageFailed, this, &User::onImagePrefetchFailed);
+
     setupUi();
 
     // For backgrund recaclulation so that resizeEvent function's effect can be seen otherwise you have to resize window to see the background effect performed in resiveEvent function.
@@ -117,10 +126,119 @@ void User::setupUi()
 
     ui->userid->setEnabled(false) ;
 
+    setupSearchBar();
     loadData();
 
 }
 
+void User::setupSearchBar()
+{
+    ui->searchbarMainpage->setPlaceholderText("Search design no, company, type or note…");
+    ui->searchbarMainpage->setClearButtonEnabled(true);
+    ui->searchbarMainpage->addAction(QIcon(":/icon/search-1.png"), QLineEdit::LeadingPosition);
+
+    QAction *filterAction = ui->searchbarMainpage->addAction(QIcon(":/icon/expand-arrow.png"), QLineEdit::TrailingPosition);
+    filterAction->setToolTip("Filter by gold, diamond or stone");
+    connect(filterAction, &QAction::triggered, this, &User::showFacetMenu);
+
+    // One query per pause in typing rather than per keystroke
+    searchDebounce = new QTimer(this);
+    searchDebounce->setSingleShot(true);
+    searchDebounce->setInterval(SearchDebounceMs);
+    connect(searchDebounce, &QTimer::timeout, this, &User::runSearch);
+    connect(ui->searchbarMainpage, &QLineEdit::textChanged, this, [this](const QString &text) {
+        searchQuery.text = text.trimmed();
+        searchDebounce->start();
+    });
+    connect(ui->searchbarMainpage, &QLineEdit::returnPressed, this, [this]() {
+        searchDebounce->stop();
+        runSearch();
+    });
+}
+
+void User::runSearch()
+{
+    const bool filtered = !searchQuery.goldKarat.isEmpty() || !searchQuery.diamondShape.isEmpty()
+                          || !searchQuery.stoneType.isEmpty();
+    if (searchQuery.text.isEmpty() && !filtered) {
+        searchFacets = {};
+        loadData();
+        return;
+    }
+
+    // Replaces any page or search still in flight
+    itemsRequest.cancel();
+    pageLoading = false;
+    const CatalogSearchQuery query = searchQuery;
+    itemsRequest = DbExecutor::instance().submit(this, [query]() {
+        return CatalogSearch::run(query);
+    }, [this](const CatalogSearchResult &result) {
+        onSearchFinished(result);
+    });
+}
+
+void User::onSearchFinished(const CatalogSearchResult &result)
+{
+    // Search results are a single ranked list, so browsing does not page past them
+    catalogHeaders = result.rows;
+    nextCatalogAfterId = -1;
+    searchFacets = result.facets;
+    currentImageIndex = 0;
+
+    QStringList imagePaths;
+    imagePaths.reserve(catalogHeaders.size());
+    for (const CatalogHeader &header : std::as_const(catalogHeaders))
+        imagePaths.append(header.imagePath);
+    imagePrefetcher->setPaths(imagePaths);
+
+    if (catalogHeaders.isEmpty()) {
+        ui->companyName->clear();
+        ui->designNo->setText("No matching designs");
+        ui->label_slneNo->clear();
+        ui->image_viewUser->clear();
+        return;
+    }
+    loadImage(0);
+}
+
+void User::showFacetMenu()
+{
+    QMenu menu(this);
+
+    // Checkable entry per facet value; picking the checked one again clears that filter
+    auto addFacet = [this, &menu](const QString &title, const QList<CatalogFacetCount> &counts, QString CatalogSearchQuery::*field) {
+        QMenu *sub = menu.addMenu(title);
+        sub->setEnabled(!counts.isEmpty() || !(searchQuery.*field).isEmpty());
+        for (const CatalogFacetCount &facet : counts) {
+            QAction *action = sub->addAction(QString("%1 (%2)").arg(facet.value).arg(facet.count));
+            action->setCheckable(true);
+            action->setChecked(searchQuery.*field == facet.value);
+            const QString value = facet.value;
+            connect(action, &QAction::triggered, this, [this, field, value](bool checked) {
+                searchQuery.*field = checked ? value : QString();
+                if (field == &CatalogSearchQuery::diamondShape)
+                    searchQuery.diamondSize.clear();
+                runSearch();
+            });
+        }
+    };
+
+    addFacet("Gold", searchFacets.goldKarats, &CatalogSearchQuery::goldKarat);
+    addFacet("Diamond", searchFacets.diamondShapes, &CatalogSearchQuery::diamondShape);
+    addFacet("Stone", searchFacets.stoneTypes, &CatalogSearchQuery::stoneType);
+
+    menu.addSeparator();
+    menu.addAction("Clear filters", this, [this]() {
+        searchQuery.goldKarat.clear();
+        searchQuery.diamondShape.clear();
+        searchQuery.diamondSize.clear();
+        searchQuery.stoneType.clear();
+        runSearch();
+    });
+
+    menu.exec(ui->searchbarMainpage->mapToGlobal(ui->searchbarMainpage->rect().bottomRight()));
+}
+
 void User::setupMobileComboBox() {
     QFile file(":/json_files/country_codes.json");
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -219,10 +337,51 @@ void User::selectMobileCodeFromText(const QString &text)
 
 void User::loadData()
 {
-    imageRecords = DatabaseUtils::getAllItems();
+    // A newer load supersedes one still in flight
+    itemsRequest.cancel();
+    pageLoading = false;
+    catalogHeaders.clear();
+    nextCatalogAfterId = 0;
     currentImageIndex = 0;
+    imagePrefetcher->setPaths({});
+
+    loadNextCatalogPage();
+}
+
+void User::loadNextCatalogPage()
+{
+    if (pageLoading || nextCatalogAfterId < 0)
+        return;
+
+    // Pages are read on a database worker, the first one at startup and the rest as
+    // browsing approaches the end of what is loaded
+    pageLoading = true;
+    const int afterId = nextCatalogAfterId;
+    itemsRequest = DbExecutor::instance().submit(this, [afterId]() {
+        return DatabaseUtils::fetchCatalogPage(afterId, CatalogPageSize);
+    }, [this](const CatalogPage &page) {
+        onCatalogPageLoaded(page);
+    });
+}
+
+void User::onCatalogPageLoaded(const CatalogPage &page)
+{
+    pageLoading = false;
+    nextCatalogAfterId = page.nextAfterId;
+
+    const bool firstPage = catalogHeaders.isEmpty();
+    catalogHeaders += page.rows;
 
-    if (!imageRecords.isEmpty()) {
+    QStringList imagePaths;
+    imagePaths.reserve(page.rows.size());
+    for (const CatalogHeader &header : page.rows)
+        imagePaths.append(header.imagePath);
+    imagePrefetcher->appendPaths(imagePaths);
+
+    if (!firstPage)
+        return;
+
+    if (!catalogHeaders.isEmpty()) {
         loadImage(currentImageIndex);
     } else {
         QMessageBox::warning(this, "No Data", "No image data found in the database.");
@@ -231,40 +390,62 @@ void User::loadData()
 
 void User::loadImage(int index)
 {
-    if (index < 0 || index >= imageRecords.size()) return;
+    if (index < 0 || index >= catalogHeaders.size()) return;
 
     currentImageIndex = index;
-    const ImageRecord &record = imageRecords[index];
+    const CatalogHeader &record = catalogHeaders[index];
+
+    if (index >= catalogHeaders.size() - CatalogPageMargin)
+        loadNextCatalogPage();
 
     ui->companyName->setText(record.companyName);
     ui->designNo->setText("<u>Design No.</u><br> " + record.designNo);
     ui->label_slneNo->setText("Slne No.\nSLNE" + QString::number(record.imageId));
 
     if (QFile::exists(record.imagePath)) {
-        QPixmap pixmap(record.imagePath);
-
-        // capture a pre-scaled copy so we don't use a dangling local
-        QPixmap scaled = pixmap.scaled(ui->image_viewUser->size(),
-                                       Qt::KeepAspectRatio,
-                                       Qt::SmoothTransformation);
-
-        QTimer::singleShot(100, this, [this, scaled]() {
-            ui->image_viewUser->setPixmap(scaled);
-        });
+        // Already decoded when it was a neighbour of the previous image; otherwise
+        // onImagePrefetched() shows it as soon as a worker has decoded it, and the previous
+        // design's picture must not stay up under this design's labels meanwhile
+        const QImage prefetched = imagePrefetcher->request(index, ui->image_viewUser->size());
+        if (!prefetched.isNull())
+            ui->image_viewUser->setPixmap(QPixmap::fromImage(prefetched));
+        else
+            ui->image_viewUser->clear();
     } else {
+        showImagePlaceholder();
         QMessageBox::warning(this, "Image Error", "Image not found: " + record.imagePath);
     }
 
 
 
-    updateGoldWeight(record.goldJson);
+    // Details only for the record on screen; a primary-key lookup
+    const std::optional<ImageRecord> details = DatabaseUtils::fetchCatalogRecord(record.imageId);
+    updateGoldWeight(details ? details->goldJson : QString());
     displayDiamondDetails();
     displayStoneDetails();
     ui->itemSelectionSpinBox->setValue(0);
 }
 
+void User::onImagePrefetched(int index, const QImage &image)
+{
+    if (index == currentImageIndex)
+        ui->image_viewUser->setPixmap(QPixmap::fromImage(image));
+}
+
+void User::onImagePrefetchFailed(int index)
+{
+    if (index == currentImageIndex)
+        showImagePlaceholder();
+}
+
+void User::showImagePlaceholder()
+{
+    ui->image_viewUser->setPixmap(QPixmap(":/icon/no_image_1.png")
+                                      .scaled(ui->image_viewUser->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+}
+
 void User::on_nextImage_clicked() {
-    if (currentImageIndex < imageRecords.size() - 1) {
+    if (currentImageIndex < catalogHeaders.size() - 1) {
         loadImage(++currentImageIndex);
     }
 }
@@ -634,12 +815,12 @@ bool User::eventFilter(QObject *obj, QEvent *event)
 
 void User::displayDiamondDetails()
 {
-    if (currentImageIndex < 0 || currentImageIndex >= imageRecords.size()) {
+    if (currentImageIndex < 0 || currentImageIndex >= catalogHeaders.size()) {
         ui->diamond_detail->setText("Diamond Wt.\nNo image selected");
         return;
     }
 
-    int imageId = imageRecords[currentImageIndex].imageId;
+    int imageId = catalogHeaders[currentImageIndex].imageId;
     auto result = DatabaseUtils::fetchDiamondDetails(imageId);
     currentDiamondJson = result.first;
 
@@ -654,12 +835,12 @@ void User::displayDiamondDetails()
 
 void User::displayStoneDetails()
 {
-    if (currentImageIndex < 0 || currentImageIndex >= imageRecords.size()) {
+    if (currentImageIndex < 0 || currentImageIndex >= catalogHeaders.size()) {
         ui->stone_detail->setText("Stone Wt.\nNo image selected");
         return;
     }
 
-    int imageId = imageRecords[currentImageIndex].imageId;
+    int imageId = catalogHeaders[currentImageIndex].imageId;
     auto result = DatabaseUtils::fetchStoneDetails(imageId);
     currentStoneJson = result.first;
 
@@ -673,12 +854,12 @@ void User::displayStoneDetails()
 
 void User::on_selectButton_clicked()
 {
-    if (currentImageIndex < 0 || currentImageIndex >= imageRecords.size()) {
+    if (currentImageIndex < 0 || currentImageIndex >= catalogHeaders.size()) {
         QMessageBox::warning(this, "Selection Error", "No image selected.");
         return;
     }
 
-    int imageId = imageRecords[currentImageIndex].imageId;
+    int imageId = catalogHeaders[currentImageIndex].imageId;
     QString goldType = currentGoldSelection;
     int itemCount = ui->itemSelectionSpinBox->value();
 
@@ -700,20 +881,36 @@ void User::on_selectButton_clicked()
     // selection.pdf_path = QDir(pdfDir).filePath(QString("pdf_%1.pdf").arg(imageId));
     selection.pdf_path = "";
 
-    // Remove duplicate entry
-    for (int i = selections.size() - 1; i >= 0; --i) {
-        if (selections[i].imageId == imageId && selections[i].goldType == goldType) {
-            selections.removeAt(i);
+    // Replace an existing entry in place, so only its widget and summary rows change
+    bool replaced = false;
+    for (SelectionData &existing : selections) {
+        if (existing.imageId == imageId && existing.goldType == goldType) {
+            existing = selection;
+            replaced = true;
+            break;
         }
     }
-
-    selections.append(selection);
+    if (!replaced)
+        selections.append(selection);
 
     if (!currentUserId.isEmpty()) {
         saveCartToDatabase();
     }
 
-    updateCartDisplay();
+    if (replaced) {
+        for (CartItemWidget *itemWidget : cartItemsContainer->findChildren<CartItemWidget*>()) {
+            if (itemWidget->getImageId() == imageId && itemWidget->getGoldType() == goldType) {
+                itemWidget->setQuantity(itemCount);
+                break;
+            }
+        }
+    } else {
+        addCartItemWidget(selection);
+    }
+
+    const auto details = CartSummary::fetchDetails({selection});
+    refreshCartSummary(cartSummary.setLine(imageId, goldType, itemCount,
+                                           details.value({imageId, goldType})));
 }
 
 void User::updateCartDisplay()
@@ -730,46 +927,57 @@ void User::updateCartDisplay()
         delete item;
     }
 
+    layout->addStretch();
+
     // Add cart items
+    for (const SelectionData &selection : selections)
+        addCartItemWidget(selection);
+
+    // Whole-cart totals from one batch of lookups; edits after this apply deltas
+    const auto details = CartSummary::fetchDetails(selections);
+    cartSummary.clear();
     for (const SelectionData &selection : selections) {
-        QPixmap image = DatabaseUtils::fetchImagePixmap(selection.imageId);
-        auto *itemWidget = new CartItemWidget(
-            selection.imageId,
-            selection.goldType,
-            selection.itemCount,
-            image,
-            cartItemsContainer
-            );
-        layout->addWidget(itemWidget);
-
-        connect(itemWidget, &CartItemWidget::quantityChanged,
-                this, &User::on_cartItemQuantityChanged);
-        connect(itemWidget, &CartItemWidget::removeRequested,
-                this, &User::on_cartItemRemoveRequested);
+        cartSummary.setLine(selection.imageId, selection.goldType, selection.itemCount,
+                            details.value({selection.imageId, selection.goldType}));
     }
-
-    layout->addStretch();
-
-    // Update summaries
-    updateGoldSummary();
-    updateDiamondSummary();
-    updateStoneSummary();
+    renderCartSummary();
 }
 
-void User::updateGoldSummary()
+void User::addCartItemWidget(const SelectionData &selection)
 {
-    double totalGoldWeight = DatabaseUtils::calculateTotalGoldWeight(selections);
-    ui->goldFinaldetail->setText(QString("Total Gold Weight: %1g").arg(totalGoldWeight, 0, 'f', 3));
+    QVBoxLayout *layout = qobject_cast<QVBoxLayout*>(cartItemsContainer->layout());
+    if (!layout) return;
+
+    QPixmap image = DatabaseUtils::fetchImagePixmap(selection.imageId);
+    auto *itemWidget = new CartItemWidget(
+        selection.imageId,
+        selection.goldType,
+        selection.itemCount,
+        image,
+        cartItemsContainer
+        );
+    // Keep the trailing stretch last
+    layout->insertWidget(qMax(0, layout->count() - 1), itemWidget);
+
+    connect(itemWidget, &CartItemWidget::quantityChanged,
+            this, &User::on_cartItemQuantityChanged);
+    connect(itemWidget, &CartItemWidget::removeRequested,
+            this, &User::on_cartItemRemoveRequested);
 }
 
-void User::updateDiamondSummary()
+void User::renderCartSummary()
 {
-    DatabaseUtils::updateSummaryTable(ui->diamondFinaldetail, selections, "diamond");
+    ui->goldFinaldetail->setText(QString("Total Gold Weight: %1g").arg(cartSummary.totalGold(), 0, 'f', 3));
+    diamondSummaryTable.render(ui->diamondFinaldetail, cartSummary.diamonds());
+    stoneSummaryTable.render(ui->stoneFinaldetail, cartSummary.stones());
 }
 
-void User::updateStoneSummary()
+void User::refreshCartSummary(const CartSummary::Changes &changes)
 {
-    DatabaseUtils::updateSummaryTable(ui->stoneFinaldetail, selections, "stone");
+    if (changes.gold)
+        ui->goldFinaldetail->setText(QString("Total Gold Weight: %1g").arg(cartSummary.totalGold(), 0, 'f', 3));
+    diamondSummaryTable.update(ui->diamondFinaldetail, cartSummary.diamonds(), changes.diamonds);
+    stoneSummaryTable.update(ui->stoneFinaldetail, cartSummary.stones(), changes.stones);
 }
 
 void User::on_cartItemQuantityChanged(int imageId, const QString &goldType, int newQuantity)
@@ -781,11 +989,9 @@ void User::on_cartItemQuantityChanged(int imageId, const QString &goldType, int
         }
     }
 
-    // Persist + refresh summaries only (no UI rebuild)
+    // Persist + apply the line's delta to the summaries (no UI rebuild)
     saveCartToDatabase();
-    updateGoldSummary();
-    updateDiamondSummary();
-    updateStoneSummary();
+    refreshCartSummary(cartSummary.setQuantity(imageId, goldType, newQuantity));
 }
 
 void User::on_cartItemRemoveRequested(int imageId, const QString &goldType)
@@ -817,10 +1023,8 @@ void User::on_cartItemRemoveRequested(int imageId, const QString &goldType)
     // Save updated cart
     saveCartToDatabase();
 
-    // Just update summaries, not whole UI
-    updateGoldSummary();
-    updateDiamondSummary();
-    updateStoneSummary();
+    // Take the line back out of the summaries, not whole UI
+    refreshCartSummary(cartSummary.remove(imageId, goldType));
 }
 
 void User::on_makePdfButton_clicked()
@@ -847,27 +1051,110 @@ void User::on_makePdfButton_clicked()
 
     qDebug() << "Generating PDF at path:" << pdfPath << "for userId:" << currentUserId;
 
-    if (PdfUtils::generateCartPdf(pdfPath, currentUserId, ui->nameuser->text().trimmed(),
-                                  ui->companyNameuser->text().trimmed(),
-                                  ui->mobileall->currentText() + ui->mobileNouser->text().trimmed(),
-                                  selections, cartItemsContainer, ui->diamondFinaldetail,
-                                  ui->stoneFinaldetail, ui->goldFinaldetail->text())) {
-        QMessageBox::information(this, "Success", "PDF generated successfully at: " + pdfPath);
+    if (!pdfRenderer) {
+        pdfRenderer = new PdfRenderer(this);
 
-        // Update pdf_path in selections with the new PDF path
-        for (SelectionData &selection : selections) {
+        connect(pdfRenderer, &PdfRenderer::progressChanged, this, [this](int done, int total) {
+            if (!pdfProgress) return;
+            pdfProgress->setMaximum(qMax(1, total));
+            pdfProgress->setValue(done);
+        });
 
-            selection.pdf_path = pdfPath;
-        }
+        connect(pdfRenderer, &PdfRenderer::finished, this, [this](const PdfRenderResult &result) {
+            if (pdfProgress) {
+                pdfProgress->disconnect(pdfRenderer);
+                pdfProgress->deleteLater();
+                pdfProgress = nullptr;
+            }
+            ui->makePdfButton->setEnabled(true);
 
-        if (!DatabaseUtils::saveUserCart(currentUserId, selections)) {
-            QMessageBox::critical(this, "Database Error", "Failed to save PDF path to cart. Check console for details.");
-        } else {
-            qDebug() << "PDF path" << pdfPath << "saved successfully for user:" << currentUserId;
-        }
-    } else {
-        QMessageBox::critical(this, "Error", "Failed to generate PDF at: " + pdfPath);
+            if (result.cancelled)
+                return;
+            if (!result.ok) {
+                QMessageBox::critical(this, "Error", "Failed to generate PDF at: " + result.pdfPath);
+                return;
+            }
+
+            QMessageBox::information(this, "Success", "PDF generated successfully at: " + result.pdfPath);
+
+            // Update pdf_path in selections with the new PDF path
+            for (SelectionData &selection : selections) {
+
+                selection.pdf_path = result.pdfPath;
+            }
+
+            if (!DatabaseUtils::saveUserCart(currentUserId, selections)) {
+                QMessageBox::critical(this, "Database Error", "Failed to save PDF path to cart. Check console for details.");
+            } else {
+                qDebug() << "PDF path" << result.pdfPath << "saved successfully for user:" << currentUserId;
+            }
+        });
     }
+
+    if (pdfRenderer->isRunning())
+        return;
+
+    pdfProgress = new QProgressDialog("Generating PDF…", "Cancel", 0, 0, this);
+    pdfProgress->setWindowTitle("Cart PDF");
+    pdfProgress->setWindowModality(Qt::WindowModal);
+    pdfProgress->setMinimumDuration(500);
+    pdfProgress->setAutoClose(false);
+    pdfProgress->setAutoReset(false);
+    connect(pdfProgress, &QProgressDialog::canceled, pdfRenderer, &PdfRenderer::cancel);
+    ui->makePdfButton->setEnabled(false);
+
+    pdfRenderer->renderCart(cartPdfData(pdfPath));
+}
+
+CartPdfData User::cartPdfData(const QString &pdfPath) const
+{
+    CartPdfData data;
+    data.pdfPath = pdfPath;
+    data.userId = currentUserId;
+    data.userName = ui->nameuser->text().trimmed();
+    data.companyName = ui->companyNameuser->text().trimmed();
+    data.mobileNo = ui->mobileall->currentText() + ui->mobileNouser->text().trimmed();
+
+    // Image paths of the whole cart in one lookup
+    QList<int> imageIds;
+    imageIds.reserve(selections.size());
+    for (const SelectionData &selection : selections)
+        imageIds.append(selection.imageId);
+
+    QHash<int, QString> imagePaths;
+    for (const CatalogHeader &header : DatabaseUtils::fetchCatalogHeaders(imageIds))
+        imagePaths.insert(header.imageId, header.imagePath);
+
+    for (const SelectionData &selection : selections) {
+        CartPdfItem item;
+        item.imageId = selection.imageId;
+        item.imagePath = imagePaths.value(selection.imageId);
+        item.goldType = selection.goldType;
+        item.itemCount = selection.itemCount;
+        item.goldWeight = cartSummary.goldWeight(selection.imageId, selection.goldType);
+        item.diamondJson = selection.diamondJson;
+        data.items.append(item);
+    }
+
+    data.goldByKarat = cartSummary.goldByKarat();
+
+    const auto pieceRows = [](const QMap<CartSummary::PieceKey, CartSummary::PieceTotal> &totals) {
+        QList<CartPdfPieceRow> rows;
+        for (auto it = totals.cbegin(); it != totals.cend(); ++it) {
+            CartPdfPieceRow row;
+            row.type = it.key().first;
+            row.sizeMM = it.key().second;
+            row.quantity = it.value().quantity;
+            row.totalWeight = it.value().weight;
+            row.weight = row.quantity > 0 ? row.totalWeight / row.quantity : 0.0;
+            rows.append(row);
+        }
+        return rows;
+    };
+    data.diamonds = pieceRows(cartSummary.diamonds());
+    data.stones = pieceRows(cartSummary.stones());
+
+    return data;
 }
 
 void User::loadUserCart(const QString &userId)
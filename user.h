@@ -5,8 +5,15 @@
 
 #include <QJsonObject>
 
+#include "cartsummary.h"
 #include "commontypes.h"
+#include "dbexecutor.h"
 
+class ImagePrefetcher;
+class PdfRenderer;
+class QProgressDialog;
+class QMenu;
+class QTimer;
 class QTableWidget;
 
 namespace Ui {
@@ -57,28 +64,56 @@ private:
     void setupUi();
     void setupMobileComboBox();
     void loadData();
+    void loadNextCatalogPage();
+    void onCatalogPageLoaded(const CatalogPage &page);
+    void onImagePrefetched(int index, const QImage &image);
+    void onImagePrefetchFailed(int index);
+    void showImagePlaceholder();
+    void setupSearchBar();
+    void runSearch();
+    void onSearchFinished(const CatalogSearchResult &result);
+    void showFacetMenu();
     void displayDiamondDetails();
     void displayStoneDetails();
     void updateCartDisplay();
-    void updateGoldSummary();
-    void updateDiamondSummary();
-    void updateStoneSummary();
+    void addCartItemWidget(const SelectionData &selection);
+    void renderCartSummary();
+    void refreshCartSummary(const CartSummary::Changes &changes);
     bool saveOrLoadUser();
     bool handleRegistration();
     bool canRegister(const QString &mobilePrefix, const QString &mobileNo);
     void loadUserCart(const QString &userId);
     void saveCartToDatabase();
+    CartPdfData cartPdfData(const QString &pdfPath) const;
     void selectMobileCodeFromText(const QString &text);
 
     Ui::User *ui;
     QJsonObject goldData;
     int currentImageIndex;
-    QList<ImageRecord> imageRecords;
+    // Catalog headers loaded so far, in image_id order; pages are appended while browsing
+    static constexpr int CatalogPageSize = 200;
+    static constexpr int CatalogPageMargin = 20;   // load the next page this close to the end
+    QList<CatalogHeader> catalogHeaders;
+    int nextCatalogAfterId = 0;
+    bool pageLoading = false;
+    DbRequest itemsRequest;
+    // Search bar state; an empty query with no facet filters means plain browsing
+    static constexpr int SearchDebounceMs = 150;
+    QTimer *searchDebounce;
+    CatalogSearchQuery searchQuery;
+    CatalogFacets searchFacets;
+    ImagePrefetcher *imagePrefetcher;
     QTableWidget *diamondTable;
     QString currentDiamondJson;
     QTableWidget *stoneTable;
     QString currentStoneJson;
     QVector<SelectionData> selections;
+    // Running totals of selections, kept in step by each cart edit
+    CartSummary cartSummary;
+    CartSummaryTable diamondSummaryTable;
+    CartSummaryTable stoneSummaryTable;
+    PdfRenderer *pdfRenderer = nullptr;
+    QProgressDialog *pdfProgress = nullptr;
     QWidget *cartItemsContainer;
     QString currentUserId;
     QString currentGoldSelection;